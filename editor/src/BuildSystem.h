@@ -1,5 +1,6 @@
 #pragma once
 #include "core/Log.h"
+#include "core/TextureAtlas.h"
 #include <cstdlib>
 #include <string>
 #include <filesystem>
@@ -79,6 +80,12 @@ public:
             {
                 fs::copy(assetSrc, exportDir / "assets", fs::copy_options::recursive);
                 Engine::Log::info("Assets packaged.");
+
+                // Kopia v exporte sa zabali do atlasu, projekt ostava nezmeneny
+                if (!Engine::TextureAtlas::PackDirectory(exportDir / "assets"))
+                {
+                    Engine::Log::warn("Texture atlas packing failed, textures are exported as separate files.");
+                }
             }
 
             fs::path sceneSrc = projectRoot / "scenes";
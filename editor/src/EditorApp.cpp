@@ -3,6 +3,7 @@
 #include "SDL_render.h"
 #include <SDL2/SDL_ttf.h>
 #include "core/Input.h"
+#include "core/JobSystem.h"
 #include "core/Log.h"
 #include "core/ProjectSerializer.h"
 #include "core/Time.h"
@@ -365,10 +366,32 @@ void EditorApp::processEvents()
 
 void EditorApp::update()
 {
-  if (currentScene && m_SceneState == SceneState::PLAY)
+  if (!currentScene)
+    return;
+
+  bool entersPlay = m_SceneState == SceneState::PLAY && !m_WasPlaying;
+  m_WasPlaying = m_SceneState == SceneState::PLAY;
+
+  if (m_SceneState == SceneState::PLAY)
   {
+    // Zvysok akumulatora z minuleho behu by prvy frame pridal kroky navyse
+    if (entersPlay)
+      m_FixedStep.reset();
+
+    int steps = m_FixedStep.advance(Engine::Time::getDeltaTime());
+    for (int i = 0; i < steps; ++i)
+    {
+      currentScene->fixedUpdate(m_FixedStep.getStep());
+    }
+    currentScene->setInterpolationAlpha(m_FixedStep.getAlpha());
+
     currentScene->update(Engine::Time::getDeltaTime());
   }
+  else
+  {
+    // v edit mode kreslime presne to, co je v transformoch
+    currentScene->setInterpolationAlpha(1.0f);
+  }
 }
 
 void EditorApp::render()
@@ -441,6 +464,7 @@ void EditorApp::shutdown()
 {
   if (currentScene)
     currentScene->shutdown();
+  Engine::JobSystem::shutdown();
   ImGui_ImplSDLRenderer2_Shutdown();
   ImGui_ImplSDL2_Shutdown();
   ImGui::DestroyContext();
@@ -3,7 +3,9 @@
 #include "imgui.h"
 #include <ImGuizmo.h>
 #include "core/AssetManager.h"
+#include "core/FixedTimestep.h"
 #include "core/Project.h"
+#include "core/SceneBackground.h"
 #include "ecs/Entity.h"
 #include "imgui.h"
 #include <SDL2/SDL.h>
@@ -72,6 +74,8 @@ private:
    * This allows us to display the game inside an ImGui window.
    */
   SDL_Texture *m_GameRenderTarget;
+  // Pozadie sceny v m_GameRenderTarget, vrcholy sa drzia kym sa nezmeni nastavenie alebo velkost
+  Engine::SceneBackground m_SceneBackground;
 
   // --- Engine Systems ---
   std::unique_ptr<Engine::Scene> currentScene;
@@ -85,6 +89,8 @@ private:
   ImVec2 viewportPos;
 
   SceneState m_SceneState = SceneState::EDIT;
+  Engine::FixedTimestep m_FixedStep;
+  bool m_WasPlaying = false; // stav z predchadzajuceho update(), na zachytenie prechodu EDIT -> PLAY
   AppState m_AppState = AppState::BROWSER;
 
   SDL_Texture *m_SelectedTexture = nullptr;
@@ -95,6 +101,8 @@ private:
   std::unordered_map<std::string, SDL_Color> m_AssetTint;
   Engine::Entity* m_EntityToDelete = nullptr;
   bool g_EditColliderMode = false;
+  bool g_PaintTilemapMode = false;
+  int g_TilemapBrushTile = 1; // 0 = eraser
   Engine::Project* m_currentProject = nullptr;
   ImGuizmo::OPERATION op;
   bool m_RequestCloseProject = false;
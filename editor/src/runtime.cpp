@@ -1,7 +1,11 @@
 #define SDL_MAIN_HANDLED
 #include "SDL.h"
 #include "core/AssetManager.h"
+#include "core/ChecksumLog.h"
+#include "core/FixedTimestep.h"
+#include "core/FramePipeline.h"
 #include "core/Input.h"
+#include "core/JobSystem.h"
 #include "core/Log.h"
 #include "core/Project.h"
 #include "core/ProjectSerializer.h"
@@ -17,7 +21,9 @@ namespace fs = std::filesystem;
 
 class GameApp {
 public:
-  GameApp(const std::string &cmdLinePath) : m_isRunning(true) {
+  GameApp(const std::string &cmdLinePath, const std::string &recordChecksums = "",
+          const std::string &verifyChecksums = "", bool singleThread = false)
+      : m_isRunning(true) {
     if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_TIMER | SDL_INIT_AUDIO |
                  SDL_INIT_GAMECONTROLLER) != 0) {
       showFatalError("SDL Init Failed", SDL_GetError());
@@ -43,6 +49,17 @@ public:
     Engine::Log::info("Runtime Root: " + fs::current_path().string());
 
     auto config = m_Project->getConfig();
+    m_FixedStep.configure(config.fixedUpdateRate, config.maxSubSteps);
+
+    // Porovnanie dvoch behov krok po kroku (replay / lockstep debug)
+    if (!recordChecksums.empty()) {
+      m_ChecksumLog.startRecording(recordChecksums);
+    } else if (!verifyChecksums.empty()) {
+      m_ChecksumLog.startVerifying(verifyChecksums);
+    }
+    if (m_ChecksumLog.getMode() != Engine::ChecksumLog::Mode::Off && !config.deterministicPhysics) {
+      Engine::Log::warn("Checksums requested without Deterministic Physics, runs may differ even with the same input");
+    }
 
     // 4. Create Window & Renderer
     // Allow High-DPI for sharp text and 2D assets on modern displays
@@ -71,11 +88,19 @@ public:
     Engine::Input::init();
     m_AssetManager = std::make_unique<Engine::AssetManager>();
     m_AssetManager->init(m_Renderer);
+    // Obrazky zabalene buildom; bez manifestu sa nacitavaju po jednom
+    m_AssetManager->loadAtlasManifest(m_Project->getAssetPath());
+
+    // Renderer ostava na tomto threade, na worker ide len simulacia
+    m_Pipeline.setThreaded(config.threadedRendering && !singleThread);
   }
 
   ~GameApp() {
+    // Worker nesmie bezat, ked sa scena rusi
+    m_Pipeline.shutdown();
     if (m_CurrentScene)
       m_CurrentScene->shutdown();
+    Engine::JobSystem::shutdown();
     if (m_Renderer)
       SDL_DestroyRenderer(m_Renderer);
     if (m_Window)
@@ -83,100 +108,36 @@ public:
     SDL_Quit();
   }
 
-  void DrawSceneBackground(SDL_Renderer *renderer, Engine::Scene *scene,
-                           Engine::AssetManager *assetManager, float w,
-                           float h) {
-    if (!scene)
-      return;
-    auto &bg = scene->getBackground();
-
-    if (bg.type == Engine::BackgroundType::Solid) {
-      SDL_SetRenderDrawColor(renderer, (Uint8)(bg.color1.r * 255),
-                             (Uint8)(bg.color1.g * 255),
-                             (Uint8)(bg.color1.b * 255), 255);
-      SDL_RenderClear(renderer);
-    } else if (bg.type == Engine::BackgroundType::Gradient) {
-      // Simple vertical gradient pass
-      for (int i = 0; i < (int)h; i++) {
-        float t = (float)i / (float)h;
-        glm::vec4 c = glm::mix(bg.color1, bg.color2, t);
-        SDL_SetRenderDrawColor(renderer, (Uint8)(c.r * 255), (Uint8)(c.g * 255),
-                               (Uint8)(c.b * 255), 255);
-        SDL_RenderDrawLine(renderer, 0, i, (int)w, i);
-      }
-    } else if (bg.type == Engine::BackgroundType::Image) {
-      SDL_Texture *tex = assetManager->getTexture(bg.assetId);
-      if (tex) {
-        SDL_Rect dest = {0, 0, (int)w, (int)h};
-        if (!bg.stretch) {
-          int tw, th;
-          SDL_QueryTexture(tex, NULL, NULL, &tw, &th);
-          float screenAspect = w / h;
-          float texAspect = (float)tw / th;
-          if (screenAspect > texAspect) {
-            dest.w = (int)(h * texAspect);
-            dest.x = (int)((w - dest.w) / 2);
-          } else {
-            dest.h = (int)(w / texAspect);
-            dest.y = (int)((h - dest.h) / 2);
-          }
-        }
-        SDL_RenderCopy(renderer, tex, NULL, &dest);
-      } else {
-        // Fallback clear
-        SDL_SetRenderDrawColor(renderer, 30, 30, 45, 255);
-        SDL_RenderClear(renderer);
-      }
-    }
-  }
-
   void run() {
     if (!m_isRunning)
       return;
 
     loadStartScene();
 
+    const Engine::FramePipeline::PresentFn present =
+        [this](Engine::FramePipeline::Frame &frame) { presentFrame(frame); };
+
     while (m_isRunning) {
-      
       if (m_Project->m_SceneLoadRequested) {
-        std::filesystem::path sceneToLoadPath = m_Project->getPath() / "scenes" / (m_Project->m_PendingSceneName + ".json");
+        // Cakajuci frame odkazuje na textury starej sceny
+        m_Pipeline.discardPending();
         Engine::ProjectSerializer::loadScene(m_CurrentScene, m_Renderer, m_Project->m_PendingSceneName, m_AssetManager.get(), m_Project.get());
         m_Project->m_SceneLoadRequested = false;
+        m_FixedStep.reset();
       }
       Engine::Time::update();
       Engine::Input::update();
       processEvents();
 
-      // Render Pass
-      SDL_SetRenderDrawColor(m_Renderer, 0, 0, 0, 255);
-      SDL_RenderClear(m_Renderer);
-
-      if (m_CurrentScene) {
-        if (!m_CurrentScene->hasSystem<Engine::ScriptSystem>()) {
-          m_CurrentScene->addSystem<Engine::ScriptSystem>(m_Project.get());
-        }
-        int w, h;
-        SDL_GetWindowSize(m_Window, &w, &h);
-
-        DrawSceneBackground(m_Renderer, m_CurrentScene.get(), m_AssetManager.get(), w, h);
-
-        m_CurrentScene->update(Engine::Time::getDeltaTime());
-
-        auto camera = m_CurrentScene->getSceneCamera();
-        if (camera) {
-          m_CurrentScene->render(m_Renderer, *camera, w, h, m_Project.get(), Engine::Time::getDeltaTime());
-        } else {
-          static bool warned = false;
-          m_CurrentScene->render(m_Renderer, *camera, w, h, m_Project.get(), Engine::Time::getDeltaTime());
-
-          if (!warned) {
-            Engine::Log::warn("No Camera found in active scene.");
-            warned = true;
-          }
-        }
+      if (m_CurrentScene && !m_CurrentScene->hasSystem<Engine::ScriptSystem>()) {
+        m_CurrentScene->addSystem<Engine::ScriptSystem>(m_Project.get());
       }
 
-      SDL_RenderPresent(m_Renderer);
+      // Simulacia frame-u N+1 bezi popri kresleni frame-u N, potom sa N+1 nahra do fronty
+      float dt = Engine::Time::getDeltaTime();
+      m_Pipeline.simulate([this, dt]() { simulate(dt); }, present);
+      recordFrame(m_Pipeline.getRecordFrame(), dt);
+      m_Pipeline.endFrame(present);
     }
   }
 
@@ -200,6 +161,61 @@ private:
     return "";
   }
 
+  // Moze bezat na worker threade: ziadne volania SDL rendereru
+  void simulate(float dt) {
+    if (!m_CurrentScene)
+      return;
+
+    // Simulacia vo fixnych krokoch, zvysok frame-u sa dointerpoluje pri renderi
+    int steps = m_FixedStep.advance(dt);
+    for (int i = 0; i < steps; ++i) {
+      m_CurrentScene->fixedUpdate(m_FixedStep.getStep());
+      if (m_ChecksumLog.getMode() != Engine::ChecksumLog::Mode::Off) {
+        m_ChecksumLog.submit(m_CurrentScene->getStepIndex(), m_CurrentScene->computeStateChecksum());
+      }
+    }
+    m_CurrentScene->setInterpolationAlpha(m_FixedStep.getAlpha());
+
+    m_CurrentScene->update(dt);
+  }
+
+  // Skopiruje zo sceny vsetko, co treba na vykreslenie, aby sa frame dal kreslit pocas dalsej simulacie
+  void recordFrame(Engine::FramePipeline::Frame &frame, float dt) {
+    frame.queue.begin();
+    frame.hasScene = m_CurrentScene != nullptr;
+    if (!m_CurrentScene)
+      return;
+
+    int w, h;
+    SDL_GetWindowSize(m_Window, &w, &h);
+    frame.width = (float)w;
+    frame.height = (float)h;
+    frame.background = m_CurrentScene->getBackground();
+
+    auto camera = m_CurrentScene->getSceneCamera();
+    if (!camera) {
+      static bool warned = false;
+      if (!warned) {
+        Engine::Log::warn("No Camera found in active scene.");
+        warned = true;
+      }
+      return;
+    }
+    m_CurrentScene->submitRender(frame.queue, m_Renderer, *camera, frame.width, frame.height, m_Project.get(), dt);
+  }
+
+  void presentFrame(Engine::FramePipeline::Frame &frame) {
+    SDL_SetRenderDrawColor(m_Renderer, 0, 0, 0, 255);
+    SDL_RenderClear(m_Renderer);
+
+    if (frame.hasScene) {
+      m_Background.draw(m_Renderer, frame.background, (int)frame.width, (int)frame.height);
+    }
+    frame.queue.flush(m_Renderer);
+
+    SDL_RenderPresent(m_Renderer);
+  }
+
   void processEvents() {
     SDL_Event event;
     while (SDL_PollEvent(&event)) {
@@ -215,6 +231,7 @@ private:
 
   void loadStartScene() {
     auto config = m_Project->getConfig();
+    m_FixedStep.configure(config.fixedUpdateRate, config.maxSubSteps);
     if (config.startScenePath.empty()) {
       Engine::Log::error("No start scene defined in data.config");
       return;
@@ -245,15 +262,35 @@ private:
   SDL_Renderer *m_Renderer = nullptr;
   std::unique_ptr<Engine::Project> m_Project;
   std::unique_ptr<Engine::Scene> m_CurrentScene;
+  Engine::FixedTimestep m_FixedStep;
+  Engine::ChecksumLog m_ChecksumLog;
+  Engine::FramePipeline m_Pipeline;
+  Engine::SceneBackground m_Background;
   std::unique_ptr<Engine::AssetManager> m_AssetManager;
 };
 
 // Entry point
 int main(int argc, char *argv[]) {
   try {
-    std::string projectArgument = (argc > 1) ? argv[1] : "";
+    // runtime [project] [--record-checksums file | --verify-checksums file] [--single-thread]
+    std::string projectArgument;
+    std::string recordChecksums;
+    std::string verifyChecksums;
+    bool singleThread = false;
+    for (int i = 1; i < argc; ++i) {
+      std::string arg = argv[i];
+      if (arg == "--record-checksums" && i + 1 < argc) {
+        recordChecksums = argv[++i];
+      } else if (arg == "--verify-checksums" && i + 1 < argc) {
+        verifyChecksums = argv[++i];
+      } else if (arg == "--single-thread") {
+        singleThread = true;
+      } else if (projectArgument.empty()) {
+        projectArgument = arg;
+      }
+    }
 
-    GameApp app(projectArgument);
+    GameApp app(projectArgument, recordChecksums, verifyChecksums, singleThread);
     app.run();
   } catch (const std::exception &e) {
     std::cerr << "Engine Fatal Exception: " << e.what() << std::endl;
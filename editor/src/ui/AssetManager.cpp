@@ -268,10 +268,14 @@ void EditorApp::renderAssetManager()
 
                 else
                 {
-                    SDL_Texture *tex = m_AssetManager->getTexture(assetId);
-                    if (tex)
+                    Engine::TextureRegion region;
+                    if (Engine::AssetManager::getTextureRegion(assetId, region))
                     {
-                        drawList->AddImage((ImTextureID)tex, ImVec2(pos.x + 6, pos.y + 6), ImVec2(pos.x + thumbnailSize - 6, pos.y + thumbnailSize - 6));
+                        int texW, texH;
+                        SDL_QueryTexture(region.texture, NULL, NULL, &texW, &texH);
+                        ImVec2 uv0((float)region.rect.x / texW, (float)region.rect.y / texH);
+                        ImVec2 uv1((float)(region.rect.x + region.rect.w) / texW, (float)(region.rect.y + region.rect.h) / texH);
+                        drawList->AddImage((ImTextureID)region.texture, ImVec2(pos.x + 6, pos.y + 6), ImVec2(pos.x + thumbnailSize - 6, pos.y + thumbnailSize - 6), uv0, uv1);
                     }
                     else
                     {
@@ -359,6 +363,19 @@ void EditorApp::renderAssetManager()
                 {
                     try
                     {
+                        // Nacitane obrazky vratia svoje miesto v atlase skor, nez zmiznu subory
+                        std::vector<fs::path> files = {path};
+                        if (isDir)
+                        {
+                            for (const auto &child : fs::recursive_directory_iterator(path))
+                                files.push_back(child.path());
+                        }
+                        for (const auto &file : files)
+                        {
+                            std::string assetId = fs::relative(file, m_currentProject->getPath() / "assets").string();
+                            if (TextureAtlas::IsImageExtension(file.extension().string()) && m_AssetManager->getTexture(assetId))
+                                m_AssetManager->removeTexture(assetId);
+                        }
                         fs::remove_all(path);
                     }
                     catch (...)
@@ -437,6 +454,7 @@ void EditorApp::loadProjectAssets()
                 if (!sprite->assetId.empty())
                 {
                     sprite->texture = m_AssetManager->getTexture(sprite->assetId);
+                    sprite->atlasVersion = 0;
 
                     if (!sprite->texture)
                     {
@@ -11,6 +11,7 @@
 #include "ecs/components/ScriptComponent.h"
 #include "ecs/components/SoundComponent.h"
 #include "ecs/components/SpriteComponent.h"
+#include "ecs/components/TilemapComponent.h"
 #include "ecs/components/TransformComponent.h"
 #include "ecs/components/VelocityComponent.h"
 #include "ecs/systems/ScriptSystem.h"
@@ -33,6 +34,65 @@
 #include <filesystem>
 #include <algorithm>
 
+// Checkboxy pre pomenovane collision vrstvy projektu
+static void DrawLayerBits(const char *label, uint32_t &bits, const Engine::ProjectConfig &config)
+{
+  if (!ImGui::TreeNode(label))
+    return;
+
+  for (int i = 0; i < Engine::MaxCollisionLayers; ++i)
+  {
+    const std::string &name = config.layerNames[i];
+    if (name.empty())
+      continue;
+
+    uint32_t flag = 1u << i;
+    bool val = (bits & flag) != 0;
+    ImGui::PushID(i);
+    if (ImGui::Checkbox(name.c_str(), &val))
+    {
+      if (val)
+        bits |= flag;
+      else
+        bits &= ~flag;
+    }
+    ImGui::PopID();
+  }
+  ImGui::TreePop();
+}
+
+// Vyber render vrstvy projektu; nepomenovane vrstvy sa neponukaju
+static bool DrawRenderLayerCombo(const char *label, int &layer, const Engine::ProjectConfig &config)
+{
+  auto layerLabel = [&config](int i)
+  {
+    const auto &settings = config.renderLayers[i];
+    return settings.name + (settings.screenSpace ? " (Screen)" : "");
+  };
+
+  std::string preview = (layer >= 0 && layer < Engine::MaxRenderLayers && !config.renderLayers[layer].name.empty())
+                            ? layerLabel(layer)
+                            : "Layer " + std::to_string(layer);
+  bool changed = false;
+  if (ImGui::BeginCombo(label, preview.c_str()))
+  {
+    for (int i = 0; i < Engine::MaxRenderLayers; ++i)
+    {
+      if (config.renderLayers[i].name.empty())
+        continue;
+      ImGui::PushID(i);
+      if (ImGui::Selectable(layerLabel(i).c_str(), layer == i))
+      {
+        layer = i;
+        changed = true;
+      }
+      ImGui::PopID();
+    }
+    ImGui::EndCombo();
+  }
+  return changed;
+}
+
 void EditorApp::renderInspector()
 {
   ImGui::Begin("Inspector", &m_ShowInspector);
@@ -336,14 +396,16 @@ void EditorApp::renderInspector()
 
           if (ImGui::Selectable(assetId.c_str(), sprite->assetId == assetId))
           {
+            // Region sa nacita znova pri dalsom kresleni, novy asset byva na tej istej stranke atlasu
             sprite->assetId = assetId;
             sprite->texture = Engine::AssetManager::getTexture(sprite->assetId);
+            sprite->atlasVersion = 0;
 
-            if (sprite->sourceRect.w == 0 || sprite->sourceRect.h == 0)
+            Engine::TextureRegion region;
+            if ((sprite->sourceRect.w == 0 || sprite->sourceRect.h == 0) &&
+                Engine::AssetManager::getTextureRegion(assetId, region))
             {
-              int w, h;
-              SDL_QueryTexture(tex, NULL, NULL, &w, &h);
-              sprite->sourceRect = {0, 0, w, h};
+              sprite->sourceRect = {0, 0, region.rect.w, region.rect.h};
             }
             ImGui::CloseCurrentPopup();
           }
@@ -356,6 +418,7 @@ void EditorApp::renderInspector()
       if (ImGui::Button("Manual Reload", ImVec2(-1, 0)))
       {
         sprite->texture = Engine::AssetManager::getTexture(sprite->assetId);
+        sprite->atlasVersion = 0;
       }
 
       ImGui::Separator();
@@ -363,7 +426,7 @@ void EditorApp::renderInspector()
       ImGui::DragInt4("XYWH", &sprite->sourceRect.x, 1.0f, 0);
 
       ImGui::Separator();
-      ImGui::Checkbox("Fixed To Screen", &sprite->isFixed);
+      DrawRenderLayerCombo("Render Layer", sprite->layer, m_currentProject->getConfig());
       ImGui::DragInt("Z Index", &sprite->zIndex, 1.0f);
 
       ImGui::Separator();
@@ -390,11 +453,17 @@ void EditorApp::renderInspector()
         int texW, texH;
         SDL_QueryTexture(sprite->texture, NULL, NULL, &texW, &texH);
 
-        ImVec2 uv0 = ImVec2((float)sprite->sourceRect.x / texW,
-                            (float)sprite->sourceRect.y / texH);
+        // sourceRect je relativny k miestu assetu v atlase
+        SDL_Point origin = {0, 0};
+        Engine::TextureRegion region;
+        if (Engine::AssetManager::getTextureRegion(sprite->assetId, region) && region.texture == sprite->texture)
+          origin = {region.rect.x, region.rect.y};
+
+        ImVec2 uv0 = ImVec2((float)(origin.x + sprite->sourceRect.x) / texW,
+                            (float)(origin.y + sprite->sourceRect.y) / texH);
         ImVec2 uv1 =
-            ImVec2((float)(sprite->sourceRect.x + sprite->sourceRect.w) / texW,
-                   (float)(sprite->sourceRect.y + sprite->sourceRect.h) / texH);
+            ImVec2((float)(origin.x + sprite->sourceRect.x + sprite->sourceRect.w) / texW,
+                   (float)(origin.y + sprite->sourceRect.y + sprite->sourceRect.h) / texH);
 
         ImVec2 availSize = ImGui::GetContentRegionAvail();
         float aspect =
@@ -838,14 +907,19 @@ void EditorApp::renderInspector()
           textComp->dirty = true;
         }
       }
-      // --- Fixed Position ---
-      if (ImGui::Checkbox("Fixed On Screen", &textComp->isFixed))
-        textComp->dirty = true;
+      // --- Render Layer ---
+      DrawRenderLayerCombo("Render Layer", textComp->layer, m_currentProject->getConfig());
 
       // --- Z Index ---
       if (ImGui::DragInt("Z Index", &textComp->zIndex, 1))
         textComp->dirty = true;
 
+      if (ImGui::Checkbox("Dynamic", &textComp->dynamic))
+        textComp->dirty = true;
+      if (ImGui::IsItemHovered())
+        ImGui::SetTooltip("Drawn from shared glyph atlas pages, so changing the text only lays it out again.\n"
+                          "Use for scores, timers and other text that changes often.");
+
       // --- Remove Component ---
       if (ImGui::Button("Remove Text Component", ImVec2(-1, 0)))
       {
@@ -1117,28 +1191,42 @@ void EditorApp::renderInspector()
       {
         // Body Type Combo
         const char *bodyTypes[] = {"Static", "Dynamic", "Kinematic"};
-        int currentType = (int)rb->bodyType;
+        int currentType = (int)rb->getBodyType();
         if (ImGui::Combo("Body Type", &currentType, bodyTypes,
                          IM_ARRAYSIZE(bodyTypes)))
         {
-          rb->bodyType = (Engine::BodyType)currentType;
+          rb->setBodyType((Engine::BodyType)currentType);
         }
 
         ImGui::DragFloat("Mass", &rb->mass, 0.1f, 0.001f, 1000.0f);
         ImGui::DragFloat("Gravity Scale", &rb->gravityScale, 0.1f, -10.0f,
                          10.0f);
         ImGui::DragFloat("Linear Drag", &rb->linearDrag, 0.01f, 0.0f, 1.0f);
+        ImGui::DragFloat("Restitution", &rb->restitution, 0.01f, 0.0f, 1.0f);
+        ImGui::DragFloat("Friction", &rb->friction, 0.01f, 0.0f, 2.0f);
+        ImGui::Checkbox("Allow Sleep", &rb->allowSleep);
+        ImGui::Checkbox("Continuous Collision", &rb->continuousCollision);
+        if (ImGui::IsItemHovered())
+        {
+          ImGui::SetTooltip("Sweeps fast bodies against static colliders so they cannot pass through thin walls.");
+        }
 
         ImGui::Separator();
         ImGui::Text("Physics State");
         ImGui::DragFloat2("Velocity", &rb->velocity.x, 0.1f);
         ImGui::DragFloat2("Acceleration", &rb->acceleration.x, 0.1f);
+        ImGui::Text("State: %s", rb->isAwake ? "Awake" : "Sleeping");
 
         if (ImGui::Button("Reset Velocity"))
         {
           rb->velocity = {0, 0};
           rb->acceleration = {0, 0};
         }
+        ImGui::SameLine();
+        if (ImGui::Button("Wake"))
+        {
+          rb->wake();
+        }
       }
     }
     ImGui::PopID();
@@ -1213,45 +1301,9 @@ void EditorApp::renderInspector()
         ImGui::Separator();
         ImGui::Text("Collision Filtering");
 
-        // Helper for bitmask flags
-        auto LayerFlag = [&](const char *label, Engine::CollisionLayer flag,
-                             uint32_t &mask)
-        {
-          bool val = (mask & flag);
-          if (ImGui::Checkbox(label, &val))
-          {
-            if (val)
-              mask |= flag;
-            else
-              mask &= ~flag;
-          }
-        };
-
-        if (ImGui::TreeNode("Layer (Who am I?)"))
-        {
-          uint32_t layer = bc->layer;
-          LayerFlag("Default", Engine::CollisionLayer::Default, layer);
-          LayerFlag("Player", Engine::CollisionLayer::Player, layer);
-          LayerFlag("Enemy", Engine::CollisionLayer::Enemy, layer);
-          LayerFlag("Obstacle", Engine::CollisionLayer::Obstacle, layer);
-          LayerFlag("Projectile", Engine::CollisionLayer::Projectile, layer);
-          LayerFlag("Trigger", Engine::CollisionLayer::Trigger, layer);
-          bc->layer = layer;
-          ImGui::TreePop();
-        }
-
-        if (ImGui::TreeNode("Mask (Who hits me?)"))
-        {
-          uint32_t mask = bc->mask;
-          LayerFlag("Default", Engine::CollisionLayer::Default, mask);
-          LayerFlag("Player", Engine::CollisionLayer::Player, mask);
-          LayerFlag("Enemy", Engine::CollisionLayer::Enemy, mask);
-          LayerFlag("Obstacle", Engine::CollisionLayer::Obstacle, mask);
-          LayerFlag("Projectile", Engine::CollisionLayer::Projectile, mask);
-          LayerFlag("Trigger", Engine::CollisionLayer::Trigger, mask);
-          bc->mask = mask;
-          ImGui::TreePop();
-        }
+        auto &projectConfig = m_currentProject->getConfig();
+        DrawLayerBits("Layer (Who am I?)", bc->layer, projectConfig);
+        DrawLayerBits("Mask (Who hits me?)", bc->mask, projectConfig);
       }
     }
     ImGui::PopID();
@@ -1291,44 +1343,9 @@ void EditorApp::renderInspector()
         ImGui::Separator();
         ImGui::Text("Collision Filtering");
 
-        auto LayerFlag = [&](const char *label, Engine::CollisionLayer flag,
-                             uint32_t &mask)
-        {
-          bool val = (mask & flag);
-          if (ImGui::Checkbox(label, &val))
-          {
-            if (val)
-              mask |= flag;
-            else
-              mask &= ~flag;
-          }
-        };
-
-        if (ImGui::TreeNode("Layer (Who am I?)##Circle"))
-        {
-          uint32_t layer = cc->layer;
-          LayerFlag("Default", Engine::CollisionLayer::Default, layer);
-          LayerFlag("Player", Engine::CollisionLayer::Player, layer);
-          LayerFlag("Enemy", Engine::CollisionLayer::Enemy, layer);
-          LayerFlag("Obstacle", Engine::CollisionLayer::Obstacle, layer);
-          LayerFlag("Projectile", Engine::CollisionLayer::Projectile, layer);
-          LayerFlag("Trigger", Engine::CollisionLayer::Trigger, layer);
-          cc->layer = layer;
-          ImGui::TreePop();
-        }
-
-        if (ImGui::TreeNode("Mask (Who hits me?)##Circle"))
-        {
-          uint32_t mask = cc->mask;
-          LayerFlag("Default", Engine::CollisionLayer::Default, mask);
-          LayerFlag("Player", Engine::CollisionLayer::Player, mask);
-          LayerFlag("Enemy", Engine::CollisionLayer::Enemy, mask);
-          LayerFlag("Obstacle", Engine::CollisionLayer::Obstacle, mask);
-          LayerFlag("Projectile", Engine::CollisionLayer::Projectile, mask);
-          LayerFlag("Trigger", Engine::CollisionLayer::Trigger, mask);
-          cc->mask = mask;
-          ImGui::TreePop();
-        }
+        auto &projectConfig = m_currentProject->getConfig();
+        DrawLayerBits("Layer (Who am I?)##Circle", cc->layer, projectConfig);
+        DrawLayerBits("Mask (Who hits me?)##Circle", cc->mask, projectConfig);
       }
     }
     ImGui::PopID();
@@ -1389,48 +1406,153 @@ void EditorApp::renderInspector()
         }
         ImGui::Unindent();
 
+        // Concave outlines are split into convex pieces for the collision tests
+        size_t pieceCount = pc->getConvexPieces().size();
+        if (pieceCount == 0)
+          ImGui::TextColored(ImVec4(1.0f, 0.6f, 0.2f, 1.0f), "Outline has no area - no collisions");
+        else if (!pc->isConvex())
+          ImGui::TextDisabled("Concave: %d convex pieces", (int)pieceCount);
+
         ImGui::Separator();
         ImGui::Text("Collision Filtering");
 
-        auto LayerFlag = [&](const char *label, Engine::CollisionLayer flag,
-                             uint32_t &mask)
+        auto &projectConfig = m_currentProject->getConfig();
+        DrawLayerBits("Layer (Who am I?)##Circle", pc->layer, projectConfig);
+        DrawLayerBits("Mask (Who hits me?)##Circle", pc->mask, projectConfig);
+      }
+    }
+    ImGui::PopID();
+  }
+
+  if (m_SelectedEntity->hasComponent<Engine::TilemapComponent>())
+  {
+    bool open = ImGui::CollapsingHeader("Tilemap");
+
+    ImGui::PushID("Tilemap");
+    if (ImGui::BeginPopupContextItem("TilemapContext"))
+    {
+      if (ImGui::MenuItem("Remove Tilemap Component"))
+      {
+        m_SelectedEntity->removeComponent<Engine::TilemapComponent>();
+        g_PaintTilemapMode = false;
+      }
+      ImGui::EndPopup();
+    }
+
+    auto tilemap = m_SelectedEntity->getComponent<Engine::TilemapComponent>();
+    if (open && tilemap)
+    {
+      ImGui::Checkbox("Visible", &tilemap->visible);
+      ImGui::Text("Tileset: %s", tilemap->tilesetAssetId.empty() ? "None" : tilemap->tilesetAssetId.c_str());
+      if (ImGui::Button("Change Tileset...", ImVec2(ImGui::GetContentRegionAvail().x, 0)))
+      {
+        ImGui::OpenPopup("TilesetSelectorPopup");
+      }
+
+      if (ImGui::BeginPopup("TilesetSelectorPopup"))
+      {
+        static char tilesetSearch[64] = "";
+        ImGui::InputTextWithHint("##TilesetSearch", "Search...", tilesetSearch, sizeof(tilesetSearch));
+        ImGui::Separator();
+
+        ImGui::BeginChild("TilesetList", ImVec2(250, 200));
+        for (auto const &[assetId, tex] : Engine::AssetManager::m_Textures)
         {
-          bool val = (mask & flag);
-          if (ImGui::Checkbox(label, &val))
+          if (strlen(tilesetSearch) > 0 && assetId.find(tilesetSearch) == std::string::npos)
+            continue;
+
+          if (ImGui::Selectable(assetId.c_str(), tilemap->tilesetAssetId == assetId))
           {
-            if (val)
-              mask |= flag;
-            else
-              mask &= ~flag;
+            // Region sa nacita znova pri dalsom kresleni
+            tilemap->tilesetAssetId = assetId;
+            tilemap->atlasVersion = 0;
+            ImGui::CloseCurrentPopup();
           }
-        };
-
-        if (ImGui::TreeNode("Layer (Who am I?)##Circle"))
-        {
-          uint32_t layer = pc->layer;
-          LayerFlag("Default", Engine::CollisionLayer::Default, layer);
-          LayerFlag("Player", Engine::CollisionLayer::Player, layer);
-          LayerFlag("Enemy", Engine::CollisionLayer::Enemy, layer);
-          LayerFlag("Obstacle", Engine::CollisionLayer::Obstacle, layer);
-          LayerFlag("Projectile", Engine::CollisionLayer::Projectile, layer);
-          LayerFlag("Trigger", Engine::CollisionLayer::Trigger, layer);
-          pc->layer = layer;
-          ImGui::TreePop();
         }
+        ImGui::EndChild();
+        ImGui::EndPopup();
+      }
+
+      if (ImGui::DragInt2("Tile Size", &tilemap->tileSize.x, 1.0f, 1, 1024))
+      {
+        tilemap->tileSize = glm::max(tilemap->tileSize, glm::ivec2(1));
+      }
+
+      ImGui::Separator();
+      DrawRenderLayerCombo("Render Layer##Tilemap", tilemap->layer, m_currentProject->getConfig());
+      ImGui::DragInt("Z Index##Tilemap", &tilemap->zIndex, 1.0f);
+
+      float color[4] = {tilemap->color.r / 255.0f, tilemap->color.g / 255.0f,
+                        tilemap->color.b / 255.0f, tilemap->color.a / 255.0f};
+      if (ImGui::ColorEdit4("Tint##Tilemap", color))
+      {
+        tilemap->color.r = (Uint8)(color[0] * 255);
+        tilemap->color.g = (Uint8)(color[1] * 255);
+        tilemap->color.b = (Uint8)(color[2] * 255);
+        tilemap->color.a = (Uint8)(color[3] * 255);
+      }
 
-        if (ImGui::TreeNode("Mask (Who hits me?)##Circle"))
+      ImGui::Separator();
+      ImGui::Text("Tiles: %d in %d chunks", tilemap->getTileCount(), (int)tilemap->getChunks().size());
+      ImGui::Checkbox("Paint in viewport", &g_PaintTilemapMode);
+      ImGui::SameLine();
+      if (ImGui::Button("Clear##Tilemap"))
+      {
+        tilemap->clear();
+      }
+
+      // Paleta: klik vyberie dlazdicu pre stetec, prva polozka je guma
+      if (ImGui::Selectable("Eraser", g_TilemapBrushTile == 0))
+      {
+        g_TilemapBrushTile = 0;
+      }
+
+      Engine::TextureRegion region;
+      if (tilemap->tileSize.x > 0 && tilemap->tileSize.y > 0 &&
+          Engine::AssetManager::getTextureRegion(tilemap->tilesetAssetId, region) && region.texture)
+      {
+        int texW, texH;
+        SDL_QueryTexture(region.texture, NULL, NULL, &texW, &texH);
+        int columns = region.rect.w / tilemap->tileSize.x;
+        int rows = region.rect.h / tilemap->tileSize.y;
+        int count = std::min(columns * rows, 0xFFFF);
+
+        const float cell = 32.0f;
+        int perRow = std::max(1, (int)(ImGui::GetContentRegionAvail().x / (cell + ImGui::GetStyle().ItemSpacing.x)));
+        for (int i = 0; i < count; ++i)
         {
-          uint32_t mask = pc->mask;
-          LayerFlag("Default", Engine::CollisionLayer::Default, mask);
-          LayerFlag("Player", Engine::CollisionLayer::Player, mask);
-          LayerFlag("Enemy", Engine::CollisionLayer::Enemy, mask);
-          LayerFlag("Obstacle", Engine::CollisionLayer::Obstacle, mask);
-          LayerFlag("Projectile", Engine::CollisionLayer::Projectile, mask);
-          LayerFlag("Trigger", Engine::CollisionLayer::Trigger, mask);
-          pc->mask = mask;
-          ImGui::TreePop();
+          int x = region.rect.x + (i % columns) * tilemap->tileSize.x;
+          int y = region.rect.y + (i / columns) * tilemap->tileSize.y;
+          ImVec2 uv0((float)x / texW, (float)y / texH);
+          ImVec2 uv1((float)(x + tilemap->tileSize.x) / texW, (float)(y + tilemap->tileSize.y) / texH);
+
+          if (i % perRow != 0)
+            ImGui::SameLine();
+          ImGui::Image((ImTextureID)region.texture, ImVec2(cell, cell), uv0, uv1);
+          if (ImGui::IsItemClicked())
+          {
+            g_TilemapBrushTile = i + 1;
+          }
+          if (g_TilemapBrushTile == i + 1)
+          {
+            ImGui::GetWindowDrawList()->AddRect(ImGui::GetItemRectMin(), ImGui::GetItemRectMax(),
+                                                IM_COL32(255, 255, 0, 255), 0.0f, 0, 2.0f);
+          }
         }
       }
+      else
+      {
+        ImGui::TextDisabled("No tileset loaded");
+      }
+
+      ImGui::Separator();
+      ImGui::Checkbox("Collision##Tilemap", &tilemap->collision);
+      if (tilemap->collision)
+      {
+        auto &projectConfig = m_currentProject->getConfig();
+        DrawLayerBits("Layer (Who am I?)##Tilemap", tilemap->collisionLayer, projectConfig);
+        DrawLayerBits("Mask (Who hits me?)##Tilemap", tilemap->collisionMask, projectConfig);
+      }
     }
     ImGui::PopID();
   }
@@ -1490,6 +1612,10 @@ void EditorApp::renderInspector()
     {
       m_SelectedEntity->addComponent<Engine::SoundComponent>();
     }
+    if (ImGui::MenuItem("Tilemap"))
+    {
+      m_SelectedEntity->addComponent<Engine::TilemapComponent>();
+    }
     if (ImGui::MenuItem("Text"))
     {
       auto comp = m_SelectedEntity->addComponent<Engine::TextComponent>();
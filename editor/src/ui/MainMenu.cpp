@@ -183,6 +183,132 @@ void EditorApp::renderProjectSettingsPopup()
     ImGui::DragInt("Width", &config.width, 1.0f, 640, 7680);
     ImGui::DragInt("Height", &config.height, 1.0f, 360, 4320);
 
+    ImGui::Spacing();
+    ImGui::Text("Simulation");
+    ImGui::Separator();
+    ImGui::DragInt("Fixed Update Rate (Hz)", &config.fixedUpdateRate, 1.0f, 10, 240);
+    ImGui::DragInt("Max Sub Steps", &config.maxSubSteps, 1.0f, 1, 16);
+    ImGui::DragInt("Velocity Iterations", &config.velocityIterations, 1.0f, 1, 32);
+    ImGui::DragInt("Position Iterations", &config.positionIterations, 1.0f, 0, 16);
+    ImGui::DragInt("Trigger Check Interval (steps)", &config.triggerUpdateInterval, 0.1f, 1, 10);
+    ImGui::Checkbox("Deterministic Physics", &config.deterministicPhysics);
+    if (ImGui::IsItemHovered())
+      ImGui::SetTooltip("Input is applied once per fixed step and entities are processed in creation order,\n"
+                        "so runs with the same input give the same simulation. Use OnFixedUpdate for gameplay.");
+    ImGui::Checkbox("Threaded Rendering", &config.threadedRendering);
+    if (ImGui::IsItemHovered())
+      ImGui::SetTooltip("The runtime simulates the next frame on a worker thread while the previous one is presented.\n"
+                        "Adds one frame of display latency. Turn off to run everything on one thread.");
+    ImGui::DragInt("Text Cache (MB)", &config.textCacheBudgetMB, 1.0f, 0, 1024);
+    if (ImGui::IsItemHovered())
+      ImGui::SetTooltip("GPU memory kept for textures of non-dynamic texts. Textures of texts not drawn recently\n"
+                        "are freed above this budget and rasterized again when the text comes back into view.");
+
+    ImGui::Spacing();
+    ImGui::Text("Navigation");
+    ImGui::Separator();
+    ImGui::DragFloat("Cell Size", &config.navCellSize, 1.0f, 4.0f, 256.0f);
+    ImGui::DragFloat("Agent Radius", &config.navAgentRadius, 0.5f, 0.0f, 128.0f);
+    if (ImGui::IsItemHovered())
+      ImGui::SetTooltip("Static Box and Polygon colliders are grown by this radius when the navigation grid is baked,\n"
+                        "so paths keep agents of this size clear of walls.");
+
+    ImGui::Spacing();
+    ImGui::Text("Render Layers");
+    ImGui::Separator();
+    ImGui::TextDisabled("Layers are drawn in this order, zIndex only sorts within a layer.");
+
+    if (ImGui::TreeNode("Render Layer Settings"))
+    {
+      for (int i = 0; i < Engine::MaxRenderLayers; ++i)
+      {
+        auto &layer = config.renderLayers[i];
+        char layerBuf[64];
+        strncpy(layerBuf, layer.name.c_str(), sizeof(layerBuf));
+        layerBuf[sizeof(layerBuf) - 1] = '\0';
+
+        ImGui::PushID(i);
+        std::string label = "Layer " + std::to_string(i);
+        if (ImGui::InputText(label.c_str(), layerBuf, sizeof(layerBuf)))
+          layer.name = layerBuf;
+        ImGui::SameLine();
+        ImGui::Checkbox("Screen Space", &layer.screenSpace);
+        if (ImGui::IsItemHovered())
+          ImGui::SetTooltip("Positions are target pixels and the camera is ignored, for UI.");
+        ImGui::SameLine();
+        ImGui::Checkbox("Static", &layer.isStatic);
+        if (ImGui::IsItemHovered())
+          ImGui::SetTooltip("Sprites of this layer are drawn once into cached chunk textures and redrawn only\n"
+                            "when one of them changes or the zoom changes. For large, rarely moving decoration.\n"
+                            "Sprite animations do not play on a static layer; ignored for screen space layers.");
+        ImGui::PopID();
+      }
+      ImGui::TreePop();
+    }
+
+    ImGui::Spacing();
+    ImGui::Text("Collision Layers");
+    ImGui::Separator();
+
+    if (ImGui::TreeNode("Layer Names"))
+    {
+      for (int i = 0; i < Engine::MaxCollisionLayers; ++i)
+      {
+        char layerBuf[64];
+        strncpy(layerBuf, config.layerNames[i].c_str(), sizeof(layerBuf));
+        layerBuf[sizeof(layerBuf) - 1] = '\0';
+
+        ImGui::PushID(i);
+        std::string label = "Layer " + std::to_string(i);
+        if (ImGui::InputText(label.c_str(), layerBuf, sizeof(layerBuf)))
+        {
+          config.layerNames[i] = layerBuf;
+        }
+        ImGui::PopID();
+      }
+      ImGui::TreePop();
+    }
+
+    // Matica je symetricka - zaskrtnutie nastavi oba smery
+    if (ImGui::TreeNode("Layer Interactions"))
+    {
+      for (int i = 0; i < Engine::MaxCollisionLayers; ++i)
+      {
+        if (config.layerNames[i].empty())
+          continue;
+
+        ImGui::PushID(i);
+        if (ImGui::TreeNode(config.layerNames[i].c_str()))
+        {
+          for (int j = 0; j < Engine::MaxCollisionLayers; ++j)
+          {
+            if (config.layerNames[j].empty())
+              continue;
+
+            bool interacts = (config.layerMatrix[i] & (1u << j)) != 0;
+            ImGui::PushID(j);
+            if (ImGui::Checkbox(config.layerNames[j].c_str(), &interacts))
+            {
+              if (interacts)
+              {
+                config.layerMatrix[i] |= (1u << j);
+                config.layerMatrix[j] |= (1u << i);
+              }
+              else
+              {
+                config.layerMatrix[i] &= ~(1u << j);
+                config.layerMatrix[j] &= ~(1u << i);
+              }
+            }
+            ImGui::PopID();
+          }
+          ImGui::TreePop();
+        }
+        ImGui::PopID();
+      }
+      ImGui::TreePop();
+    }
+
     ImGui::Spacing();
     ImGui::Separator();
     ImGui::Spacing();
@@ -3,17 +3,22 @@
 #include "ImGuizmo.h"
 #include "SDL_render.h"
 #include "core/Camera.h"
+#include "core/FontManager.h"
 #include "core/Time.h"
 #include "ecs/Entity.h"
 #include "ecs/components/BoxColliderComponent.h"
 #include "ecs/components/CircleColliderComponent.h"
 #include "ecs/components/PolygonColliderComponent.h"
 #include "ecs/components/SpriteComponent.h"
+#include "ecs/components/TilemapComponent.h"
 #include "ecs/components/TransformComponent.h"
+#include "ecs/systems/RendererSystem.h"
+#include "ecs/systems/TextSystem.h"
 #include "glm/ext/quaternion_common.hpp"
 #include "glm/gtc/type_ptr.hpp"
 #include "scene/Scene.h"
 #include <imgui.h>
+#include <cmath>
 #include <vector>
 #include "core/ProjectSerializer.h"
 
@@ -37,75 +42,6 @@ glm::mat4 GetWorldMatrix(Engine::Entity *e)
   return local;
 }
 
-void DrawSceneBackground(SDL_Renderer *renderer, Engine::Scene *scene,
-                         Engine::AssetManager *assetManager, float w, float h)
-{
-  if (!scene)
-    return;
-  auto &bg = scene->getBackground();
-
-  if (bg.type == Engine::BackgroundType::Solid)
-  {
-    SDL_SetRenderDrawColor(renderer, (Uint8)(bg.color1.r * 255),
-                           (Uint8)(bg.color1.g * 255),
-                           (Uint8)(bg.color1.b * 255), 255);
-    SDL_RenderClear(renderer);
-  }
-  else if (bg.type == Engine::BackgroundType::Gradient)
-  {
-    for (int i = 0; i < (int)h; i++)
-    {
-      float t = (float)i / (float)h;
-      glm::vec4 c = glm::mix(bg.color1, bg.color2, t);
-      SDL_SetRenderDrawColor(renderer, (Uint8)(c.r * 255), (Uint8)(c.g * 255),
-                             (Uint8)(c.b * 255), 255);
-      SDL_RenderDrawLine(renderer, 0, i, (int)w, i);
-    }
-  }
-  else if (bg.type == Engine::BackgroundType::Image)
-  {
-    SDL_Texture *tex = assetManager->getTexture(bg.assetId);
-    if (tex)
-    {
-      if (bg.stretch)
-      {
-        SDL_Rect dest = {0, 0, (int)w, (int)h};
-        SDL_RenderCopy(renderer, tex, NULL, &dest);
-      }
-      else
-      {
-        int tw, th;
-        SDL_QueryTexture(tex, NULL, NULL, &tw, &th);
-
-        if (tw > 0 && th > 0)
-        {
-          for (int x = 0; x < (int)w; x += tw)
-          {
-            for (int y = 0; y < (int)h; y += th)
-            {
-              SDL_Rect dest = {x, y, tw, th};
-
-              if (x + tw > (int)w)
-                dest.w = (int)w - x;
-              if (y + th > (int)h)
-                dest.h = (int)h - y;
-
-              SDL_Rect src = {0, 0, dest.w, dest.h};
-
-              SDL_RenderCopy(renderer, tex, &src, &dest);
-            }
-          }
-        }
-      }
-    }
-    else
-    {
-      SDL_SetRenderDrawColor(renderer, 30, 30, 45, 255);
-      SDL_RenderClear(renderer);
-    }
-  }
-}
-
 void EditorApp::renderViewport()
 {
   static Engine::Camera s_EditorCamera;
@@ -194,8 +130,7 @@ void EditorApp::renderViewport()
     SDL_RenderSetClipRect(m_Renderer, &fullRect);
     if (currentScene)
     {
-      DrawSceneBackground(m_Renderer, currentScene.get(), m_AssetManager.get(),
-                          renderW, renderH);
+      m_SceneBackground.draw(m_Renderer, currentScene->getBackground(), (int)renderW, (int)renderH);
     }
     else
     {
@@ -208,10 +143,20 @@ void EditorApp::renderViewport()
       Engine::Camera *renderCamera = (m_SceneState == SceneState::EDIT)
                                          ? &s_EditorCamera
                                          : currentScene->getSceneCamera();
+      Engine::RenderQueue &queue = currentScene->getRenderQueue();
+      if (m_currentProject)
+        currentScene->setScreenSpaceLayers(Engine::GetScreenSpaceLayerMask(m_currentProject->getConfig().renderLayers));
+        currentScene->setStaticLayers(Engine::GetStaticLayerMask(m_currentProject->getConfig().renderLayers));
+
+      // Scena aj debug tvary idu do jednej fronty, debug vrstva je navrchu
       if (renderCamera)
-        currentScene->render(m_Renderer, *renderCamera, renderW, renderH, m_currentProject, Engine::Time::getDeltaTime());
+        currentScene->submitRender(m_Renderer, *renderCamera, renderW, renderH, m_currentProject, Engine::Time::getDeltaTime());
+      else
+        queue.begin();
     }
 
+    const uint64_t debugKey = Engine::RenderSortKey::Pack(Engine::RenderSortKey::DebugLayer, 0, 0, 0, 0);
+
     if (m_SceneState == SceneState::EDIT && currentScene)
     {
       Engine::Camera *gameCamera = currentScene->getSceneCamera();
@@ -246,13 +191,14 @@ void EditorApp::renderViewport()
         }
         screenPoints[4] = screenPoints[0];
 
-        SDL_SetRenderDrawColor(m_Renderer, 255, 255, 255, 100);
-        SDL_RenderDrawLinesF(m_Renderer, screenPoints, 5);
+        currentScene->getRenderQueue().submitLines(debugKey, screenPoints, 5, SDL_Color{255, 255, 255, 100});
       }
     }
 
-    if (m_SceneState == SceneState::EDIT && m_SelectedEntity)
+    if (m_SceneState == SceneState::EDIT && m_SelectedEntity && currentScene)
     {
+      Engine::RenderQueue &queue = currentScene->getRenderQueue();
+      const SDL_Color colliderColor = {0, 255, 0, 255};
       glm::mat4 viewMatrix = s_EditorCamera.getViewMatrix();
       glm::mat4 projectionMatrix = s_EditorCamera.getProjectionMatrix();
       glm::mat4 modelMatrix = GetWorldMatrix(m_SelectedEntity);
@@ -280,10 +226,7 @@ void EditorApp::renderViewport()
                             (1.0f - ndc.y) * 0.5f * renderH};
       }
       screenOutline[4] = screenOutline[0];
-      SDL_SetRenderDrawColor(m_Renderer, 255, 255, 0, 150);
-      SDL_RenderDrawLinesF(m_Renderer, screenOutline, 5);
-
-      SDL_SetRenderDrawColor(m_Renderer, 0, 255, 0, 255);
+      queue.submitLines(debugKey, screenOutline, 5, SDL_Color{255, 255, 0, 150});
 
       if (m_SelectedEntity->hasComponent<Engine::BoxColliderComponent>())
       {
@@ -317,7 +260,7 @@ void EditorApp::renderViewport()
           }
         }
         sCol[4] = sCol[0];
-        SDL_RenderDrawLinesF(m_Renderer, sCol, 5);
+        queue.submitLines(debugKey, sCol, 5, colliderColor);
       }
 
       if (m_SelectedEntity->hasComponent<Engine::CircleColliderComponent>())
@@ -337,7 +280,7 @@ void EditorApp::renderViewport()
           sCol[i] = {(ndc.x + 1.0f) * 0.5f * renderW,
                      (1.0f - ndc.y) * 0.5f * renderH};
         }
-        SDL_RenderDrawLinesF(m_Renderer, sCol, segments + 1);
+        queue.submitLines(debugKey, sCol, segments + 1, colliderColor);
       }
 
       if (m_SelectedEntity->hasComponent<Engine::PolygonColliderComponent>())
@@ -357,17 +300,78 @@ void EditorApp::renderViewport()
                             (1.0f - ndc.y) * 0.5f * renderH});
           }
           sCol.push_back(sCol[0]); // Close polygon
-          SDL_RenderDrawLinesF(m_Renderer, sCol.data(), (int)sCol.size());
+          queue.submitLines(debugKey, sCol.data(), (int)sCol.size(), colliderColor);
+        }
+      }
+
+      // Zlucene obdlzniky dlazdic, presne to, s cim koliduje fyzika
+      if (auto tilemap = m_SelectedEntity->getComponent<Engine::TilemapComponent>(); tilemap && tilemap->collision)
+      {
+        glm::vec2 tileSize(tilemap->tileSize);
+        for (const auto &[key, chunk] : tilemap->getChunks())
+        {
+          glm::ivec2 firstTile = Engine::TilemapComponent::ChunkCoords(key) * Engine::TilemapComponent::ChunkSize;
+          for (const auto &rect : tilemap->getChunkColliders(key))
+          {
+            glm::vec2 min = glm::vec2(firstTile.x + rect.x, firstTile.y + rect.y) * tileSize;
+            glm::vec2 max = min + glm::vec2(rect.w, rect.h) * tileSize;
+            const glm::vec2 corners[4] = {min, {max.x, min.y}, max, {min.x, max.y}};
+
+            SDL_FPoint sCol[5];
+            for (int i = 0; i < 4; i++)
+            {
+              glm::vec4 cp = mvp * glm::vec4(corners[i].x, corners[i].y, 0.01f, 1.0f);
+              glm::vec3 ndc = glm::vec3(cp.x / cp.w, cp.y / cp.w, cp.z / cp.w);
+              sCol[i] = {(ndc.x + 1.0f) * 0.5f * renderW,
+                         (1.0f - ndc.y) * 0.5f * renderH};
+            }
+            sCol[4] = sCol[0];
+            queue.submitLines(debugKey, sCol, 5, colliderColor);
+          }
         }
       }
     }
 
+    if (currentScene)
+      currentScene->getRenderQueue().flush(m_Renderer);
+
     SDL_SetRenderTarget(m_Renderer, nullptr);
   }
 
   ImGui::Image((ImTextureID)m_GameRenderTarget, viewportSize);
 
-  if (m_SceneState == SceneState::EDIT && currentScene && ImGui::IsWindowHovered())
+  if (currentScene)
+  {
+    if (auto *renderSys = currentScene->getSystem<Engine::RendererSystem>())
+    {
+      const auto &stats = renderSys->getStats();
+      int culled = stats.culled;
+      if (auto *textSys = currentScene->getSystem<Engine::TextSystem>())
+        culled += textSys->getStats().culled;
+      char overlay[96];
+      snprintf(overlay, sizeof(overlay), "Sprites: %d  Draw calls: %d  Culled: %d", stats.sprites,
+               currentScene->getRenderQueue().getStats().drawCalls, culled);
+      ImGui::GetWindowDrawList()->AddText(ImVec2(viewportPos.x + 8.0f, viewportPos.y + 8.0f),
+                                          IM_COL32(255, 255, 255, 160), overlay);
+
+      if (auto *textSys = currentScene->getSystem<Engine::TextSystem>())
+      {
+        const auto &cache = textSys->getCacheStats();
+        const auto &fonts = Engine::FontManager::GetStats();
+        snprintf(overlay, sizeof(overlay), "Text cache: %.1f/%.0f MB  Glyphs: %.0f MB  Evicted: %llu  Fonts: %d",
+                 cache.bytes / (1024.0 * 1024.0), cache.budget / (1024.0 * 1024.0), cache.glyphBytes / (1024.0 * 1024.0),
+                 (unsigned long long)(cache.evictions + fonts.evictions), fonts.fonts);
+        ImGui::GetWindowDrawList()->AddText(ImVec2(viewportPos.x + 8.0f, viewportPos.y + 8.0f + ImGui::GetTextLineHeight()),
+                                            IM_COL32(255, 255, 255, 160), overlay);
+      }
+    }
+  }
+
+  // Pri kresleni tilemapy lave tlacidlo patri stetcu, nie vyberu entity
+  bool paintingTilemap = g_PaintTilemapMode && m_SelectedEntity &&
+                         m_SelectedEntity->hasComponent<Engine::TilemapComponent>();
+
+  if (m_SceneState == SceneState::EDIT && currentScene && ImGui::IsWindowHovered() && !paintingTilemap)
   {
     if (ImGui::IsMouseClicked(ImGuiMouseButton_Left) && !ImGuizmo::IsUsing())
     {
@@ -443,7 +447,47 @@ void EditorApp::renderViewport()
     glm::mat4 entityWorld = GetWorldMatrix(m_SelectedEntity);
     glm::mat4 mvp = projectionMatrix * viewMatrix * entityWorld;
 
-    if (g_EditColliderMode)
+    if (paintingTilemap)
+    {
+      auto tilemap = m_SelectedEntity->getComponent<Engine::TilemapComponent>();
+      bool inViewport = mousePos.x >= viewportPos.x && mousePos.x <= viewportPos.x + viewportSize.x &&
+                        mousePos.y >= viewportPos.y && mousePos.y <= viewportPos.y + viewportSize.y;
+
+      if (inViewport && ImGui::IsWindowHovered() && tilemap->tileSize.x > 0 && tilemap->tileSize.y > 0)
+      {
+        // Mys do lokalneho priestoru tilemapy, tam je dlazdica (x, y) stvorec [x, x + 1] * tileSize
+        float mouseNDC_X = ((mousePos.x - viewportPos.x) / viewportSize.x) * 2.0f - 1.0f;
+        float mouseNDC_Y = 1.0f - ((mousePos.y - viewportPos.y) / viewportSize.y) * 2.0f;
+        glm::vec4 local = glm::inverse(mvp) * glm::vec4(mouseNDC_X, mouseNDC_Y, 0.0f, 1.0f);
+        if (local.w != 0.0f)
+          local /= local.w;
+
+        int tileX = (int)std::floor(local.x / tilemap->tileSize.x);
+        int tileY = (int)std::floor(local.y / tilemap->tileSize.y);
+
+        if (ImGui::IsMouseDown(ImGuiMouseButton_Left))
+          tilemap->setTile(tileX, tileY, (Engine::TilemapComponent::Tile)g_TilemapBrushTile);
+
+        // Obrys dlazdice pod kurzorom
+        float x0 = (float)(tileX * tilemap->tileSize.x);
+        float y0 = (float)(tileY * tilemap->tileSize.y);
+        float x1 = x0 + tilemap->tileSize.x;
+        float y1 = y0 + tilemap->tileSize.y;
+        const glm::vec2 corners[4] = {{x0, y0}, {x1, y0}, {x1, y1}, {x0, y1}};
+        ImVec2 screen[4];
+        for (int i = 0; i < 4; i++)
+        {
+          glm::vec4 clip = mvp * glm::vec4(corners[i].x, corners[i].y, 0.0f, 1.0f);
+          if (clip.w != 0.0f)
+            clip /= clip.w;
+          screen[i] = ImVec2(viewportPos.x + (clip.x + 1.0f) * 0.5f * viewportSize.x,
+                             viewportPos.y + (1.0f - clip.y) * 0.5f * viewportSize.y);
+        }
+        ImU32 color = g_TilemapBrushTile == 0 ? IM_COL32(255, 80, 80, 255) : IM_COL32(255, 255, 0, 255);
+        ImGui::GetWindowDrawList()->AddQuad(screen[0], screen[1], screen[2], screen[3], color, 2.0f);
+      }
+    }
+    else if (g_EditColliderMode)
     {
       if (g_EditColliderMode &&
           m_SelectedEntity->hasComponent<Engine::PolygonColliderComponent>())
@@ -614,6 +658,10 @@ void EditorApp::renderViewport()
 
         m_SelectedEntity = nullptr;
 
+        auto &config = m_currentProject->getConfig();
+        m_FixedStep.configure(config.fixedUpdateRate, config.maxSubSteps);
+        currentScene->applyProjectSettings(config);
+
         m_SceneState = SceneState::PLAY;
         Engine::Log::info("Runtime Started: Snapshot saved.");
       }
@@ -0,0 +1,110 @@
+#include "ecs/Entity.h"
+#include "ecs/components/BoxColliderComponent.h"
+#include "ecs/components/TransformComponent.h"
+#include "ecs/systems/NavigationSystem.h"
+#include "scene/Scene.h"
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+// 1000 agentov v bludisku stien: A* cesta pre kazdeho zvlast, potom vsetci k jednemu cielu cez flow field.
+// Meria aj fixny krok s nezmenenymi prekazkami, ten nema nic prepocitavat.
+
+using Clock = std::chrono::steady_clock;
+
+static double Milliseconds(Clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+int main()
+{
+    constexpr int AgentCount = 1000;
+    constexpr int FlowSteps = 60;
+    constexpr float WorldSize = 4096.0f;
+    constexpr float Dt = 1.0f / 60.0f;
+
+    Engine::Scene scene("NavigationBenchmark");
+    auto* navigation = scene.getSystem<Engine::NavigationSystem>();
+    navigation->configure(32.0f, 8.0f);
+
+    // Zvisle steny s medzerami striedavo hore a dole
+    int walls = 0;
+    for (float x = 256.0f; x < WorldSize; x += 256.0f)
+    {
+        for (float y = 0.0f; y < WorldSize; y += 128.0f)
+        {
+            bool gap = ((int)(x / 256.0f) % 2 == 0) ? y < 256.0f : y > WorldSize - 384.0f;
+            if (gap)
+                continue;
+            Engine::Entity* wall = scene.createEntity("Wall");
+            wall->addComponent<Engine::TransformComponent>(glm::vec2(x, y + 64.0f));
+            wall->addComponent<Engine::BoxColliderComponent>(glm::vec2(32.0f, 128.0f), glm::vec2(0.0f, 0.0f), 0.0f, false, true);
+            walls++;
+        }
+    }
+
+    auto start = Clock::now();
+    scene.fixedUpdate(Dt);
+    double bakeMs = Milliseconds(start);
+
+    std::mt19937 random(1234);
+    std::uniform_real_distribution<float> coordinate(0.0f, WorldSize);
+    auto walkablePoint = [&]()
+    {
+        glm::vec2 p;
+        do
+            p = {coordinate(random), coordinate(random)};
+        while (!navigation->isWalkable(p));
+        return p;
+    };
+
+    std::vector<glm::vec2> agents(AgentCount);
+    for (auto& agent : agents)
+        agent = walkablePoint();
+
+    navigation->resetStats();
+    std::vector<glm::vec2> path;
+    int reached = 0;
+    size_t waypoints = 0;
+    start = Clock::now();
+    for (const auto& agent : agents)
+    {
+        if (navigation->findPath(agent, walkablePoint(), path))
+        {
+            reached++;
+            waypoints += path.size();
+        }
+    }
+    double pathMs = Milliseconds(start);
+    int expanded = navigation->getStats().expandedNodes;
+
+    glm::vec2 goal = walkablePoint();
+    navigation->resetStats();
+    start = Clock::now();
+    for (int step = 0; step < FlowSteps; ++step)
+    {
+        for (auto& agent : agents)
+            agent += navigation->getFlowDirection(goal, agent) * 120.0f * Dt;
+    }
+    double flowMs = Milliseconds(start);
+    int flowBuilds = navigation->getStats().flowFieldBuilds;
+
+    navigation->resetStats();
+    start = Clock::now();
+    for (int step = 0; step < FlowSteps; ++step)
+        navigation->onFixedUpdate(Dt);
+    double syncMs = Milliseconds(start);
+
+    std::printf("Grid %dx%d, %d walls, first bake %.2f ms\n", navigation->getGridWidth(), navigation->getGridHeight(), walls,
+                bakeMs);
+    std::printf("findPath: %d agents, %d reached, %.3f ms total, %.1f us per path, %d expanded nodes, %.1f waypoints per path\n",
+                AgentCount, reached, pathMs, pathMs * 1000.0 / AgentCount, expanded,
+                reached ? (double)waypoints / reached : 0.0);
+    std::printf("getFlowDirection: %d agents x %d steps, %.3f ms total, %.3f ms per step, %d flow field builds\n", AgentCount,
+                FlowSteps, flowMs, flowMs / FlowSteps, flowBuilds);
+    std::printf("Obstacle sync: %d unchanged steps, %.3f ms total, %d obstacles gathered again\n", FlowSteps, syncMs,
+                navigation->getStats().changedObstacles);
+    return 0;
+}
@@ -4,10 +4,18 @@
 #include "FileSystem.h"
 #include "FontManager.h"
 #include "Project.h"
+#include <algorithm>
+#include <fstream>
+#include <nlohmann/json.hpp>
 
 namespace Engine {
 
 std::map<std::string, SDL_Texture*> AssetManager::m_Textures;
+std::vector<AssetManager::AtlasPage> AssetManager::s_Pages;
+std::map<std::string, SDL_Rect> AssetManager::s_Regions;
+uint32_t AssetManager::s_AtlasVersion = 1;
+std::unordered_map<SDL_Texture*, uint32_t> AssetManager::s_TextureIds;
+uint32_t AssetManager::s_NextTextureId = 1;
 
 AssetManager::~AssetManager() {
     clearInstanceAssets();
@@ -74,23 +82,192 @@ void AssetManager::loadTexture(const std::string& assetId, const std::string& re
         return;
     }
 
-    SDL_Texture* texture = SDL_CreateTextureFromSurface(m_Renderer, surface);
+    TextureRegion region;
+    if (!packIntoAtlas(surface, region)) {
+        region.texture = SDL_CreateTextureFromSurface(m_Renderer, surface);
+        region.rect = {0, 0, surface->w, surface->h};
+        registerTexture(region.texture);
+    }
     SDL_FreeSurface(surface);
 
-    if (!texture) {
+    if (!region.texture) {
         Log::error("AssetManager: SDL_CreateTextureFromSurface failed for: " + assetId + " | Error: " + SDL_GetError());
         return;
     }
 
     if (m_Textures.count(assetId)) {
-        SDL_DestroyTexture(m_Textures[assetId]);
+        releaseAsset(assetId);
         Log::warn("AssetManager: Overwriting existing texture asset: " + assetId);
     }
 
-    m_Textures[assetId] = texture;
+    m_Textures[assetId] = region.texture;
+    s_Regions[assetId] = region.rect;
+    ++s_AtlasVersion;
     Log::info("AssetManager: Successfully loaded [" + assetId + "] from " + fullPath);
 }
 
+bool AssetManager::packIntoAtlas(SDL_Surface* surface, TextureRegion& out) {
+    if (surface->w > TextureAtlas::MaxPackedSize || surface->h > TextureAtlas::MaxPackedSize) {
+        return false;
+    }
+
+    AtlasRect rect;
+    AtlasPage* target = nullptr;
+    for (auto& page : s_Pages) {
+        if (page.isDynamic && page.packer.insert(surface->w, surface->h, rect)) {
+            target = &page;
+            break;
+        }
+    }
+
+    if (!target) {
+        int size = TextureAtlas::PageSize;
+        SDL_RendererInfo info;
+        if (SDL_GetRendererInfo(m_Renderer, &info) == 0 && info.max_texture_width > 0 && info.max_texture_height > 0) {
+            size = std::min(size, std::min(info.max_texture_width, info.max_texture_height));
+        }
+        if (surface->w > size || surface->h > size) {
+            return false;
+        }
+
+        SDL_Texture* texture = SDL_CreateTexture(m_Renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, size, size);
+        if (!texture) {
+            Log::warn(std::string("AssetManager: Cannot create atlas page, using separate textures | ") + SDL_GetError());
+            return false;
+        }
+        SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+
+        // Obsah novej textury je nedefinovany, medzery medzi obrazkami musia byt priehladne
+        std::vector<Uint32> transparent((size_t)size * size, 0);
+        SDL_UpdateTexture(texture, nullptr, transparent.data(), size * (int)sizeof(Uint32));
+
+        AtlasPage page;
+        page.texture = texture;
+        page.packer = AtlasPacker(size, size, TextureAtlas::Padding);
+        page.isDynamic = true;
+        s_Pages.push_back(page);
+        registerTexture(texture);
+        target = &s_Pages.back();
+        target->packer.insert(surface->w, surface->h, rect);
+        Log::info("AssetManager: Created atlas page " + std::to_string(s_Pages.size()) + " (" + std::to_string(size) + "px)");
+    }
+
+    SDL_Surface* converted = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_ARGB8888, 0);
+    if (!converted) {
+        return false;
+    }
+
+    SDL_Rect dest = {rect.x, rect.y, rect.w, rect.h};
+    SDL_UpdateTexture(target->texture, &dest, converted->pixels, converted->pitch);
+    SDL_FreeSurface(converted);
+
+    out.texture = target->texture;
+    out.rect = dest;
+    return true;
+}
+
+bool AssetManager::isAtlasPage(SDL_Texture* texture) {
+    for (const auto& page : s_Pages) {
+        if (page.texture == texture) return true;
+    }
+    return false;
+}
+
+void AssetManager::releaseTexture(SDL_Texture* texture) {
+    // Stranka atlasu patri vsetkym assetom na nej, zanikne az v clearAssets
+    if (texture && !isAtlasPage(texture)) {
+        s_TextureIds.erase(texture);
+        SDL_DestroyTexture(texture);
+    }
+}
+
+void AssetManager::releaseAsset(const std::string& assetId) {
+    auto it = m_Textures.find(assetId);
+    if (it == m_Textures.end() || !it->second) {
+        return;
+    }
+
+    for (auto& page : s_Pages) {
+        if (page.texture != it->second) continue;
+        // Prebuildovane stranky su plne; z dynamickej sa vrati len miesto tohto assetu
+        auto region = s_Regions.find(assetId);
+        if (page.isDynamic && region != s_Regions.end()) {
+            const SDL_Rect& rect = region->second;
+            // Priehladne, aby mensi obrazok na tomto mieste nemal v okraji stare pixely
+            std::vector<Uint32> transparent((size_t)rect.w * rect.h, 0);
+            SDL_UpdateTexture(page.texture, &rect, transparent.data(), rect.w * (int)sizeof(Uint32));
+            page.packer.release({rect.x, rect.y, rect.w, rect.h});
+        }
+        return;
+    }
+    releaseTexture(it->second);
+}
+
+void AssetManager::registerTexture(SDL_Texture* texture) {
+    if (texture) {
+        s_TextureIds[texture] = s_NextTextureId++;
+    }
+}
+
+uint32_t AssetManager::getTextureId(SDL_Texture* texture) {
+    auto it = s_TextureIds.find(texture);
+    return it != s_TextureIds.end() ? it->second : 0;
+}
+
+bool AssetManager::loadAtlasManifest(const std::filesystem::path& assetsRoot) {
+    std::filesystem::path manifestPath = assetsRoot / TextureAtlas::ManifestFile;
+    if (!std::filesystem::exists(manifestPath)) {
+        return false;
+    }
+    if (!m_Renderer) {
+        Log::error("AssetManager: Cannot load the texture atlas before init().");
+        return false;
+    }
+
+    nlohmann::json manifest;
+    try {
+        std::ifstream file(manifestPath);
+        file >> manifest;
+    } catch (const std::exception& e) {
+        Log::error("AssetManager: Invalid atlas manifest " + manifestPath.string() + " | " + e.what());
+        return false;
+    }
+
+    std::vector<SDL_Texture*> pages;
+    nlohmann::json pageNames = manifest.value("Pages", nlohmann::json::array());
+    for (const auto& name : pageNames) {
+        std::string pagePath = (assetsRoot / name.get<std::string>()).string();
+        SDL_Texture* texture = IMG_LoadTexture(m_Renderer, pagePath.c_str());
+        if (!texture) {
+            Log::error("AssetManager: Cannot load atlas page " + pagePath + " | " + IMG_GetError());
+        } else {
+            SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+            AtlasPage page;
+            page.texture = texture;
+            s_Pages.push_back(page);
+            registerTexture(texture);
+        }
+        pages.push_back(texture);
+    }
+
+    int count = 0;
+    nlohmann::json regions = manifest.value("Regions", nlohmann::json::object());
+    for (const auto& [assetId, region] : regions.items()) {
+        int page = region.value("Page", -1);
+        if (page < 0 || page >= (int)pages.size() || !pages[page]) continue;
+        if (!region.contains("Rect") || !region["Rect"].is_array() || region["Rect"].size() != 4) continue;
+
+        const auto& r = region["Rect"];
+        m_Textures[assetId] = pages[page];
+        s_Regions[assetId] = {r[0].get<int>(), r[1].get<int>(), r[2].get<int>(), r[3].get<int>()};
+        ++count;
+    }
+
+    ++s_AtlasVersion;
+    Log::info("AssetManager: " + std::to_string(count) + " textures on " + std::to_string(pages.size()) + " prebuilt atlas pages.");
+    return true;
+}
+
 SDL_Texture* AssetManager::getTextureInstance(const std::string& assetId) const {
     auto it = m_Textures.find(assetId);
     if (it == m_Textures.end()) {
@@ -105,25 +282,50 @@ SDL_Texture* AssetManager::getTexture(const std::string& assetId) {
     return it != m_Textures.end() ? it->second : nullptr;
 }
 
+bool AssetManager::getTextureRegion(const std::string& assetId, TextureRegion& out) {
+    auto it = m_Textures.find(assetId);
+    if (it == m_Textures.end() || !it->second) {
+        return false;
+    }
+
+    out.texture = it->second;
+    auto region = s_Regions.find(assetId);
+    if (region != s_Regions.end()) {
+        out.rect = region->second;
+    } else {
+        out.rect = {0, 0, 0, 0};
+        SDL_QueryTexture(it->second, nullptr, nullptr, &out.rect.w, &out.rect.h);
+    }
+    return true;
+}
+
 void AssetManager::clearInstanceAssets() {
     clearAssets();
 }
 
 void AssetManager::clearAssets() {
     for (auto& [id, tex] : m_Textures) {
-        if (tex) SDL_DestroyTexture(tex);
+        releaseTexture(tex);
+    }
+    for (auto& page : s_Pages) {
+        SDL_DestroyTexture(page.texture);
     }
     m_Textures.clear();
+    s_Regions.clear();
+    s_Pages.clear();
+    s_TextureIds.clear();
+    s_NextTextureId = 1;
+    ++s_AtlasVersion;
     Log::info("AssetManager: All textures cleared.");
 }
 
 void AssetManager::removeTexture(const std::string& assetId) {
     auto it = m_Textures.find(assetId);
     if (it != m_Textures.end()) {
-        if (it->second) {
-            SDL_DestroyTexture(it->second);
-        }
+        releaseAsset(assetId);
         m_Textures.erase(it);
+        s_Regions.erase(assetId);
+        ++s_AtlasVersion;
         Log::info("Removed texture: " + assetId);
     } else {
         Log::warn("Cannot remove texture. Not found: " + assetId);
@@ -137,10 +339,17 @@ void AssetManager::renameTexture(const std::string& oldId, const std::string& ne
     if (it != m_Textures.end()) {
         if (m_Textures.count(newId)) {
             Log::warn("Rename target ID already exists, overwriting: " + newId);
-            SDL_DestroyTexture(m_Textures[newId]);
+            releaseAsset(newId);
         }
         m_Textures[newId] = it->second;
         m_Textures.erase(it);
+
+        auto region = s_Regions.find(oldId);
+        if (region != s_Regions.end()) {
+            s_Regions[newId] = region->second;
+            s_Regions.erase(oldId);
+        }
+        ++s_AtlasVersion;
         Log::info("Renamed texture '" + oldId + "' -> '" + newId + "'");
     } else {
         Log::warn("Cannot rename texture. Old ID not found: " + oldId);
@@ -5,6 +5,9 @@
 #include <map>
 #include "Font.h"
 #include "Project.h"
+#include "TextureAtlas.h"
+#include <cstdint>
+#include <filesystem>
 #include <unordered_map>
 #include <vector>
 #include <string>
@@ -12,17 +15,47 @@
 namespace Engine
 {
 
+    /** @brief Where an asset's pixels are: the texture holding them and the rect inside it. */
+    struct TextureRegion
+    {
+        SDL_Texture *texture = nullptr;
+        SDL_Rect rect = {0, 0, 0, 0};
+    };
+
     /**
      * @brief Manages the loading, storage, and retrieval of textures.
      * Integrates with the FileSystem to resolve project-relative paths.
+     * Images share atlas pages: exported games load the pages packed at build time,
+     * anything else (editor, unpacked projects) is packed into dynamic pages on load.
+     * Images too large for a page keep their own texture.
      */
     class AssetManager
     {
     private:
         SDL_Renderer *m_Renderer = nullptr;
 
+        struct AtlasPage
+        {
+            SDL_Texture *texture = nullptr;
+            AtlasPacker packer;
+            bool isDynamic = false; // build-time pages are full, nothing is added to them
+        };
+
+        static std::vector<AtlasPage> s_Pages;
+        static std::map<std::string, SDL_Rect> s_Regions;
+        static uint32_t s_AtlasVersion;
+        static std::unordered_map<SDL_Texture *, uint32_t> s_TextureIds;
+        static uint32_t s_NextTextureId;
+
+        bool packIntoAtlas(SDL_Surface *surface, TextureRegion &out);
+        static bool isAtlasPage(SDL_Texture *texture);
+        static void releaseTexture(SDL_Texture *texture);
+        static void releaseAsset(const std::string &assetId);
+        static void registerTexture(SDL_Texture *texture);
+
     public:
         // Static map to allow global access to textures (Shared across scenes)
+        // Atlased assets map to their page, the rect inside it comes from getTextureRegion
         static std::map<std::string, SDL_Texture *> m_Textures;
         std::unordered_map<std::string, std::shared_ptr<Engine::Font>> m_Fonts;
 
@@ -44,6 +77,25 @@ namespace Engine
         std::shared_ptr<Font> loadFontIfMissing(const std::string &assetId, const std::string &path, const int size, Project *project);
         SDL_Texture *getTextureInstance(const std::string &assetId) const;
         static SDL_Texture *getTexture(const std::string &assetId);
+
+        /** @brief Texture and pixel rect of an asset. False if the asset is not loaded. */
+        static bool getTextureRegion(const std::string &assetId, TextureRegion &out);
+
+        /** @brief Changes whenever a region moves (load, reload, remove, rename), cached regions compare against it. */
+        static uint32_t getAtlasVersion() { return s_AtlasVersion; }
+
+        /**
+         * @brief Load-order ID of a page or standalone texture, from 1; 0 if the texture is not owned here.
+         * Unlike the pointer it does not depend on where the driver allocated the texture, so it is the same
+         * every run that loads the same assets in the same order.
+         */
+        static uint32_t getTextureId(SDL_Texture *texture);
+
+        /**
+         * @brief Registers the atlas pages packed by the build (TextureAtlas::ManifestFile in assetsRoot).
+         * @return false if the project has no manifest, its images are then loaded one by one as usual
+         */
+        bool loadAtlasManifest(const std::filesystem::path &assetsRoot);
         std::shared_ptr<Engine::Font> getFont(const std::string &assetId)
         {
             auto it = m_Fonts.find(assetId);
@@ -26,4 +26,26 @@ void Camera::recalculateProjectionMatrix() {
     m_ViewProjectionMatrix = m_ProjectionMatrix * m_ViewMatrix;
 }
 
+void Camera::getWorldBounds(glm::vec2& min, glm::vec2& max) const {
+    glm::mat4 inverse = glm::inverse(m_ViewProjectionMatrix);
+    const glm::vec2 corners[4] = {{-1.0f, -1.0f}, {1.0f, -1.0f}, {1.0f, 1.0f}, {-1.0f, 1.0f}};
+
+    min = glm::vec2(inverse * glm::vec4(corners[0], 0.0f, 1.0f));
+    max = min;
+    for (int i = 1; i < 4; ++i) {
+        glm::vec2 world = glm::vec2(inverse * glm::vec4(corners[i], 0.0f, 1.0f));
+        min = glm::min(min, world);
+        max = glm::max(max, world);
+    }
+}
+
+Affine2D Camera::getWorldToScreen(float targetWidth, float targetHeight) const {
+    // NDC [-1, 1] na pixely ciela, os y sa otoci
+    Affine2D viewport;
+    viewport.x = {targetWidth * 0.5f, 0.0f};
+    viewport.y = {0.0f, -targetHeight * 0.5f};
+    viewport.origin = {targetWidth * 0.5f, targetHeight * 0.5f};
+    return viewport * Affine2D::FromMat4(m_ViewProjectionMatrix);
+}
+
 } // namespace Engine
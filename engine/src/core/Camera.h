@@ -1,5 +1,6 @@
 #pragma once
 
+#include "core/Transform2D.h"
 #include <glm/glm.hpp>
 
 namespace Engine {
@@ -29,6 +30,12 @@ public:
     const glm::mat4& getViewMatrix() const { return m_ViewMatrix; }
     const glm::mat4& getViewProjectionMatrix() const { return m_ViewProjectionMatrix; }
 
+    // World-space AABB of everything the camera sees (of its rotated rect when rotated)
+    void getWorldBounds(glm::vec2& min, glm::vec2& max) const;
+
+    // World -> pixels of a targetWidth x targetHeight target (y down), compose once per frame
+    Affine2D getWorldToScreen(float targetWidth, float targetHeight) const;
+
 private:
     void recalculateViewMatrix();
     void recalculateProjectionMatrix();
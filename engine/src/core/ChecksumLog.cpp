@@ -0,0 +1,76 @@
+#include "ChecksumLog.h"
+#include "Log.h"
+#include <iomanip>
+#include <sstream>
+
+namespace Engine {
+
+    bool ChecksumLog::startRecording(const std::string& path) {
+        stop();
+        m_Out.open(path, std::ios::trunc);
+        if (!m_Out.is_open()) {
+            Log::error("ChecksumLog: cannot write " + path);
+            return false;
+        }
+        m_Mode = Mode::Record;
+        Log::info("ChecksumLog: recording step checksums to " + path);
+        return true;
+    }
+
+    bool ChecksumLog::startVerifying(const std::string& path) {
+        stop();
+        m_In.open(path);
+        if (!m_In.is_open()) {
+            Log::error("ChecksumLog: cannot read " + path);
+            return false;
+        }
+        m_Mode = Mode::Verify;
+        Log::info("ChecksumLog: verifying step checksums against " + path);
+        return true;
+    }
+
+    void ChecksumLog::stop() {
+        if (m_Out.is_open()) m_Out.close();
+        if (m_In.is_open()) m_In.close();
+        m_Mode = Mode::Off;
+        m_Entry = 0;
+        m_Diverged = false;
+        m_DivergedEntry = 0;
+    }
+
+    bool ChecksumLog::submit(uint64_t step, uint64_t checksum) {
+        uint64_t entry = m_Entry++;
+
+        if (m_Mode == Mode::Record) {
+            m_Out << step << ' ' << std::hex << std::setw(16) << std::setfill('0') << checksum << std::dec << '\n';
+            return true;
+        }
+
+        if (m_Mode != Mode::Verify || m_Diverged) {
+            return !m_Diverged;
+        }
+
+        std::string line;
+        if (!std::getline(m_In, line)) {
+            Log::warn("ChecksumLog: reference ended after " + std::to_string(entry) + " steps, nothing left to compare");
+            m_Mode = Mode::Off;
+            return true;
+        }
+
+        std::istringstream ss(line);
+        uint64_t refStep = 0;
+        uint64_t refChecksum = 0;
+        ss >> refStep >> std::hex >> refChecksum;
+
+        if (!ss || refStep != step || refChecksum != checksum) {
+            m_Diverged = true;
+            m_DivergedEntry = entry;
+            std::ostringstream msg;
+            msg << "ChecksumLog: simulation diverged at entry " << entry << " (step " << step << "): expected '"
+                << line << "', got '" << step << ' ' << std::hex << std::setw(16) << std::setfill('0') << checksum << "'";
+            Log::error(msg.str());
+            return false;
+        }
+        return true;
+    }
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+namespace Engine {
+
+    /**
+     * @brief Zaznam checksumov simulacie krok po kroku, na porovnanie dvoch behov.
+     * * Record zapise do suboru riadok "krok checksum" po kazdom fixnom kroku, Verify taky subor cita
+     * a ohlasi prvy krok, v ktorom sa aktualny beh rozisiel s referencnym. Checksumy pochadzaju
+     * zo Scene::computeStateChecksum, zmysel maju hlavne v deterministickom rezime sceny.
+     */
+    class ChecksumLog {
+    public:
+        enum class Mode { Off, Record, Verify };
+
+        bool startRecording(const std::string& path);
+        bool startVerifying(const std::string& path);
+        void stop();
+
+        /**
+         * @brief Zapise, alebo porovna s referenciou, checksum jedneho kroku.
+         * @return false pri nezhode. Zaloguje sa len prva, dalsie kroky uz nic nehovoria.
+         */
+        bool submit(uint64_t step, uint64_t checksum);
+
+        Mode getMode() const { return m_Mode; }
+        bool hasDiverged() const { return m_Diverged; }
+        // Poradove cislo zaznamu (od 0), pri ktorom sa behy rozisli
+        uint64_t getDivergedEntry() const { return m_DivergedEntry; }
+
+    private:
+        Mode m_Mode = Mode::Off;
+        std::ofstream m_Out;
+        std::ifstream m_In;
+        uint64_t m_Entry = 0;
+        bool m_Diverged = false;
+        uint64_t m_DivergedEntry = 0;
+    };
+}
@@ -0,0 +1,34 @@
+#include "FixedTimestep.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Engine {
+    // dlhsi frame (breakpoint, nacitanie sceny) sa berie ako tento cas
+    static constexpr float maxFrameTime = 0.25f;
+
+    FixedTimestep::FixedTimestep(int updateRate, int maxSubSteps) {
+        configure(updateRate, maxSubSteps);
+    }
+
+    void FixedTimestep::configure(int updateRate, int maxSubSteps) {
+        m_Step = 1.0f / static_cast<float>(std::max(updateRate, 1));
+        m_MaxSubSteps = std::max(maxSubSteps, 1);
+    }
+
+    int FixedTimestep::advance(float frameDt) {
+        m_Accumulator += std::clamp(frameDt, 0.0f, maxFrameTime);
+
+        int steps = static_cast<int>(m_Accumulator / m_Step);
+        if (steps > m_MaxSubSteps) {
+            steps = m_MaxSubSteps;
+        }
+        m_Accumulator -= static_cast<float>(steps) * m_Step;
+
+        // nestihli sme - zvysok zahodime, nechame si len cast kroku pre interpolaciu
+        if (m_Accumulator >= m_Step) {
+            m_Accumulator = std::fmod(m_Accumulator, m_Step);
+        }
+
+        return steps;
+    }
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+namespace Engine {
+
+    /**
+     * @brief Akumulator pre simulaciu s fixnym krokom.
+     * * Kazdy frame sa prida realny deltaTime a advance() vrati kolko fixnych krokov treba spustit.
+     * Zvysok akumulatora (alpha) pouziva renderer na interpolaciu medzi poslednymi dvoma krokmi.
+     */
+    class FixedTimestep {
+    public:
+        FixedTimestep(int updateRate = 60, int maxSubSteps = 5);
+
+        void configure(int updateRate, int maxSubSteps);
+
+        /**
+         * @brief Prida cas frame-u do akumulatora.
+         * @return Pocet fixnych krokov (najviac maxSubSteps). Cas navyse sa zahodi, aby sa pomaly
+         * frame nezacal nabalovat dalsie a dalsie kroky (spiral of death).
+         */
+        int advance(float frameDt);
+
+        void reset() { m_Accumulator = 0.0f; }
+
+        float getStep() const { return m_Step; }
+        int getMaxSubSteps() const { return m_MaxSubSteps; }
+        // 0..1, kolko z dalsieho kroku uz ubehlo
+        float getAlpha() const { return m_Accumulator / m_Step; }
+
+    private:
+        float m_Step = 1.0f / 60.0f;
+        int m_MaxSubSteps = 5;
+        float m_Accumulator = 0.0f;
+    };
+}
@@ -7,6 +7,8 @@ namespace Engine {
 Font::Font(const std::string& path, int size)
     : m_Path(path), m_Size(size)
 {
+    static uint32_t nextId = 1;
+    m_Id = nextId++;
     m_Font = TTF_OpenFont(path.c_str(), size);
 
     if (!m_Font)
@@ -1,6 +1,7 @@
 #pragma once
 #pragma once
 #include <SDL2/SDL_ttf.h>
+#include <cstdint>
 #include <string>
 
 namespace Engine {
@@ -13,12 +14,15 @@ public:
     TTF_Font* get() const { return m_Font; }
     const std::string& getPath() const { return m_Path; }
     int getSize() const { return m_Size; }
+    // Jedinecne pre kazdu instanciu, adresa sa po uvolneni fontu moze opakovat
+    uint32_t getId() const { return m_Id; }
 
     bool isValid() const { return m_Font != nullptr; }
 
 private:
     std::string m_Path;
     int m_Size = 0;
+    uint32_t m_Id = 0;
     TTF_Font* m_Font = nullptr;
 };
 
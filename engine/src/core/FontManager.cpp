@@ -5,7 +5,9 @@
 #include "Log.h"
 namespace Engine {
 
-std::unordered_map<std::string, std::shared_ptr<Font>> FontManager::s_Cache;
+std::unordered_map<std::string, FontManager::Entry> FontManager::s_Cache;
+uint64_t FontManager::s_Clock = 0;
+FontCacheStats FontManager::s_Stats = {0, FontManager::DefaultBudget};
 
 void FontManager::Init() {
     // Nothing to do for now
@@ -13,6 +15,8 @@ void FontManager::Init() {
 
 void FontManager::Shutdown() {
     s_Cache.clear();
+    s_Stats.bytes = 0;
+    s_Stats.fonts = 0;
 }
 
 std::shared_ptr<Font> FontManager::LoadFont(const std::string& path, int size, Project* project) {
@@ -30,8 +34,11 @@ std::shared_ptr<Font> FontManager::LoadFont(const std::string& path, int size, P
     // 2. Check Cache
     auto it = s_Cache.find(key);
     if (it != s_Cache.end()) {
-        return it->second;
+        it->second.lastUsed = ++s_Clock;
+        s_Stats.hits++;
+        return it->second.font;
     }
+    s_Stats.misses++;
 
     std::shared_ptr<Font> font = std::make_shared<Font>(realPath, size);
 
@@ -39,9 +46,39 @@ std::shared_ptr<Font> FontManager::LoadFont(const std::string& path, int size, P
         return nullptr;
     }
 
-    s_Cache[key] = font;
+    // TTF drzi subor fontu v pamati, jeho velkost je dobry odhad
+    std::error_code error;
+    uintmax_t fileSize = std::filesystem::file_size(fullPath, error);
+    Entry& entry = s_Cache[key];
+    entry.font = font;
+    entry.bytes = error ? 0 : (size_t)fileSize;
+    entry.lastUsed = ++s_Clock;
+    s_Stats.bytes += entry.bytes;
+    s_Stats.fonts = (int)s_Cache.size();
+
+    Trim();
     return font;
 }
 
+void FontManager::Trim() {
+    while (s_Stats.bytes > s_Stats.budget) {
+        // Fontov je malo, linearne hladanie najstarsieho staci
+        auto oldest = s_Cache.end();
+        for (auto it = s_Cache.begin(); it != s_Cache.end(); ++it) {
+            if (it->second.font.use_count() > 1)
+                continue;
+            if (oldest == s_Cache.end() || it->second.lastUsed < oldest->second.lastUsed)
+                oldest = it;
+        }
+        if (oldest == s_Cache.end())
+            break;
+
+        s_Stats.bytes -= oldest->second.bytes;
+        s_Stats.evictions++;
+        s_Cache.erase(oldest);
+    }
+    s_Stats.fonts = (int)s_Cache.size();
+}
+
 }
 
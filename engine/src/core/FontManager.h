@@ -1,4 +1,6 @@
 #pragma once
+#include <cstddef>
+#include <cstdint>
 #include <unordered_map>
 #include <memory>
 #include <string>
@@ -8,17 +10,43 @@ namespace Engine {
 
 class Project; // forward declare
 
+/** @brief Font cache state; hits, misses and evictions count since startup. */
+struct FontCacheStats {
+    size_t bytes = 0; // font files of the cached fonts, a rough estimate of what TTF keeps in memory
+    size_t budget = 0;
+    int fonts = 0;
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+};
+
 class FontManager {
 public:
+    static constexpr size_t DefaultBudget = 32 * 1024 * 1024;
+
     static void Init();
     static void Shutdown();
 
     // Loads a font or returns it from the cache if already loaded
     static std::shared_ptr<Font> LoadFont(const std::string& path, int size, Project* project);
 
+    // Over budget, frees the least recently loaded fonts nobody else holds; fonts in use always stay
+    static void Trim();
+
+    static void SetBudget(size_t bytes) { s_Stats.budget = bytes; }
+    static const FontCacheStats& GetStats() { return s_Stats; }
+
 private:
+    struct Entry {
+        std::shared_ptr<Font> font;
+        size_t bytes = 0;
+        uint64_t lastUsed = 0;
+    };
+
     // key = path + size to differentiate fonts with same path but different sizes
-    static std::unordered_map<std::string, std::shared_ptr<Font>> s_Cache;
+    static std::unordered_map<std::string, Entry> s_Cache;
+    static uint64_t s_Clock;
+    static FontCacheStats s_Stats;
 };
 
 }
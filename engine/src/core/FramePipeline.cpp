@@ -0,0 +1,134 @@
+#include "FramePipeline.h"
+#include "Log.h"
+
+namespace Engine {
+
+    FramePipeline::~FramePipeline()
+    {
+        shutdown();
+    }
+
+    void FramePipeline::setThreaded(bool threaded)
+    {
+        if (threaded == m_Threaded)
+            return;
+
+        discardPending();
+        if (!threaded)
+        {
+            shutdown();
+            return;
+        }
+
+        m_Stopping = false;
+        m_Worker = std::thread(&FramePipeline::workerLoop, this);
+        m_Threaded = true;
+        Log::info("FramePipeline: simulation runs on a worker thread, rendering is one frame behind");
+    }
+
+    void FramePipeline::shutdown()
+    {
+        if (!m_Threaded)
+            return;
+
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_Stopping = true;
+        }
+        m_WakeCv.notify_one();
+        if (m_Worker.joinable())
+            m_Worker.join();
+
+        m_Threaded = false;
+        discardPending();
+    }
+
+    void FramePipeline::workerLoop()
+    {
+        std::unique_lock<std::mutex> lock(m_Mutex);
+        for (;;)
+        {
+            m_WakeCv.wait(lock, [this]
+                          { return m_Stopping || m_Job; });
+            if (m_Stopping)
+                return;
+
+            const SimulateFn* job = m_Job;
+            lock.unlock();
+
+            std::exception_ptr error;
+            try
+            {
+                (*job)();
+            }
+            catch (...)
+            {
+                error = std::current_exception();
+            }
+
+            lock.lock();
+            m_Job = nullptr;
+            m_JobError = error;
+            m_JobDone = true;
+            m_DoneCv.notify_one();
+        }
+    }
+
+    void FramePipeline::simulate(const SimulateFn& simulate, const PresentFn& present)
+    {
+        if (!m_Threaded)
+        {
+            simulate();
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_Job = &simulate;
+            m_JobDone = false;
+            m_JobError = nullptr;
+        }
+        m_WakeCv.notify_one();
+
+        // Kym worker simuluje, tento thread kresli a caka na VSync
+        if (m_HasPending)
+        {
+            present(m_Frames[1 - m_RecordIndex]);
+            m_HasPending = false;
+        }
+
+        std::exception_ptr error;
+        {
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            m_DoneCv.wait(lock, [this]
+                          { return m_JobDone; });
+            error = m_JobError;
+            m_JobError = nullptr;
+        }
+        if (error)
+            std::rethrow_exception(error);
+    }
+
+    void FramePipeline::endFrame(const PresentFn& present)
+    {
+        if (!m_Threaded)
+        {
+            present(m_Frames[m_RecordIndex]);
+            return;
+        }
+
+        // Zaznamenany frame caka na dalsi simulate(), nahravat sa bude do druheho
+        m_RecordIndex = 1 - m_RecordIndex;
+        m_HasPending = true;
+    }
+
+    void FramePipeline::discardPending()
+    {
+        m_HasPending = false;
+        for (auto& frame : m_Frames)
+        {
+            frame.queue.begin();
+            frame.hasScene = false;
+        }
+    }
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "core/RenderQueue.h"
+#include "scene/Scene.h"
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace Engine {
+
+    /**
+     * @brief Overlaps the simulation of frame N+1 with presenting frame N.
+     *
+     * SDL renderer calls have to stay on the thread that created the window and renderer, so instead of moving
+     * the renderer away the simulation step runs on a worker thread, while the calling thread submits the
+     * RenderQueue recorded last frame and blocks in SDL_RenderPresent. Recording happens back on the calling
+     * thread once the worker is done, so scene state is never read and written at the same time and text
+     * textures are still created on the renderer's thread.
+     *
+     * Two frames are kept: one being recorded and one waiting for presentation. With threading off the same
+     * calls run in order on the calling thread and each frame is presented right after it is recorded.
+     */
+    class FramePipeline {
+    public:
+        /** @brief Everything needed to draw one frame without touching the scene. */
+        struct Frame {
+            RenderQueue queue;
+            BackgroundSettings background;
+            bool hasScene = false;
+            float width = 0.0f;
+            float height = 0.0f;
+        };
+
+        using SimulateFn = std::function<void()>;
+        using PresentFn = std::function<void(Frame& frame)>;
+
+        FramePipeline() = default;
+        ~FramePipeline();
+
+        FramePipeline(const FramePipeline&) = delete;
+        FramePipeline& operator=(const FramePipeline&) = delete;
+
+        /** @brief Starts or stops the worker thread; the frame waiting for presentation is dropped. */
+        void setThreaded(bool threaded);
+        bool isThreaded() const { return m_Threaded; }
+
+        /**
+         * @brief Runs simulate and blocks until it is done.
+         * Threaded: simulate runs on the worker and present() draws the pending frame on this thread meanwhile.
+         * Exceptions thrown by simulate are rethrown here.
+         */
+        void simulate(const SimulateFn& simulate, const PresentFn& present);
+
+        /** @brief Frame to record into between simulate() and endFrame(). */
+        Frame& getRecordFrame() { return m_Frames[m_RecordIndex]; }
+
+        /** @brief Single-threaded: presents the recorded frame now. Threaded: queues it for the next simulate(). */
+        void endFrame(const PresentFn& present);
+
+        /** @brief Drops the frame waiting for presentation, e.g. before a scene load frees the textures it uses. */
+        void discardPending();
+
+        /** @brief Stops the worker; the scene may be destroyed afterwards. */
+        void shutdown();
+
+    private:
+        void workerLoop();
+
+        Frame m_Frames[2];
+        int m_RecordIndex = 0;
+        bool m_HasPending = false;
+        bool m_Threaded = false;
+
+        std::thread m_Worker;
+        std::mutex m_Mutex;
+        std::condition_variable m_WakeCv;
+        std::condition_variable m_DoneCv;
+        const SimulateFn* m_Job = nullptr;
+        bool m_JobDone = false;
+        bool m_Stopping = false;
+        std::exception_ptr m_JobError;
+    };
+}
@@ -0,0 +1,207 @@
+#include "GlyphAtlas.h"
+#include "core/Font.h"
+#include "core/Log.h"
+#include <algorithm>
+
+namespace Engine {
+
+    uint32_t GlyphAtlas::DecodeUtf8(const std::string& text, size_t& i)
+    {
+        unsigned char lead = (unsigned char)text[i];
+        int length = lead < 0x80 ? 1 : (lead >> 5) == 0x6 ? 2 : (lead >> 4) == 0xE ? 3 : (lead >> 3) == 0x1E ? 4 : 0;
+        if (length == 0 || i + length > text.size())
+        {
+            ++i;
+            return 0xFFFD;
+        }
+
+        uint32_t codepoint = length == 1 ? lead : lead & (0x7F >> length);
+        for (int k = 1; k < length; ++k)
+        {
+            unsigned char next = (unsigned char)text[i + k];
+            if ((next & 0xC0) != 0x80)
+            {
+                ++i;
+                return 0xFFFD;
+            }
+            codepoint = (codepoint << 6) | (next & 0x3F);
+        }
+
+        // Pridlhy zapis, surrogaty a nad U+10FFFF nie su platne znaky
+        static constexpr uint32_t minimum[5] = {0, 0, 0x80, 0x800, 0x10000};
+        if (codepoint < minimum[length] || (codepoint >= 0xD800 && codepoint <= 0xDFFF) || codepoint > 0x10FFFF)
+        {
+            ++i;
+            return 0xFFFD;
+        }
+        i += length;
+        return codepoint;
+    }
+
+    GlyphAtlas::~GlyphAtlas()
+    {
+        clear();
+    }
+
+    void GlyphAtlas::clear()
+    {
+        for (Page& page : m_Pages)
+            SDL_DestroyTexture(page.texture);
+        m_Pages.clear();
+        m_Glyphs.clear();
+        m_Full = false;
+        m_Generation++;
+        m_Stats.pages = 0;
+        m_Stats.glyphs = 0;
+    }
+
+    void GlyphAtlas::beginFrame()
+    {
+        if (!m_Full)
+            return;
+        Log::info("GlyphAtlas: pages full, rasterizing glyphs again");
+        clear();
+    }
+
+    bool GlyphAtlas::layout(SDL_Renderer* renderer, const Font& font, const std::string& text, std::vector<Quad>& out,
+                            int& width, int& height)
+    {
+        out.clear();
+        width = 0;
+        height = 0;
+        TTF_Font* ttf = font.get();
+        if (!renderer || !ttf)
+            return false;
+
+        int lineSkip = TTF_FontLineSkip(ttf);
+        int lineY = 0;
+        int penX = 0;
+        int minX = 0;
+        int maxX = 0;
+        uint32_t previous = 0;
+
+        size_t i = 0;
+        while (i < text.size())
+        {
+            uint32_t codepoint = DecodeUtf8(text, i);
+            if (codepoint == '\n')
+            {
+                penX = 0;
+                lineY += lineSkip;
+                previous = 0;
+                continue;
+            }
+            if (codepoint < 0x20)
+                continue;
+
+            if (previous)
+                penX += TTF_GetFontKerningSizeGlyphs32(ttf, previous, codepoint);
+            previous = codepoint;
+
+            const Glyph& glyph = getGlyph(renderer, font, codepoint);
+            int left = penX + glyph.offsetX;
+            if (glyph.texture)
+                out.push_back({glyph.texture, glyph.rect, {left, lineY, glyph.rect.w, glyph.rect.h}});
+            minX = std::min(minX, left);
+            maxX = std::max({maxX, left + glyph.rect.w, penX + glyph.advance});
+            penX += glyph.advance;
+        }
+
+        // Ako TTF_SizeUTF8: box zacina najlavejsim pixelom, nie perom
+        if (minX < 0)
+        {
+            for (Quad& quad : out)
+                quad.dest.x -= minX;
+        }
+        width = maxX - minX;
+        height = lineY + TTF_FontHeight(ttf);
+        return true;
+    }
+
+    const GlyphAtlas::Glyph& GlyphAtlas::getGlyph(SDL_Renderer* renderer, const Font& font, uint32_t codepoint)
+    {
+        uint64_t key = GlyphKey(font.getId(), codepoint);
+        auto it = m_Glyphs.find(key);
+        if (it != m_Glyphs.end())
+            return it->second;
+
+        Glyph glyph;
+        int minX = 0, maxX = 0, minY = 0, maxY = 0, advance = 0;
+        if (TTF_GlyphMetrics32(font.get(), codepoint, &minX, &maxX, &minY, &maxY, &advance) == 0)
+        {
+            glyph.advance = advance;
+            glyph.offsetX = std::min(0, minX);
+        }
+
+        // Medzery nemaju pixely, staci posun pera
+        if (maxX > minX && !m_Full)
+        {
+            SDL_Surface* surface = TTF_RenderGlyph32_Blended(font.get(), codepoint, {255, 255, 255, 255});
+            if (surface)
+            {
+                if (place(renderer, surface, glyph))
+                    m_Stats.uploads++;
+                SDL_FreeSurface(surface);
+            }
+        }
+        const Glyph& stored = m_Glyphs.emplace(key, glyph).first->second;
+        m_Stats.glyphs = (int)m_Glyphs.size();
+        return stored;
+    }
+
+    bool GlyphAtlas::place(SDL_Renderer* renderer, SDL_Surface* surface, Glyph& glyph)
+    {
+        AtlasRect rect;
+        Page* target = nullptr;
+        for (Page& page : m_Pages)
+        {
+            if (page.packer.insert(surface->w, surface->h, rect))
+            {
+                target = &page;
+                break;
+            }
+        }
+
+        if (!target)
+        {
+            if ((int)m_Pages.size() >= MaxPages || surface->w > PageSize || surface->h > PageSize)
+            {
+                m_Full = true;
+                return false;
+            }
+
+            SDL_Texture* texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC,
+                                                     PageSize, PageSize);
+            if (!texture)
+            {
+                Log::warn(std::string("GlyphAtlas: Cannot create page | ") + SDL_GetError());
+                m_Full = true;
+                return false;
+            }
+            SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+
+            // Obsah novej textury je nedefinovany, okraje glyphov musia byt priehladne
+            std::vector<Uint32> transparent((size_t)PageSize * PageSize, 0);
+            SDL_UpdateTexture(texture, nullptr, transparent.data(), PageSize * (int)sizeof(Uint32));
+
+            Page page;
+            page.texture = texture;
+            page.packer = AtlasPacker(PageSize, PageSize, TextureAtlas::Padding);
+            m_Pages.push_back(page);
+            m_Stats.pages = (int)m_Pages.size();
+            target = &m_Pages.back();
+            if (!target->packer.insert(surface->w, surface->h, rect))
+                return false;
+        }
+
+        SDL_Surface* converted = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_ARGB8888, 0);
+        if (!converted)
+            return false;
+
+        glyph.rect = {rect.x, rect.y, rect.w, rect.h};
+        SDL_UpdateTexture(target->texture, &glyph.rect, converted->pixels, converted->pitch);
+        SDL_FreeSurface(converted);
+        glyph.texture = target->texture;
+        return true;
+    }
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "core/TextureAtlas.h"
+#include <SDL2/SDL.h>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Engine {
+
+    class Font;
+
+    /**
+     * @brief Glyphs of all fonts rasterized once per (font, size) into shared atlas pages.
+     *
+     * layout() turns a UTF-8 string into glyph quads relative to the text's top left corner, so text that
+     * changes every frame (scores, timers) costs a layout pass; only glyphs seen for the first time are
+     * rasterized and uploaded. Glyphs are rendered white, the text color goes into the vertex color.
+     * When the pages run full, glyphs that do not fit are left out and the next beginFrame() starts over,
+     * bumping getGeneration(); layouts built against an older generation have to be laid out again.
+     */
+    class GlyphAtlas {
+    public:
+        static constexpr int PageSize = 1024;
+        static constexpr int MaxPages = 4;
+
+        /** @brief One glyph of a laid out text, dest in text pixels from its top left corner. */
+        struct Quad {
+            SDL_Texture* texture;
+            SDL_Rect src;
+            SDL_Rect dest;
+        };
+
+        struct Stats {
+            int pages = 0;
+            int glyphs = 0;  // glyphs in the pages
+            int uploads = 0; // glyphs rasterized since resetStats()
+        };
+
+        GlyphAtlas() = default;
+        ~GlyphAtlas();
+
+        GlyphAtlas(const GlyphAtlas&) = delete;
+        GlyphAtlas& operator=(const GlyphAtlas&) = delete;
+
+        /**
+         * @brief Lays text out in font; '\n' starts a new line.
+         * @param width, height size of the text box, as TTF_SizeUTF8 reports it for a single line
+         * @return false if the font is not usable; glyphs the pages cannot take are left out
+         */
+        bool layout(SDL_Renderer* renderer, const Font& font, const std::string& text, std::vector<Quad>& out,
+                    int& width, int& height);
+
+        /**
+         * @brief Reads the code point at byte i and moves i past it. An invalid, overlong or truncated
+         * sequence, a surrogate or a value above U+10FFFF yields U+FFFD and moves i by one byte.
+         */
+        static uint32_t DecodeUtf8(const std::string& text, size_t& i);
+
+        uint32_t getGeneration() const { return m_Generation; }
+
+        /** @brief Starts over if the pages ran full; call before the first layout of a frame. */
+        void beginFrame();
+
+        /** @brief Frees every page; existing layouts become stale. */
+        void clear();
+
+        const Stats& getStats() const { return m_Stats; }
+        void resetStats() { m_Stats.uploads = 0; }
+
+    private:
+        struct Glyph {
+            SDL_Texture* texture = nullptr; // null for glyphs without pixels (space) or that did not fit
+            SDL_Rect rect = {0, 0, 0, 0};
+            int offsetX = 0; // left edge of the bitmap relative to the pen
+            int advance = 0;
+        };
+
+        struct Page {
+            SDL_Texture* texture = nullptr;
+            AtlasPacker packer;
+        };
+
+        const Glyph& getGlyph(SDL_Renderer* renderer, const Font& font, uint32_t codepoint);
+        bool place(SDL_Renderer* renderer, SDL_Surface* surface, Glyph& glyph);
+
+        static uint64_t GlyphKey(uint32_t fontId, uint32_t codepoint)
+        {
+            return ((uint64_t)fontId << 32) | codepoint;
+        }
+
+        std::unordered_map<uint64_t, Glyph> m_Glyphs;
+        std::vector<Page> m_Pages;
+        uint32_t m_Generation = 1;
+        bool m_Full = false; // a glyph did not fit, beginFrame() clears the pages
+
+        Stats m_Stats;
+    };
+}
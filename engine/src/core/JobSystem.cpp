@@ -0,0 +1,130 @@
+#include "JobSystem.h"
+#include "Log.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Engine {
+
+    namespace {
+        std::vector<std::thread> s_Workers;
+        std::mutex s_Mutex;
+        std::condition_variable s_WakeCv;
+        std::condition_variable s_DoneCv;
+
+        const JobSystem::RangeFn* s_Job = nullptr;
+        size_t s_Count = 0;
+        size_t s_Grain = 1;
+        std::atomic<size_t> s_Next{0};
+
+        uint64_t s_Generation = 0;
+        unsigned s_Pending = 0;
+        bool s_Stopping = false;
+        bool s_Initialized = false;
+        std::atomic<bool> s_Busy{false};
+    }
+
+    void JobSystem::init(unsigned workerCount) {
+        if (s_Initialized) return;
+
+        if (workerCount == 0) {
+            unsigned hw = std::thread::hardware_concurrency();
+            workerCount = hw > 1 ? hw - 1 : 0;
+        }
+
+        s_Stopping = false;
+        s_Workers.reserve(workerCount);
+        for (unsigned i = 0; i < workerCount; ++i) {
+            s_Workers.emplace_back(workerLoop, i + 1);
+        }
+
+        s_Initialized = true;
+        Log::info("JobSystem started with " + std::to_string(workerCount) + " worker threads");
+    }
+
+    void JobSystem::shutdown() {
+        if (!s_Initialized) return;
+
+        {
+            std::lock_guard<std::mutex> lock(s_Mutex);
+            s_Stopping = true;
+        }
+        s_WakeCv.notify_all();
+
+        for (auto& worker : s_Workers) {
+            if (worker.joinable()) worker.join();
+        }
+        s_Workers.clear();
+        s_Initialized = false;
+    }
+
+    unsigned JobSystem::getSlotCount() {
+        if (!s_Initialized) init();
+        return static_cast<unsigned>(s_Workers.size()) + 1;
+    }
+
+    void JobSystem::runChunks(unsigned slot) {
+        const RangeFn& fn = *s_Job;
+        for (;;) {
+            size_t begin = s_Next.fetch_add(s_Grain);
+            if (begin >= s_Count) break;
+            fn(begin, std::min(begin + s_Grain, s_Count), slot);
+        }
+    }
+
+    void JobSystem::workerLoop(unsigned slot) {
+        uint64_t seenGeneration = 0;
+
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(s_Mutex);
+                s_WakeCv.wait(lock, [&] { return s_Stopping || s_Generation != seenGeneration; });
+                if (s_Stopping) return;
+                seenGeneration = s_Generation;
+            }
+
+            runChunks(slot);
+
+            std::lock_guard<std::mutex> lock(s_Mutex);
+            if (--s_Pending == 0) s_DoneCv.notify_one();
+        }
+    }
+
+    void JobSystem::parallelFor(size_t count, size_t grainSize, const RangeFn& fn) {
+        if (count == 0) return;
+        if (!s_Initialized) init();
+
+        grainSize = std::max<size_t>(grainSize, 1);
+
+        // Ziadne workery, jediny chunk alebo vnorene volanie - spracuj na volajucom threade
+        bool expected = false;
+        if (s_Workers.empty() || count <= grainSize || !s_Busy.compare_exchange_strong(expected, true)) {
+            fn(0, count, 0);
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(s_Mutex);
+            s_Job = &fn;
+            s_Count = count;
+            s_Grain = grainSize;
+            s_Next.store(0);
+            s_Pending = static_cast<unsigned>(s_Workers.size());
+            ++s_Generation;
+        }
+        s_WakeCv.notify_all();
+
+        runChunks(0);
+
+        {
+            std::unique_lock<std::mutex> lock(s_Mutex);
+            s_DoneCv.wait(lock, [] { return s_Pending == 0; });
+            s_Job = nullptr;
+        }
+        s_Busy.store(false);
+    }
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+namespace Engine {
+    /**
+     * @brief Staticky pool worker threadov pre data-paralelne ulohy (napr. narrowphase kolizii).
+     * Volajuci thread sa zapaja do prace, takze slot 0 patri vzdy jemu.
+     */
+    class JobSystem {
+    public:
+        using RangeFn = std::function<void(size_t begin, size_t end, unsigned slot)>;
+
+    private:
+        JobSystem() = delete;
+
+        static void workerLoop(unsigned slot);
+        static void runChunks(unsigned slot);
+
+    public:
+        /** @brief Spusti worker thready. 0 = podla poctu jadier. Volane lazy pri prvom parallelFor. */
+        static void init(unsigned workerCount = 0);
+        static void shutdown();
+
+        /** @brief Pocet slotov (workery + volajuci thread) - velkost per-thread bufferov. */
+        static unsigned getSlotCount();
+
+        /**
+         * @brief Rozdeli [0, count) na chunky velkosti grainSize a spracuje ich paralelne.
+         * Blokuje, kym nie su vsetky chunky hotove. Vnorene volania bezia seriovo.
+         */
+        static void parallelFor(size_t count, size_t grainSize, const RangeFn& fn);
+    };
+}
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <array>
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <filesystem>
@@ -7,7 +9,55 @@
 namespace Engine {
 
     class Scene; 
+
+    constexpr int MaxCollisionLayers = 32;
+
+    // Riadok i = bitmaska vrstiev, s ktorymi vrstva i koliduje. Default: vsetko so vsetkym.
+    inline std::array<uint32_t, MaxCollisionLayers> MakeDefaultLayerMatrix() {
+        std::array<uint32_t, MaxCollisionLayers> matrix;
+        matrix.fill(0xFFFFFFFFu);
+        return matrix;
+    }
     
+    // Render vrstvy sa kreslia v poradi indexu, az potom podla zIndex. Posledny index kluca patri editoru.
+    constexpr int MaxRenderLayers = 15;
+    // Kam sa pri nacitani presunu sprity a texty ulozene so starym IsFixed
+    constexpr int DefaultScreenLayer = 1;
+    // Kolko MB mozu zabrat textury statickych textov, kym sa nekreslene zacnu uvolnovat
+    constexpr int DefaultTextCacheBudgetMB = 32;
+
+    struct RenderLayerSettings {
+        std::string name;
+        bool screenSpace = false; // pozicie su pixely ciela, kamera sa ignoruje (UI)
+        bool isStatic = false;    // sprity sa skladaju do cache textur, prekresli sa len co sa zmenilo
+    };
+
+    inline std::array<RenderLayerSettings, MaxRenderLayers> MakeDefaultRenderLayers() {
+        std::array<RenderLayerSettings, MaxRenderLayers> layers;
+        layers[0] = {"Default", false, false};
+        layers[DefaultScreenLayer] = {"UI", true, false};
+        return layers;
+    }
+
+    inline uint32_t GetScreenSpaceLayerMask(const std::array<RenderLayerSettings, MaxRenderLayers>& layers) {
+        uint32_t mask = 0;
+        for (int i = 0; i < MaxRenderLayers; ++i) {
+            if (layers[i].screenSpace)
+                mask |= 1u << i;
+        }
+        return mask;
+    }
+
+    /** @brief Static world layers; a layer that is also screen space is not cached. */
+    inline uint32_t GetStaticLayerMask(const std::array<RenderLayerSettings, MaxRenderLayers>& layers) {
+        uint32_t mask = 0;
+        for (int i = 0; i < MaxRenderLayers; ++i) {
+            if (layers[i].isStatic && !layers[i].screenSpace)
+                mask |= 1u << i;
+        }
+        return mask;
+    }
+
     struct ProjectConfig {
         std::string name = "New Project";
         std::string assetDirectory = "assets";
@@ -15,6 +65,32 @@ namespace Engine {
         std::string engineVersion = "1.0.0";
         int width = 1280;
         int height = 720;
+
+        // Simulacia bezi vo fixnych krokoch, render medzi nimi interpoluje
+        int fixedUpdateRate = 60;
+        int maxSubSteps = 5;
+        int velocityIterations = 8;
+        int positionIterations = 3;
+        // Triggery sa testuju kazdych N krokov, pri vela senzoroch setri CPU za cenu oneskorenia eventov
+        int triggerUpdateInterval = 1;
+        // Replaye/lockstep: vstup len vo fixnom kroku, stabilne poradie, checksumy krokov
+        bool deterministicPhysics = false;
+        // Runtime simuluje dalsi frame na worker threade, kym sa predchadzajuci kresli; vypnute = vsetko na jednom threade
+        bool threadedRendering = true;
+
+        // Navigacna mriezka zo statickych colliderov: velkost bunky a odstup agenta od prekazok
+        float navCellSize = 32.0f;
+        float navAgentRadius = 0.0f;
+
+        // Rozpocet cache textur textov v MB, textury nakreslene v aktualnom frame-i sa nikdy neuvolnia
+        int textCacheBudgetMB = DefaultTextCacheBudgetMB;
+
+        // Pomenovane collision vrstvy (bit i = layerNames[i]) a symetricka matica ich interakcii
+        std::array<std::string, MaxCollisionLayers> layerNames = {
+            "Default", "Player", "Enemy", "Obstacle", "Projectile", "Trigger"};
+        std::array<uint32_t, MaxCollisionLayers> layerMatrix = MakeDefaultLayerMatrix();
+
+        std::array<RenderLayerSettings, MaxRenderLayers> renderLayers = MakeDefaultRenderLayers();
     };
 
     struct ProjectRuntimeState {
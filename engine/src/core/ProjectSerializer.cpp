@@ -1,6 +1,7 @@
 #include "ProjectSerializer.h"
 #include <fstream>
 #include <iomanip>
+#include <limits>
 #include <memory>
 
 // ECS Core
@@ -21,12 +22,22 @@
 #include "ecs/components/SpriteComponent.h"
 #include "ecs/components/TransformComponent.h"
 #include "ecs/components/TextComponent.h"
+#include "ecs/components/TilemapComponent.h"
 #include "ecs/components/VelocityComponent.h"
 
 using json = nlohmann::json;
 
 namespace Engine
 {
+  // Suradnica chunku musi byt cele cislo, ktore po vynasobeni velkostou chunku nepretecie int
+  static bool IsChunkCoordinate(const json &value, int chunkSize)
+  {
+    const int64_t limit = std::numeric_limits<int>::max() / chunkSize;
+    if (value.is_number_unsigned())
+      return value.get<uint64_t>() <= (uint64_t)limit;
+    return value.is_number_integer() && value.get<int64_t>() >= -limit && value.get<int64_t>() <= limit;
+  }
+
   void ProjectSerializer::saveProjectFile(Project *project, const fs::path &filePath)
   {
     if (!project)
@@ -47,7 +58,24 @@ namespace Engine
         {"StartScene", project->config.startScenePath},
         {"AssetDirectory", project->config.assetDirectory},
         {"Width", project->config.width},
-        {"Height", project->config.height}};
+        {"Height", project->config.height},
+        {"FixedUpdateRate", project->config.fixedUpdateRate},
+        {"MaxSubSteps", project->config.maxSubSteps},
+        {"VelocityIterations", project->config.velocityIterations},
+        {"PositionIterations", project->config.positionIterations},
+        {"TriggerUpdateInterval", project->config.triggerUpdateInterval},
+        {"DeterministicPhysics", project->config.deterministicPhysics},
+        {"ThreadedRendering", project->config.threadedRendering},
+        {"NavCellSize", project->config.navCellSize},
+        {"NavAgentRadius", project->config.navAgentRadius},
+        {"TextCacheBudgetMB", project->config.textCacheBudgetMB},
+        {"LayerNames", project->config.layerNames},
+        {"LayerMatrix", project->config.layerMatrix}};
+
+    json renderLayers = json::array();
+    for (const auto &layer : project->config.renderLayers)
+      renderLayers.push_back({{"Name", layer.name}, {"ScreenSpace", layer.screenSpace}, {"Static", layer.isStatic}});
+    j["Project"]["RenderLayers"] = renderLayers;
 
     // ---- Runtime-only state ----
     j["Runtime"] = {
@@ -98,6 +126,39 @@ namespace Engine
     config.assetDirectory = p.value("AssetDirectory", "assets");
     config.width = p.value("Width", 1280);
     config.height = p.value("Height", 720);
+    config.fixedUpdateRate = p.value("FixedUpdateRate", 60);
+    config.maxSubSteps = p.value("MaxSubSteps", 5);
+    config.velocityIterations = p.value("VelocityIterations", 8);
+    config.positionIterations = p.value("PositionIterations", 3);
+    config.triggerUpdateInterval = p.value("TriggerUpdateInterval", 1);
+    config.deterministicPhysics = p.value("DeterministicPhysics", false);
+    config.threadedRendering = p.value("ThreadedRendering", true);
+    config.navCellSize = p.value("NavCellSize", 32.0f);
+    config.navAgentRadius = p.value("NavAgentRadius", 0.0f);
+    config.textCacheBudgetMB = p.value("TextCacheBudgetMB", DefaultTextCacheBudgetMB);
+
+    if (p.contains("LayerNames") && p["LayerNames"].is_array())
+    {
+      const auto &names = p["LayerNames"];
+      for (size_t i = 0; i < names.size() && i < config.layerNames.size(); ++i)
+        config.layerNames[i] = names[i].get<std::string>();
+    }
+    if (p.contains("LayerMatrix") && p["LayerMatrix"].is_array())
+    {
+      const auto &rows = p["LayerMatrix"];
+      for (size_t i = 0; i < rows.size() && i < config.layerMatrix.size(); ++i)
+        config.layerMatrix[i] = rows[i].get<uint32_t>();
+    }
+    if (p.contains("RenderLayers") && p["RenderLayers"].is_array())
+    {
+      const auto &layers = p["RenderLayers"];
+      for (size_t i = 0; i < layers.size() && i < config.renderLayers.size(); ++i)
+      {
+        config.renderLayers[i].name = layers[i].value("Name", "");
+        config.renderLayers[i].screenSpace = layers[i].value("ScreenSpace", false);
+        config.renderLayers[i].isStatic = layers[i].value("Static", false);
+      }
+    }
 
     // ---- Load runtime (optional!) ----
     if (data.contains("Runtime"))
@@ -175,7 +236,7 @@ namespace Engine
           {"AssetId", c->assetId},
           {"ZIndex", c->zIndex},
           {"Visible", c->visible},
-          {"IsFixed", c->isFixed},
+          {"Layer", c->layer},
           {"FlipH", c->flipH},
           {"FlipV", c->flipV},
           {"SourceRect",
@@ -198,8 +259,9 @@ namespace Engine
           {"FontPath", c->fontPath},
           {"FontSize", c->fontSize},
           {"Color", {c->color.r, c->color.g, c->color.b, c->color.a}},
-          {"IsFixed", c->isFixed},
-          {"ZIndex", c->zIndex}};
+          {"Layer", c->layer},
+          {"ZIndex", c->zIndex},
+          {"Dynamic", c->dynamic}};
     }
 
     // 3. Animation
@@ -259,10 +321,14 @@ namespace Engine
     if (entity->hasComponent<RigidBodyComponent>())
     {
       auto *c = entity->getComponent<RigidBodyComponent>();
-      j["Components"]["RigidBody"] = {{"BodyType", (int)c->bodyType},
+      j["Components"]["RigidBody"] = {{"BodyType", (int)c->getBodyType()},
                                       {"Mass", c->mass},
                                       {"GravityScale", c->gravityScale},
-                                      {"LinearDrag", c->linearDrag}};
+                                      {"LinearDrag", c->linearDrag},
+                                      {"AllowSleep", c->allowSleep},
+                                      {"Restitution", c->restitution},
+                                      {"Friction", c->friction},
+                                      {"ContinuousCollision", c->continuousCollision}};
     }
 
     // 8. Input Controller
@@ -292,6 +358,39 @@ namespace Engine
       j["Components"]["Script"] = {{"Path", c->scriptPath}};
     }
 
+    // 11. Tilemap
+    if (entity->hasComponent<TilemapComponent>())
+    {
+      auto *c = entity->getComponent<TilemapComponent>();
+      // Kazdy chunk ako dvojice [pocet, dlazdica] po riadkoch, prazdne plochy stoja par cisel
+      json chunks = json::array();
+      for (const auto &[key, chunk] : c->getChunks())
+      {
+        json runs = json::array();
+        for (size_t i = 0; i < chunk.tiles.size();)
+        {
+          size_t run = 1;
+          while (i + run < chunk.tiles.size() && chunk.tiles[i + run] == chunk.tiles[i])
+            ++run;
+          runs.push_back({run, chunk.tiles[i]});
+          i += run;
+        }
+        glm::ivec2 coords = TilemapComponent::ChunkCoords(key);
+        chunks.push_back({{"X", coords.x}, {"Y", coords.y}, {"Tiles", runs}});
+      }
+      j["Components"]["Tilemap"] = {
+          {"TilesetAssetId", c->tilesetAssetId},
+          {"TileSize", {c->tileSize.x, c->tileSize.y}},
+          {"Layer", c->layer},
+          {"ZIndex", c->zIndex},
+          {"Visible", c->visible},
+          {"Color", {c->color.r, c->color.g, c->color.b, c->color.a}},
+          {"Collision", c->collision},
+          {"CollisionLayer", c->collisionLayer},
+          {"CollisionMask", c->collisionMask},
+          {"Chunks", chunks}};
+    }
+
     return j;
   }
 
@@ -311,6 +410,8 @@ namespace Engine
       scenePtr =
           std::make_unique<Scene>(sceneJson.value("SceneName", "Untitled"));
       scenePtr->setRenderer(renderer);
+      if (project)
+        scenePtr->applyProjectSettings(project->getConfig());
 
       if (sceneJson.contains("Background"))
       {
@@ -480,34 +581,47 @@ namespace Engine
 
       if (!assetId.empty())
       {
-        std::vector<fs::path> searchRoots = {project->getAssetPath()};
-        std::string actualPath = "";
+        // Exportovana hra ma obrazky v atlase z buildu, tie su zaregistrovane bez suboru na disku
+        SDL_Texture *tex = assetManager ? assetManager->getTexture(assetId) : nullptr;
 
-        for (const auto &root : searchRoots)
+        if (!tex)
         {
-          actualPath = findAssetPath(root, assetId, 0, 5);
-          if (!actualPath.empty())
-            break;
-        }
+          std::vector<fs::path> searchRoots = {project->getAssetPath()};
+          std::string actualPath = "";
 
-        SDL_Texture *tex = nullptr;
+          for (const auto &root : searchRoots)
+          {
+            actualPath = findAssetPath(root, assetId, 0, 5);
+            if (!actualPath.empty())
+              break;
+          }
 
-        if (!actualPath.empty() && assetManager)
-        {
-          assetManager->loadTextureIfMissing(assetId, actualPath);
-          tex = assetManager->getTexture(assetId);
-        }
-        else
-        {
-          Log::error("Sprite asset not found: " + assetId);
+          if (!actualPath.empty() && assetManager)
+          {
+            assetManager->loadTextureIfMissing(assetId, actualPath);
+            tex = assetManager->getTexture(assetId);
+          }
+          else
+          {
+            Log::error("Sprite asset not found: " + assetId);
+          }
         }
 
-        auto *cPtr = entity->addComponent<SpriteComponent>(assetId, tex);
+        auto *cPtr = entity->addComponent<SpriteComponent>(assetId);
         if (cPtr)
         {
+          // Velkost z regionu assetu, textura moze byt cela stranka atlasu
+          TextureRegion region;
+          if (AssetManager::getTextureRegion(assetId, region))
+          {
+            cPtr->texture = region.texture;
+            cPtr->sourceRect = {0, 0, region.rect.w, region.rect.h};
+          }
+
           cPtr->zIndex = val.value("ZIndex", 0);
           cPtr->visible = val.value("Visible", true);
-          cPtr->isFixed = val.value("IsFixed", false);
+          // Starsie sceny mali namiesto vrstvy IsFixed
+          cPtr->layer = val.value("Layer", val.value("IsFixed", false) ? DefaultScreenLayer : 0);
           cPtr->flipH = val.value("FlipH", false);
           cPtr->flipV = val.value("FlipV", false);
 
@@ -617,6 +731,10 @@ namespace Engine
         cPtr->mass = val.value("Mass", 1.0f);
         cPtr->gravityScale = val.value("GravityScale", 1.0f);
         cPtr->linearDrag = val.value("LinearDrag", 0.0f);
+        cPtr->allowSleep = val.value("AllowSleep", true);
+        cPtr->restitution = val.value("Restitution", 0.0f);
+        cPtr->friction = val.value("Friction", 0.2f);
+        cPtr->continuousCollision = val.value("ContinuousCollision", false);
       }
     }
 
@@ -649,5 +767,74 @@ namespace Engine
     {
       entity->addComponent<ScriptComponent>(comps["Script"]["Path"]);
     }
+
+    // 11. Tilemap
+    if (comps.contains("Tilemap"))
+    {
+      const auto &val = comps["Tilemap"];
+      std::string assetId = val.value("TilesetAssetId", "");
+      if (!assetId.empty() && assetManager && project && !assetManager->getTexture(assetId))
+      {
+        std::string actualPath = findAssetPath(project->getAssetPath(), assetId, 0, 5);
+        if (!actualPath.empty())
+          assetManager->loadTextureIfMissing(assetId, actualPath);
+        else
+          Log::error("Tileset asset not found: " + assetId);
+      }
+
+      auto *cPtr = entity->addComponent<TilemapComponent>(assetId, glm::ivec2(16, 16));
+      if (cPtr)
+      {
+        if (val.contains("TileSize") && val["TileSize"].is_array() && val["TileSize"].size() == 2)
+          cPtr->tileSize = {val["TileSize"][0], val["TileSize"][1]};
+        cPtr->layer = val.value("Layer", 0);
+        cPtr->zIndex = val.value("ZIndex", 0);
+        cPtr->visible = val.value("Visible", true);
+        if (val.contains("Color") && val["Color"].is_array() && val["Color"].size() == 4)
+          cPtr->color = {val["Color"][0], val["Color"][1], val["Color"][2], val["Color"][3]};
+        cPtr->collision = val.value("Collision", true);
+        cPtr->collisionLayer = val.value("CollisionLayer", 1u);
+        cPtr->collisionMask = val.value("CollisionMask", 0xFFFFFFFFu);
+
+        const int chunkSize = TilemapComponent::ChunkSize;
+        for (const auto &chunk : val.value("Chunks", json::array()))
+        {
+          // Pokazeny chunk sa preskoci, nacitanie sceny kvoli nemu nesmie zlyhat
+          bool validChunk = chunk.is_object() && chunk.contains("X") && chunk.contains("Y") && chunk.contains("Tiles") &&
+                            IsChunkCoordinate(chunk["X"], chunkSize) && IsChunkCoordinate(chunk["Y"], chunkSize) &&
+                            chunk["Tiles"].is_array();
+          if (!validChunk)
+          {
+            Log::warn("Tilemap of " + entity->getName() + " has a malformed chunk, it is skipped");
+            continue;
+          }
+          int baseX = chunk["X"].get<int>() * chunkSize;
+          int baseY = chunk["Y"].get<int>() * chunkSize;
+          const json &runs = chunk["Tiles"];
+          int index = 0;
+          for (const auto &run : runs)
+          {
+            if (index >= chunkSize * chunkSize)
+              break;
+            // Bez platneho poctu sa neda urcit, kde zacina dalsi beh; zvysok chunku ostane prazdny
+            bool valid = run.is_array() && run.size() == 2 && run[0].is_number_unsigned() && run[1].is_number_unsigned() &&
+                         run[0].get<uint64_t>() > 0 && run[1].get<uint64_t>() <= 0xFFFF;
+            if (!valid)
+            {
+              Log::warn("Tilemap of " + entity->getName() + " has an invalid tile run, the rest of its chunk is skipped");
+              break;
+            }
+            int count = (int)std::min<uint64_t>(run[0].get<uint64_t>(), (uint64_t)(chunkSize * chunkSize));
+            unsigned tileValue = run[1].get<unsigned>();
+            auto tile = (TilemapComponent::Tile)tileValue;
+            for (int i = 0; i < count && index < chunkSize * chunkSize; ++i, ++index)
+            {
+              if (tile != 0)
+                cPtr->setTile(baseX + index % chunkSize, baseY + index / chunkSize, tile);
+            }
+          }
+        }
+      }
+    }
   }
 } // namespace Engine
\ No newline at end of file
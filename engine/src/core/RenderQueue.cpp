@@ -0,0 +1,349 @@
+#include "RenderQueue.h"
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace Engine {
+
+    namespace RenderSortKey {
+
+        uint64_t Pack(uint32_t layer, int zIndex, uint32_t textureId, uint32_t material, uint32_t entity)
+        {
+            // Posun o polovicu rozsahu, aby zaporne zIndex boli pred kladnymi aj ako unsigned
+            int clamped = std::clamp(zIndex, -32768, 32767);
+            uint64_t z = (uint64_t)(clamped + 32768);
+
+            uint64_t key = (uint64_t)(layer & ((1u << LayerBits) - 1));
+            key = (key << ZIndexBits) | z;
+            key = (key << TextureBits) | (textureId & MaxTextureId);
+            key = (key << MaterialBits) | (material & ((1u << MaterialBits) - 1));
+            key = (key << EntityBits) | (entity & MaxEntity);
+            return key;
+        }
+    }
+
+    ScreenQuad ScreenQuad::FromRect(const SDL_FRect& dest, float angle)
+    {
+        // Rotacia okolo stredu ciela, v smere hodinovych ruciciek (os y ide dole)
+        float radians = glm::radians(angle);
+        float s = std::sin(radians);
+        float c = std::cos(radians);
+        float hw = dest.w * 0.5f;
+        float hh = dest.h * 0.5f;
+
+        ScreenQuad quad;
+        quad.center = {dest.x + hw, dest.y + hh};
+        quad.axisU = {hw * c, hw * s};
+        quad.axisV = {-hh * s, hh * c};
+        return quad;
+    }
+
+    void ProjectQuads(const Affine2D& worldToScreen, const Affine2D* world, const glm::vec2* halfSizes,
+                      size_t count, ScreenQuad* out)
+    {
+        // Bez vetiev a volani, kompilator to vektorizuje
+        for (size_t i = 0; i < count; ++i)
+        {
+            Affine2D screen = worldToScreen * world[i];
+            out[i].center = screen.origin;
+            out[i].axisU = screen.x * halfSizes[i].x;
+            // Horny okraj textury je vo svete +y
+            out[i].axisV = screen.y * -halfSizes[i].y;
+        }
+    }
+
+    void RadixSortRenderItems(std::vector<RenderItem>& items, std::vector<RenderItem>& scratch)
+    {
+        const size_t count = items.size();
+        if (count < 2)
+            return;
+
+        // Pri malom pocte je insertion sort lacnejsi nez histogramy
+        if (count <= 32)
+        {
+            for (size_t i = 1; i < count; ++i)
+            {
+                RenderItem item = items[i];
+                size_t j = i;
+                for (; j > 0 && items[j - 1].key > item.key; --j)
+                    items[j] = items[j - 1];
+                items[j] = item;
+            }
+            return;
+        }
+
+        // Histogramy vsetkych 8 bajtov v jednom prechode
+        uint32_t histograms[8][256] = {};
+        for (const RenderItem& item : items)
+        {
+            uint64_t key = item.key;
+            for (int pass = 0; pass < 8; ++pass)
+                histograms[pass][(key >> (pass * 8)) & 0xFF]++;
+        }
+
+        scratch.resize(count);
+        RenderItem* source = items.data();
+        RenderItem* dest = scratch.data();
+
+        for (int pass = 0; pass < 8; ++pass)
+        {
+            uint32_t* histogram = histograms[pass];
+            int shift = pass * 8;
+
+            // Bajt, ktory maju vsetky kluce rovnaky, poradie nemeni
+            if (histogram[(source[0].key >> shift) & 0xFF] == count)
+                continue;
+
+            uint32_t offset = 0;
+            for (int digit = 0; digit < 256; ++digit)
+            {
+                uint32_t size = histogram[digit];
+                histogram[digit] = offset;
+                offset += size;
+            }
+
+            for (size_t i = 0; i < count; ++i)
+                dest[histogram[(source[i].key >> shift) & 0xFF]++] = source[i];
+
+            std::swap(source, dest);
+        }
+
+        if (source != items.data())
+            std::copy(source, source + count, items.data());
+    }
+
+    void RenderQueue::begin()
+    {
+        m_Commands.clear();
+        m_Items.clear();
+        m_Points.clear();
+        m_GeometryVertices.clear();
+    }
+
+    void RenderQueue::submitQuad(uint64_t key, SDL_Texture* texture, const SDL_Rect& region, const SDL_Rect& src,
+                                 const ScreenQuad& quad, SDL_RendererFlip flip, SDL_Color color)
+    {
+        if (!texture)
+            return;
+
+        RenderCommand command;
+        command.type = RenderCommand::Type::Quad;
+        command.texture = texture;
+        command.region = region;
+        command.src = src;
+        command.quad = quad;
+        command.flip = flip;
+        command.color = color;
+
+        m_Items.push_back({key, (uint32_t)m_Commands.size()});
+        m_Commands.push_back(command);
+    }
+
+    void RenderQueue::submitLines(uint64_t key, const SDL_FPoint* points, int count, SDL_Color color)
+    {
+        if (!points || count < 2)
+            return;
+
+        RenderCommand command;
+        command.type = RenderCommand::Type::Lines;
+        command.color = color;
+        command.firstPoint = (uint32_t)m_Points.size();
+        command.pointCount = (uint32_t)count;
+        m_Points.insert(m_Points.end(), points, points + count);
+
+        m_Items.push_back({key, (uint32_t)m_Commands.size()});
+        m_Commands.push_back(command);
+    }
+
+    void RenderQueue::submitGeometry(uint64_t key, SDL_Texture* texture, const Affine2D& toScreen,
+                                     const SDL_Vertex* vertices, int count, SDL_Color color)
+    {
+        // Len cele stvorice
+        count -= count % 4;
+        if (!texture || !vertices || count <= 0)
+            return;
+
+        RenderCommand command;
+        command.type = RenderCommand::Type::Geometry;
+        command.texture = texture;
+        command.color = color;
+        command.firstVertex = (uint32_t)m_GeometryVertices.size();
+        command.vertexCount = (uint32_t)count;
+
+        m_GeometryVertices.reserve(m_GeometryVertices.size() + count);
+        for (int i = 0; i < count; ++i)
+        {
+            SDL_Vertex vertex = vertices[i];
+            glm::vec2 p = toScreen.apply({vertex.position.x, vertex.position.y});
+            vertex.position = {p.x, p.y};
+            vertex.color = color;
+            m_GeometryVertices.push_back(vertex);
+        }
+
+        m_Items.push_back({key, (uint32_t)m_Commands.size()});
+        m_Commands.push_back(command);
+    }
+
+    void RenderQueue::sortItems()
+    {
+        // Producenti posielaju uz zoradene, takze vstup je par zoradenych behov za sebou
+        m_RunStarts.clear();
+        m_RunStarts.push_back(0);
+        for (size_t i = 1; i < m_Items.size(); ++i)
+        {
+            if (m_Items[i].key < m_Items[i - 1].key)
+                m_RunStarts.push_back(i);
+        }
+        if (m_RunStarts.size() == 1)
+            return;
+
+        if (m_RunStarts.size() > 8)
+        {
+            RadixSortRenderItems(m_Items, m_Scratch);
+            return;
+        }
+
+        // Stabilne zlucovanie susednych behov, kym neostane jeden
+        m_RunStarts.push_back(m_Items.size());
+        m_Scratch.resize(m_Items.size());
+        while (m_RunStarts.size() > 2)
+        {
+            m_MergedRuns.clear();
+            m_MergedRuns.push_back(0);
+            for (size_t r = 0; r + 1 < m_RunStarts.size(); r += 2)
+            {
+                size_t begin = m_RunStarts[r];
+                size_t middle = m_RunStarts[r + 1];
+                size_t end = r + 2 < m_RunStarts.size() ? m_RunStarts[r + 2] : middle;
+                std::merge(m_Items.begin() + begin, m_Items.begin() + middle,
+                           m_Items.begin() + middle, m_Items.begin() + end,
+                           m_Scratch.begin() + begin,
+                           [](const RenderItem& a, const RenderItem& b)
+                           { return a.key < b.key; });
+                m_MergedRuns.push_back(end);
+            }
+            m_Items.swap(m_Scratch);
+            if (m_MergedRuns.back() != m_Items.size())
+                m_MergedRuns.push_back(m_Items.size());
+            m_RunStarts.swap(m_MergedRuns);
+        }
+    }
+
+    void RenderQueue::bindTexture(SDL_Renderer* renderer, SDL_Texture* texture)
+    {
+        if (texture == m_BatchTexture)
+            return;
+        flushBatch(renderer);
+        m_BatchTexture = texture;
+        SDL_QueryTexture(texture, nullptr, nullptr, &m_BatchTextureW, &m_BatchTextureH);
+    }
+
+    void RenderQueue::pushQuad(SDL_Renderer* renderer, const RenderCommand& command)
+    {
+        bindTexture(renderer, command.texture);
+
+        // Zdrojovy rect sa posunie do regionu assetu a oreze nan, ako SDL_RenderCopyExF oreze na texturu; ciel ostava
+        SDL_Rect bounds = command.region;
+        if (bounds.w <= 0 || bounds.h <= 0)
+            bounds = {0, 0, m_BatchTextureW, m_BatchTextureH};
+        SDL_Rect shifted = {command.src.x + bounds.x, command.src.y + bounds.y, command.src.w, command.src.h};
+        SDL_Rect clipped;
+        if (!SDL_IntersectRect(&shifted, &bounds, &clipped))
+            return;
+
+        float u0 = clipped.x / (float)m_BatchTextureW;
+        float v0 = clipped.y / (float)m_BatchTextureH;
+        float u1 = (clipped.x + clipped.w) / (float)m_BatchTextureW;
+        float v1 = (clipped.y + clipped.h) / (float)m_BatchTextureH;
+        if (command.flip & SDL_FLIP_HORIZONTAL)
+            std::swap(u0, u1);
+        if (command.flip & SDL_FLIP_VERTICAL)
+            std::swap(v0, v1);
+
+        const ScreenQuad& quad = command.quad;
+        const float corners[4][4] = {{-1.0f, -1.0f, u0, v0}, {1.0f, -1.0f, u1, v0}, {1.0f, 1.0f, u1, v1}, {-1.0f, 1.0f, u0, v1}};
+
+        int base = (int)m_Vertices.size();
+        for (const auto& corner : corners)
+        {
+            SDL_Vertex vertex;
+            vertex.position.x = quad.center.x + quad.axisU.x * corner[0] + quad.axisV.x * corner[1];
+            vertex.position.y = quad.center.y + quad.axisU.y * corner[0] + quad.axisV.y * corner[1];
+            vertex.color = command.color;
+            vertex.tex_coord.x = corner[2];
+            vertex.tex_coord.y = corner[3];
+            m_Vertices.push_back(vertex);
+        }
+
+        const int quadIndices[6] = {0, 1, 2, 0, 2, 3};
+        for (int index : quadIndices)
+            m_Indices.push_back(base + index);
+    }
+
+    void RenderQueue::pushGeometry(SDL_Renderer* renderer, const RenderCommand& command)
+    {
+        bindTexture(renderer, command.texture);
+
+        int base = (int)m_Vertices.size();
+        const SDL_Vertex* vertices = m_GeometryVertices.data() + command.firstVertex;
+        m_Vertices.insert(m_Vertices.end(), vertices, vertices + command.vertexCount);
+
+        m_Indices.reserve(m_Indices.size() + command.vertexCount / 4 * 6);
+        for (int quad = base; quad < base + (int)command.vertexCount; quad += 4)
+        {
+            const int quadIndices[6] = {0, 1, 2, 0, 2, 3};
+            for (int index : quadIndices)
+                m_Indices.push_back(quad + index);
+        }
+    }
+
+    void RenderQueue::flushBatch(SDL_Renderer* renderer)
+    {
+        if (!m_Indices.empty())
+        {
+            SDL_RenderGeometry(renderer, m_BatchTexture, m_Vertices.data(), (int)m_Vertices.size(),
+                               m_Indices.data(), (int)m_Indices.size());
+            m_Stats.drawCalls++;
+        }
+        m_Vertices.clear();
+        m_Indices.clear();
+    }
+
+    void RenderQueue::flush(SDL_Renderer* renderer)
+    {
+        m_Stats = RenderQueueStats();
+        m_Stats.commands = (int)m_Commands.size();
+        if (!renderer || m_Commands.empty())
+            return;
+
+        sortItems();
+
+        m_BatchTexture = nullptr;
+        m_Vertices.clear();
+        m_Indices.clear();
+
+        for (const RenderItem& item : m_Items)
+        {
+            const RenderCommand& command = m_Commands[item.index];
+            if (command.type == RenderCommand::Type::Quad)
+            {
+                pushQuad(renderer, command);
+                continue;
+            }
+            if (command.type == RenderCommand::Type::Geometry)
+            {
+                pushGeometry(renderer, command);
+                continue;
+            }
+
+            // Ciary nejdu do davky, rozdelia ju ako kazda zmena textury
+            flushBatch(renderer);
+            m_BatchTexture = nullptr;
+            SDL_SetRenderDrawColor(renderer, command.color.r, command.color.g, command.color.b, command.color.a);
+            SDL_RenderDrawLinesF(renderer, m_Points.data() + command.firstPoint, (int)command.pointCount);
+            m_Stats.drawCalls++;
+        }
+
+        flushBatch(renderer);
+    }
+}
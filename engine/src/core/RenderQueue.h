@@ -0,0 +1,168 @@
+#pragma once
+
+#include "core/Transform2D.h"
+#include <SDL2/SDL.h>
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Engine {
+
+    /**
+     * @brief Packed 64-bit draw order, compared as one integer.
+     * From the most significant bits: layer (4), zIndex (16, biased), texture id (16), material (4), entity (24).
+     * zIndex is clamped to int16, entity is the creation-order slot of the item in its system.
+     */
+    namespace RenderSortKey {
+        inline constexpr int LayerBits = 4;
+        inline constexpr int ZIndexBits = 16;
+        inline constexpr int TextureBits = 16;
+        inline constexpr int MaterialBits = 4;
+        inline constexpr int EntityBits = 24;
+        inline constexpr uint32_t MaxTextureId = (1u << TextureBits) - 1;
+        inline constexpr uint32_t MaxEntity = (1u << EntityBits) - 1;
+
+        // Posledna vrstva patri editoru (gizma, collidery), je nad vsetkymi vrstvami projektu
+        inline constexpr uint32_t DebugLayer = (1u << LayerBits) - 1;
+        // Text nema zdielanu texturu; najvyssie ID ho drzi nad spritmi s rovnakym zIndex
+        inline constexpr uint32_t TextTextureId = MaxTextureId;
+        // Tilemapy su pod spritmi s rovnakym zIndex (sprity dostavaju ID od 1)
+        inline constexpr uint32_t TilemapTextureId = 0;
+
+        uint64_t Pack(uint32_t layer, int zIndex, uint32_t textureId, uint32_t material, uint32_t entity);
+        inline uint32_t GetLayer(uint64_t key) { return (uint32_t)(key >> (64 - LayerBits)); }
+    }
+
+    /** @brief Sort key plus the owner's slot, e.g. into its list of sprites or commands. */
+    struct RenderItem {
+        uint64_t key;
+        uint32_t index;
+    };
+
+    /** @brief Stable LSD radix sort by key; byte passes where all keys agree are skipped. */
+    void RadixSortRenderItems(std::vector<RenderItem>& items, std::vector<RenderItem>& scratch);
+
+    /**
+     * @brief Textured quad in target pixels: center plus half-extent vectors toward the right (u) and
+     * bottom (v) edge of the texture. Carries rotation, scale and mirroring without an angle.
+     */
+    struct ScreenQuad {
+        glm::vec2 center = {0.0f, 0.0f};
+        glm::vec2 axisU = {0.0f, 0.0f};
+        glm::vec2 axisV = {0.0f, 0.0f};
+
+        /** @brief dest rotated clockwise by angle degrees around its center, as SDL_RenderCopyExF draws it. */
+        static ScreenQuad FromRect(const SDL_FRect& dest, float angle);
+    };
+
+    /**
+     * @brief Projects count centered rects through worldToScreen in one pass over contiguous arrays.
+     * out[i] is world[i] of a rect with halfSizes[i]; world space is y-up, the texture's top edge is +y.
+     */
+    void ProjectQuads(const Affine2D& worldToScreen, const Affine2D* world, const glm::vec2* halfSizes,
+                      size_t count, ScreenQuad* out);
+
+    /** @brief One draw of the unified queue, already in target pixels. */
+    struct RenderCommand {
+        enum class Type : uint8_t {
+            Quad,
+            Lines,
+            Geometry
+        };
+
+        Type type = Type::Quad;
+        SDL_Color color = {255, 255, 255, 255};
+
+        // Quad: texture sub-rect drawn into quad; Geometry: texture of the prebuilt quads
+        SDL_Texture* texture = nullptr;
+        SDL_Rect region = {0, 0, 0, 0}; // where the asset lives in texture (atlas page), empty = whole texture
+        SDL_Rect src = {0, 0, 0, 0};    // relative to region
+        ScreenQuad quad;
+        SDL_RendererFlip flip = SDL_FLIP_NONE;
+
+        // Lines: connected polyline stored in the queue's point buffer
+        uint32_t firstPoint = 0;
+        uint32_t pointCount = 0;
+
+        // Geometry: quads (4 vertices each) stored in the queue's vertex buffer, already in target pixels
+        uint32_t firstVertex = 0;
+        uint32_t vertexCount = 0;
+    };
+
+    /** @brief Counters of the last RenderQueue::flush. */
+    struct RenderQueueStats {
+        int commands = 0;
+        int drawCalls = 0;
+    };
+
+    /**
+     * @brief Single render queue of a scene. Sprites, text, tilemaps and editor debug shapes submit commands with
+     * a RenderSortKey, flush() orders them once and draws them in one pass, batching consecutive quads
+     * of the same texture (and geometry sharing it) into one SDL_RenderGeometry.
+     * Producers submit in their own key order, so the sort usually only merges a few sorted runs.
+     * Each layer is drawn either in world space (through the camera) or screen space (target pixels);
+     * producers ask isScreenSpace() instead of keeping per-component flags. Static layers are world layers whose
+     * sprites the RendererSystem draws from cached chunk textures (isStaticLayer()).
+     */
+    class RenderQueue {
+    public:
+        /** @brief Drops the commands of the previous frame. */
+        void begin();
+
+        void submitQuad(uint64_t key, SDL_Texture* texture, const SDL_Rect& region, const SDL_Rect& src,
+                        const ScreenQuad& quad, SDL_RendererFlip flip, SDL_Color color);
+        void submitQuad(uint64_t key, SDL_Texture* texture, const SDL_Rect& region, const SDL_Rect& src,
+                        const SDL_FRect& dest, float angle, SDL_RendererFlip flip, SDL_Color color)
+        {
+            submitQuad(key, texture, region, src, ScreenQuad::FromRect(dest, angle), flip, color);
+        }
+        void submitLines(uint64_t key, const SDL_FPoint* points, int count, SDL_Color color);
+
+        /**
+         * @brief Prebuilt textured quads, e.g. a tilemap chunk: 4 vertices per quad in the corner order of a
+         * quad command, with normalized UVs. Positions go through toScreen, color replaces the vertex color.
+         */
+        void submitGeometry(uint64_t key, SDL_Texture* texture, const Affine2D& toScreen, const SDL_Vertex* vertices,
+                            int count, SDL_Color color);
+
+        /** @brief Sorts everything submitted since begin() and draws it. */
+        void flush(SDL_Renderer* renderer);
+
+        /** @brief Bit i set = render layer i is drawn in screen pixels, not through the camera. */
+        void setScreenSpaceLayers(uint32_t mask) { m_ScreenSpaceLayers = mask; }
+        bool isScreenSpace(int layer) const { return layer >= 0 && layer < 32 && (m_ScreenSpaceLayers >> layer) & 1u; }
+        /** @brief Bit i set = render layer i is static, its sprites go through a StaticLayerCache. */
+        void setStaticLayers(uint32_t mask) { m_StaticLayers = mask; }
+        bool isStaticLayer(int layer) const { return layer >= 0 && layer < 32 && (m_StaticLayers >> layer) & 1u; }
+
+        size_t size() const { return m_Commands.size(); }
+        const RenderQueueStats& getStats() const { return m_Stats; }
+
+    private:
+        void sortItems();
+        void bindTexture(SDL_Renderer* renderer, SDL_Texture* texture);
+        void pushQuad(SDL_Renderer* renderer, const RenderCommand& command);
+        void pushGeometry(SDL_Renderer* renderer, const RenderCommand& command);
+        void flushBatch(SDL_Renderer* renderer);
+
+        std::vector<RenderCommand> m_Commands;
+        std::vector<RenderItem> m_Items;
+        std::vector<RenderItem> m_Scratch;
+        std::vector<size_t> m_RunStarts; // zaciatky zoradenych behov v m_Items pre sortItems
+        std::vector<size_t> m_MergedRuns;
+        std::vector<SDL_FPoint> m_Points;
+        std::vector<SDL_Vertex> m_GeometryVertices;
+
+        uint32_t m_ScreenSpaceLayers = 0;
+        uint32_t m_StaticLayers = 0;
+
+        std::vector<SDL_Vertex> m_Vertices;
+        std::vector<int> m_Indices;
+        SDL_Texture* m_BatchTexture = nullptr;
+        int m_BatchTextureW = 0;
+        int m_BatchTextureH = 0;
+
+        RenderQueueStats m_Stats;
+    };
+}
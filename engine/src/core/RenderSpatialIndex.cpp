@@ -0,0 +1,194 @@
+#include "RenderSpatialIndex.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Engine {
+
+    RenderSpatialIndex::RenderSpatialIndex(float cellSize)
+        : m_CellSize(cellSize > 0.0f ? cellSize : 256.0f)
+    {
+    }
+
+    void RenderSpatialIndex::TransformBounds(const Affine2D& world, const glm::vec2& halfSize, glm::vec2& min, glm::vec2& max)
+    {
+        // Staci posun a absolutne hodnoty 2x2 casti
+        glm::vec2 center = world.origin;
+        glm::vec2 extent = {std::abs(world.x.x) * halfSize.x + std::abs(world.y.x) * halfSize.y,
+                            std::abs(world.x.y) * halfSize.x + std::abs(world.y.y) * halfSize.y};
+        min = center - extent;
+        max = center + extent;
+    }
+
+    glm::ivec4 RenderSpatialIndex::cellRange(const glm::vec2& min, const glm::vec2& max) const
+    {
+        // Orezanie drzi aj extremne suradnice v rozsahu int
+        auto cell = [this](float v)
+        { return (int)std::floor(std::clamp(v / m_CellSize, -1.0e9f, 1.0e9f)); };
+        return {cell(min.x), cell(min.y), cell(max.x), cell(max.y)};
+    }
+
+    void RenderSpatialIndex::link(uint32_t slot)
+    {
+        Entry& entry = m_Entries[slot];
+        if (entry.oversized)
+        {
+            m_Oversized.push_back(slot);
+            return;
+        }
+        for (int y = entry.cells.y; y <= entry.cells.w; ++y)
+            for (int x = entry.cells.x; x <= entry.cells.z; ++x)
+                m_Cells[cellKey(x, y)].push_back(slot);
+    }
+
+    void RenderSpatialIndex::unlink(uint32_t slot)
+    {
+        const Entry& entry = m_Entries[slot];
+        if (entry.oversized)
+        {
+            m_Oversized.erase(std::find(m_Oversized.begin(), m_Oversized.end(), slot));
+            return;
+        }
+        for (int y = entry.cells.y; y <= entry.cells.w; ++y)
+        {
+            for (int x = entry.cells.x; x <= entry.cells.z; ++x)
+            {
+                auto it = m_Cells.find(cellKey(x, y));
+                if (it == m_Cells.end())
+                    continue;
+                auto& slots = it->second;
+                auto found = std::find(slots.begin(), slots.end(), slot);
+                if (found != slots.end())
+                {
+                    *found = slots.back();
+                    slots.pop_back();
+                }
+                if (slots.empty())
+                    m_Cells.erase(it);
+            }
+        }
+    }
+
+    void RenderSpatialIndex::update(Entity* entity, const glm::vec2& min, const glm::vec2& max, uint32_t userData)
+    {
+        glm::ivec4 cells = cellRange(min, max);
+        bool oversized = ((long long)cells.z - cells.x + 1) * ((long long)cells.w - cells.y + 1) > MaxCellSpan;
+
+        auto it = m_Slots.find(entity);
+        if (it != m_Slots.end())
+        {
+            Entry& entry = m_Entries[it->second];
+            entry.min = min;
+            entry.max = max;
+            entry.userData = userData;
+            // Vacsina entit zostava v tych istych bunkach, staci prepisat bounds
+            if (entry.oversized == oversized && (oversized || entry.cells == cells))
+                return;
+
+            unlink(it->second);
+            entry.cells = cells;
+            entry.oversized = oversized;
+            link(it->second);
+            return;
+        }
+
+        uint32_t slot;
+        if (!m_FreeSlots.empty())
+        {
+            slot = m_FreeSlots.back();
+            m_FreeSlots.pop_back();
+        }
+        else
+        {
+            slot = (uint32_t)m_Entries.size();
+            m_Entries.emplace_back();
+        }
+
+        Entry& entry = m_Entries[slot];
+        entry.entity = entity;
+        entry.min = min;
+        entry.max = max;
+        entry.userData = userData;
+        entry.cells = cells;
+        entry.oversized = oversized;
+        entry.queryMark = 0;
+        m_Slots[entity] = slot;
+        link(slot);
+    }
+
+    void RenderSpatialIndex::remove(Entity* entity)
+    {
+        auto it = m_Slots.find(entity);
+        if (it == m_Slots.end())
+            return;
+
+        uint32_t slot = it->second;
+        unlink(slot);
+        m_Entries[slot].entity = nullptr;
+        m_FreeSlots.push_back(slot);
+        m_Slots.erase(it);
+    }
+
+    void RenderSpatialIndex::clear()
+    {
+        m_Entries.clear();
+        m_FreeSlots.clear();
+        m_Slots.clear();
+        m_Cells.clear();
+        m_Oversized.clear();
+        m_QueryMark = 0;
+    }
+
+    void RenderSpatialIndex::query(const glm::vec2& min, const glm::vec2& max, std::vector<Hit>& out)
+    {
+        if (++m_QueryMark == 0)
+        {
+            for (auto& entry : m_Entries)
+                entry.queryMark = 0;
+            m_QueryMark = 1;
+        }
+
+        auto visit = [&](uint32_t slot)
+        {
+            Entry& entry = m_Entries[slot];
+            if (entry.queryMark == m_QueryMark)
+                return;
+            entry.queryMark = m_QueryMark;
+            if (entry.max.x < min.x || entry.min.x > max.x || entry.max.y < min.y || entry.min.y > max.y)
+                return;
+            out.push_back({entry.entity, entry.userData});
+        };
+
+        for (uint32_t slot : m_Oversized)
+            visit(slot);
+
+        glm::ivec4 cells = cellRange(min, max);
+        long long span = ((long long)cells.z - cells.x + 1) * ((long long)cells.w - cells.y + 1);
+
+        // Pri velkom oddialeni je lacnejsie prejst obsadene bunky nez vsetky pod kamerou
+        if (span > (long long)m_Cells.size())
+        {
+            for (const auto& [key, slots] : m_Cells)
+            {
+                int x = (int)(uint32_t)(key >> 32);
+                int y = (int)(uint32_t)key;
+                if (x < cells.x || x > cells.z || y < cells.y || y > cells.w)
+                    continue;
+                for (uint32_t slot : slots)
+                    visit(slot);
+            }
+            return;
+        }
+
+        for (int y = cells.y; y <= cells.w; ++y)
+        {
+            for (int x = cells.x; x <= cells.z; ++x)
+            {
+                auto it = m_Cells.find(cellKey(x, y));
+                if (it == m_Cells.end())
+                    continue;
+                for (uint32_t slot : it->second)
+                    visit(slot);
+            }
+        }
+    }
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "core/Transform2D.h"
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace Engine {
+
+    class Entity;
+
+    /**
+     * @brief Uniform grid of world AABBs for render culling.
+     * update() only touches the grid when an entity moves into other cells, so static and slowly moving
+     * sprites cost one compare per frame. query() visits just the cells under the camera rect.
+     * Entities larger than MaxCellSpan cells are kept in a separate list that every query checks.
+     */
+    class RenderSpatialIndex {
+    public:
+        struct Hit {
+            Entity* entity;
+            uint32_t userData;
+        };
+
+        explicit RenderSpatialIndex(float cellSize = 256.0f);
+
+        /**
+         * @brief Inserts the entity or moves it to its new bounds.
+         * @param userData returned with the entity by query(), e.g. its slot in the caller's frame list
+         */
+        void update(Entity* entity, const glm::vec2& min, const glm::vec2& max, uint32_t userData = 0);
+        void remove(Entity* entity);
+        void clear();
+
+        /** @brief Appends every entity whose bounds overlap [min, max] to out, each once. */
+        void query(const glm::vec2& min, const glm::vec2& max, std::vector<Hit>& out);
+
+        size_t size() const { return m_Slots.size(); }
+
+        /** @brief AABB of a quad of halfSize centered at the origin of the world transform. */
+        static void TransformBounds(const Affine2D& world, const glm::vec2& halfSize, glm::vec2& min, glm::vec2& max);
+
+    private:
+        static constexpr int MaxCellSpan = 64;
+
+        struct Entry {
+            Entity* entity = nullptr;
+            glm::vec2 min = {0.0f, 0.0f};
+            glm::vec2 max = {0.0f, 0.0f};
+            glm::ivec4 cells = {0, 0, -1, -1}; // x0, y0, x1, y1; empty when oversized
+            bool oversized = false;
+            uint32_t userData = 0;
+            uint32_t queryMark = 0;
+        };
+
+        glm::ivec4 cellRange(const glm::vec2& min, const glm::vec2& max) const;
+        void link(uint32_t slot);
+        void unlink(uint32_t slot);
+        static uint64_t cellKey(int x, int y) { return ((uint64_t)(uint32_t)x << 32) | (uint32_t)y; }
+
+        float m_CellSize;
+        std::vector<Entry> m_Entries;
+        std::vector<uint32_t> m_FreeSlots;
+        std::unordered_map<Entity*, uint32_t> m_Slots;
+        std::unordered_map<uint64_t, std::vector<uint32_t>> m_Cells;
+        std::vector<uint32_t> m_Oversized;
+        uint32_t m_QueryMark = 0;
+    };
+}
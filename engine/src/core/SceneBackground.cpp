@@ -0,0 +1,120 @@
+#include "SceneBackground.h"
+#include "core/AssetManager.h"
+#include <algorithm>
+
+namespace Engine {
+
+    static SDL_Color ToColor(const glm::vec4& color)
+    {
+        return {(Uint8)(color.r * 255), (Uint8)(color.g * 255), (Uint8)(color.b * 255), 255};
+    }
+
+    void SceneBackground::draw(SDL_Renderer* renderer, const BackgroundSettings& settings, int width, int height)
+    {
+        if (!renderer || width <= 0 || height <= 0)
+            return;
+        if (!isCurrent(settings, width, height))
+            rebuild(settings, width, height);
+
+        SDL_SetRenderDrawColor(renderer, m_ClearColor.r, m_ClearColor.g, m_ClearColor.b, m_ClearColor.a);
+        SDL_RenderClear(renderer);
+        if (!m_Indices.empty())
+        {
+            SDL_RenderGeometry(renderer, m_Texture, m_Vertices.data(), (int)m_Vertices.size(), m_Indices.data(),
+                               (int)m_Indices.size());
+        }
+    }
+
+    bool SceneBackground::isCurrent(const BackgroundSettings& settings, int width, int height) const
+    {
+        if (!m_Built || m_Width != width || m_Height != height || m_Settings.type != settings.type)
+            return false;
+
+        switch (settings.type)
+        {
+        case BackgroundType::Solid:
+            return m_Settings.color1 == settings.color1;
+        case BackgroundType::Gradient:
+            return m_Settings.color1 == settings.color1 && m_Settings.color2 == settings.color2;
+        case BackgroundType::Image:
+            // Obrazok sa mohol nacitat, presunut v atlase alebo zmazat
+            return m_Settings.assetId == settings.assetId && m_Settings.stretch == settings.stretch &&
+                   m_AtlasVersion == AssetManager::getAtlasVersion();
+        }
+        return false;
+    }
+
+    void SceneBackground::rebuild(const BackgroundSettings& settings, int width, int height)
+    {
+        m_Built = true;
+        m_Settings = settings;
+        m_Width = width;
+        m_Height = height;
+        m_AtlasVersion = AssetManager::getAtlasVersion();
+        m_Texture = nullptr;
+        m_Vertices.clear();
+        m_Indices.clear();
+
+        SDL_FRect target = {0.0f, 0.0f, (float)width, (float)height};
+        const SDL_Color white = {255, 255, 255, 255};
+
+        if (settings.type == BackgroundType::Solid)
+        {
+            m_ClearColor = ToColor(settings.color1);
+        }
+        else if (settings.type == BackgroundType::Gradient)
+        {
+            // Farby sa interpoluju medzi vrcholmi, netreba kreslit kazdy riadok
+            m_ClearColor = ToColor(settings.color1);
+            pushQuad(target, {0.0f, 0.0f}, {0.0f, 0.0f}, ToColor(settings.color1), ToColor(settings.color2));
+        }
+        else if (settings.type == BackgroundType::Image)
+        {
+            TextureRegion region;
+            int textureW = 0, textureH = 0;
+            if (!AssetManager::getTextureRegion(settings.assetId, region) || region.rect.w <= 0 || region.rect.h <= 0 ||
+                SDL_QueryTexture(region.texture, nullptr, nullptr, &textureW, &textureH) != 0)
+            {
+                m_ClearColor = {30, 30, 45, 255};
+                return;
+            }
+
+            m_ClearColor = {0, 0, 0, 255};
+            m_Texture = region.texture;
+            const SDL_Rect& rect = region.rect;
+            SDL_FPoint uv0 = {rect.x / (float)textureW, rect.y / (float)textureH};
+
+            if (settings.stretch)
+            {
+                SDL_FPoint uv1 = {(rect.x + rect.w) / (float)textureW, (rect.y + rect.h) / (float)textureH};
+                pushQuad(target, uv0, uv1, white, white);
+                return;
+            }
+
+            // Dlazdice na pravom a dolnom okraji su orezane, nie zmensene
+            for (int y = 0; y < height; y += rect.h)
+            {
+                for (int x = 0; x < width; x += rect.w)
+                {
+                    int w = std::min(rect.w, width - x);
+                    int h = std::min(rect.h, height - y);
+                    SDL_FRect dest = {(float)x, (float)y, (float)w, (float)h};
+                    SDL_FPoint uv1 = {(rect.x + w) / (float)textureW, (rect.y + h) / (float)textureH};
+                    pushQuad(dest, uv0, uv1, white, white);
+                }
+            }
+        }
+    }
+
+    void SceneBackground::pushQuad(const SDL_FRect& dest, const SDL_FPoint& uv0, const SDL_FPoint& uv1, SDL_Color top,
+                                   SDL_Color bottom)
+    {
+        int base = (int)m_Vertices.size();
+        m_Vertices.push_back({{dest.x, dest.y}, top, {uv0.x, uv0.y}});
+        m_Vertices.push_back({{dest.x + dest.w, dest.y}, top, {uv1.x, uv0.y}});
+        m_Vertices.push_back({{dest.x + dest.w, dest.y + dest.h}, bottom, {uv1.x, uv1.y}});
+        m_Vertices.push_back({{dest.x, dest.y + dest.h}, bottom, {uv0.x, uv1.y}});
+        for (int index : {0, 1, 2, 0, 2, 3})
+            m_Indices.push_back(base + index);
+    }
+}
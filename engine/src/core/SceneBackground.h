@@ -0,0 +1,54 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Engine {
+
+    enum class BackgroundType {
+        Solid, Gradient, Image
+    };
+
+    struct BackgroundSettings {
+        BackgroundType type = BackgroundType::Solid;
+
+        glm::vec4 color1 = {30 / 255.0f, 30 / 255.0f, 30 / 255.0f, 1.0f}; // gradient: top edge
+        glm::vec4 color2 = {10 / 255.0f, 10 / 255.0f, 10 / 255.0f, 1.0f}; // gradient: bottom edge
+
+        std::string assetId = "";
+        bool stretch = true; // image: stretched over the target, otherwise tiled from the top left corner
+    };
+
+    /**
+     * @brief Draws a scene's BackgroundSettings over the whole render target, shared by the runtime and the editor.
+     * A gradient is one two-color quad and a tiled image is all its tiles in one SDL_RenderGeometry call.
+     * The vertices are built once and reused until the settings, the target size or the atlas change,
+     * so a frame costs one clear and at most one draw call.
+     */
+    class SceneBackground {
+    public:
+        void draw(SDL_Renderer* renderer, const BackgroundSettings& settings, int width, int height);
+
+        /** @brief Forces a rebuild on the next draw. */
+        void invalidate() { m_Built = false; }
+
+    private:
+        bool isCurrent(const BackgroundSettings& settings, int width, int height) const;
+        void rebuild(const BackgroundSettings& settings, int width, int height);
+        void pushQuad(const SDL_FRect& dest, const SDL_FPoint& uv0, const SDL_FPoint& uv1, SDL_Color top, SDL_Color bottom);
+
+        bool m_Built = false;
+        BackgroundSettings m_Settings;
+        int m_Width = 0;
+        int m_Height = 0;
+        uint32_t m_AtlasVersion = 0;
+
+        SDL_Color m_ClearColor = {0, 0, 0, 255};
+        SDL_Texture* m_Texture = nullptr; // texture the vertices sample, owned by AssetManager
+        std::vector<SDL_Vertex> m_Vertices;
+        std::vector<int> m_Indices;
+    };
+}
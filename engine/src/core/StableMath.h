@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cmath>
+
+namespace Engine {
+    /**
+     * @brief Matematika pre fyziku, ktora dava rovnake bity na kazdej platforme.
+     * std::sin/std::cos su v kazdej libm implementovane inak, tu su len +, *, floor a fmod
+     * (IEEE ich definuje presne). Engine sa kompiluje bez FMA kontrakcii, vid engine/CMakeLists.txt.
+     */
+    namespace StableMath {
+        /** @brief sin a cos uhla v stupnoch. Nasobky 90 stupnov su presne, inak chyba okolo 1e-7. */
+        inline void SinCosDegrees(float degrees, float& outSin, float& outCos) {
+            float d = std::fmod(degrees, 360.0f);
+            if (d > 180.0f) d -= 360.0f;
+            if (d < -180.0f) d += 360.0f;
+
+            // Kvadrant a zvysok v [-45, 45], tam Taylor konverguje rychlo
+            float quadrant = std::floor(d / 90.0f + 0.5f);
+            float x = (d - quadrant * 90.0f) * 0.017453292519943295f;
+            float x2 = x * x;
+
+            float s = x * (1.0f + x2 * (-1.0f / 6.0f + x2 * (1.0f / 120.0f + x2 * (-1.0f / 5040.0f + x2 * (1.0f / 362880.0f)))));
+            float c = 1.0f + x2 * (-0.5f + x2 * (1.0f / 24.0f + x2 * (-1.0f / 720.0f + x2 * (1.0f / 40320.0f + x2 * (-1.0f / 3628800.0f)))));
+
+            switch (static_cast<int>(quadrant)) {
+            case 1:
+                outSin = c;
+                outCos = -s;
+                break;
+            case -1:
+                outSin = -c;
+                outCos = s;
+                break;
+            case 2:
+            case -2:
+                outSin = -s;
+                outCos = -c;
+                break;
+            default:
+                outSin = s;
+                outCos = c;
+                break;
+            }
+        }
+    }
+}
@@ -0,0 +1,273 @@
+#include "StaticLayerCache.h"
+#include "core/Log.h"
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+namespace Engine {
+
+    // Textura chunku ma farbu uz prenasobenu alfou, skladanie musi alfu znova nenasobit
+    static SDL_BlendMode PremultipliedBlendMode()
+    {
+        static const SDL_BlendMode mode = SDL_ComposeCustomBlendMode(
+            SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD,
+            SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD);
+        return mode;
+    }
+
+    StaticLayerCache::~StaticLayerCache()
+    {
+        clear();
+    }
+
+    uint64_t StaticLayerCache::ChunkKey(int layer, int x, int y)
+    {
+        // 4 bity vrstva, po 30 bitov posunute suradnice
+        constexpr uint32_t mask = (1u << 30) - 1;
+        uint64_t bx = ((uint32_t)x + (1u << 29)) & mask;
+        uint64_t by = ((uint32_t)y + (1u << 29)) & mask;
+        return ((uint64_t)(layer & 0xF) << 60) | (bx << 30) | by;
+    }
+
+    void StaticLayerCache::invalidate(int layer, const glm::vec2& min, const glm::vec2& max)
+    {
+        if (m_ChunkWorldSize.x <= 0.0f || m_ChunkWorldSize.y <= 0.0f)
+            return;
+
+        int x0 = (int)std::floor(min.x / m_ChunkWorldSize.x);
+        int y0 = (int)std::floor(min.y / m_ChunkWorldSize.y);
+        int x1 = (int)std::floor(max.x / m_ChunkWorldSize.x);
+        int y1 = (int)std::floor(max.y / m_ChunkWorldSize.y);
+        for (int y = y0; y <= y1; ++y)
+        {
+            for (int x = x0; x <= x1; ++x)
+            {
+                auto it = m_Chunks.find(ChunkKey(layer, x, y));
+                if (it != m_Chunks.end())
+                    it->second.dirty = true;
+            }
+        }
+    }
+
+    void StaticLayerCache::invalidateAll()
+    {
+        for (auto& [key, chunk] : m_Chunks)
+            chunk.dirty = true;
+    }
+
+    void StaticLayerCache::updateScale(const Affine2D& worldToScreen)
+    {
+        glm::vec2 scale = {glm::length(worldToScreen.x), glm::length(worldToScreen.y)};
+        bool changed = std::abs(scale.x - m_Scale.x) > m_Scale.x * 1e-4f ||
+                       std::abs(scale.y - m_Scale.y) > m_Scale.y * 1e-4f;
+        if (!changed)
+            return;
+
+        // Textury su v pixeloch ciela, pri inom zoome su vsetky neplatne
+        for (auto& [key, chunk] : m_Chunks)
+            releaseTexture(chunk.texture);
+        m_Chunks.clear();
+
+        m_Scale = scale;
+        m_ChunkWorldSize = {0.0f, 0.0f};
+        if (scale.x > 0.0f && scale.y > 0.0f)
+            m_ChunkWorldSize = glm::vec2((float)ChunkPixels) / scale;
+    }
+
+    bool StaticLayerCache::submitLayer(RenderQueue& queue, SDL_Renderer* renderer, const Affine2D& worldToScreen,
+                                       int layer, const glm::vec2& viewMin, const glm::vec2& viewMax,
+                                       const GatherFn& gather)
+    {
+        if (!renderer || !gather)
+            return false;
+        updateScale(worldToScreen);
+        if (m_ChunkWorldSize.x <= 0.0f || m_ChunkWorldSize.y <= 0.0f)
+            return false;
+
+        int x0 = (int)std::floor(viewMin.x / m_ChunkWorldSize.x);
+        int y0 = (int)std::floor(viewMin.y / m_ChunkWorldSize.y);
+        int x1 = (int)std::floor(viewMax.x / m_ChunkWorldSize.x);
+        int y1 = (int)std::floor(viewMax.y / m_ChunkWorldSize.y);
+        uint32_t bit = 1u << layer;
+        if ((int64_t)(x1 - x0 + 1) * (y1 - y0 + 1) > (int64_t)MaxChunks)
+        {
+            // Pri tomto zoome by sa chunky nezmestili do rozpoctu; nemalo by nastat, chunk ma velkost v pixeloch ciela
+            if (!(m_UncachedLayers & bit))
+                Log::warn("static layer " + std::to_string(layer) + " view needs too many chunks, drawn without the cache");
+            m_UncachedLayers |= bit;
+            return false;
+        }
+
+        // Najprv sa prekreslia vsetky chunky, aby sa pri chybe nepodala len cast vrstvy
+        for (int y = y0; y <= y1; ++y)
+        {
+            for (int x = x0; x <= x1; ++x)
+            {
+                glm::vec2 min = glm::vec2((float)x, (float)y) * m_ChunkWorldSize;
+                Chunk& chunk = m_Chunks[ChunkKey(layer, x, y)];
+                chunk.lastUsed = m_Frame;
+                if (chunk.dirty)
+                    redraw(chunk, renderer, layer, min, min + m_ChunkWorldSize, gather);
+                if (chunk.dirty)
+                {
+                    m_UncachedLayers |= bit;
+                    return false;
+                }
+            }
+        }
+        m_UncachedLayers &= ~bit;
+
+        glm::vec2 half = m_ChunkWorldSize * 0.5f;
+        uint32_t index = 0;
+        for (int y = y0; y <= y1; ++y)
+        {
+            for (int x = x0; x <= x1; ++x)
+            {
+                const Chunk& chunk = m_Chunks[ChunkKey(layer, x, y)];
+                if (!chunk.texture)
+                    continue;
+                glm::vec2 min = glm::vec2((float)x, (float)y) * m_ChunkWorldSize;
+
+                // Horny okraj textury je vo svete +y
+                ScreenQuad quad;
+                quad.center = worldToScreen.apply(min + half);
+                quad.axisU = worldToScreen.x * half.x;
+                quad.axisV = worldToScreen.y * -half.y;
+
+                // Pod vsetkym ostatnym vo vrstve (text, tilemapy), chunky sa neprekryvaju
+                uint64_t key = RenderSortKey::Pack((uint32_t)layer, INT16_MIN, 0, 0, index++);
+                queue.submitQuad(key, chunk.texture, {0, 0, 0, 0}, {0, 0, ChunkPixels, ChunkPixels}, quad,
+                                 SDL_FLIP_NONE, {255, 255, 255, 255});
+                m_Stats.chunks++;
+            }
+        }
+        return true;
+    }
+
+    void StaticLayerCache::redraw(Chunk& chunk, SDL_Renderer* renderer, int layer, const glm::vec2& min,
+                                  const glm::vec2& max, const GatherFn& gather)
+    {
+        chunk.dirty = false;
+        m_Stats.redrawn++;
+
+        m_Sprites.clear();
+        gather(layer, min, max, m_Sprites);
+        if (m_Sprites.empty())
+        {
+            releaseTexture(chunk.texture);
+            chunk.texture = nullptr;
+            return;
+        }
+
+        if (!chunk.texture)
+        {
+            if (!m_FreeTextures.empty())
+            {
+                chunk.texture = m_FreeTextures.back();
+                m_FreeTextures.pop_back();
+            }
+            else
+            {
+                chunk.texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET,
+                                                  ChunkPixels, ChunkPixels);
+                if (!chunk.texture)
+                {
+                    Log::error(std::string("static layer chunk texture failed: ") + SDL_GetError());
+                    chunk.dirty = true;
+                    return;
+                }
+                if (SDL_SetTextureBlendMode(chunk.texture, PremultipliedBlendMode()) != 0)
+                    SDL_SetTextureBlendMode(chunk.texture, SDL_BLENDMODE_BLEND);
+                // Chunk sa kresli 1:1, nearest nenecha na okrajoch susednych chunkov presvitat priehladny lem
+                SDL_SetTextureScaleMode(chunk.texture, SDL_ScaleModeNearest);
+                m_Stats.textures++;
+            }
+        }
+
+        // Svet -> pixely chunku, riadok 0 je horny okraj (max.y)
+        Affine2D toChunk;
+        toChunk.x = {m_Scale.x, 0.0f};
+        toChunk.y = {0.0f, -m_Scale.y};
+        toChunk.origin = {-min.x * m_Scale.x, max.y * m_Scale.y};
+
+        size_t count = m_Sprites.size();
+        m_World.resize(count);
+        m_HalfSizes.resize(count);
+        m_Quads.resize(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            m_World[i] = m_Sprites[i].world;
+            m_HalfSizes[i] = m_Sprites[i].halfSize;
+        }
+        ProjectQuads(toChunk, m_World.data(), m_HalfSizes.data(), count, m_Quads.data());
+
+        m_ChunkQueue.begin();
+        for (size_t i = 0; i < count; ++i)
+        {
+            const Sprite& sprite = m_Sprites[i];
+            m_ChunkQueue.submitQuad(sprite.key, sprite.texture, sprite.region, sprite.src, m_Quads[i], sprite.flip,
+                                    sprite.color);
+        }
+
+        SDL_Texture* previous = SDL_GetRenderTarget(renderer);
+        SDL_SetRenderTarget(renderer, chunk.texture);
+        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+        SDL_RenderClear(renderer);
+        m_ChunkQueue.flush(renderer);
+        SDL_SetRenderTarget(renderer, previous);
+    }
+
+    void StaticLayerCache::endFrame()
+    {
+        if (m_Chunks.size() > MaxChunks)
+        {
+            // Najdlhsie nepouzite chunky idu prec, tie z tohto framu ostavaju
+            std::vector<std::pair<uint64_t, uint64_t>> unused;
+            for (const auto& [key, chunk] : m_Chunks)
+            {
+                if (chunk.lastUsed != m_Frame)
+                    unused.push_back({chunk.lastUsed, key});
+            }
+            std::sort(unused.begin(), unused.end());
+
+            size_t excess = std::min(m_Chunks.size() - MaxChunks, unused.size());
+            for (size_t i = 0; i < excess; ++i)
+            {
+                auto it = m_Chunks.find(unused[i].second);
+                releaseTexture(it->second.texture);
+                m_Chunks.erase(it);
+            }
+        }
+
+        // Volne textury nad rozpocet sa nedrzia
+        while (!m_FreeTextures.empty() && m_Chunks.size() + m_FreeTextures.size() > MaxChunks)
+        {
+            SDL_DestroyTexture(m_FreeTextures.back());
+            m_FreeTextures.pop_back();
+            m_Stats.textures--;
+        }
+        m_Frame++;
+    }
+
+    void StaticLayerCache::releaseTexture(SDL_Texture* texture)
+    {
+        if (texture)
+            m_FreeTextures.push_back(texture);
+    }
+
+    void StaticLayerCache::clear()
+    {
+        for (auto& [key, chunk] : m_Chunks)
+        {
+            if (chunk.texture)
+                SDL_DestroyTexture(chunk.texture);
+        }
+        m_Chunks.clear();
+        for (SDL_Texture* texture : m_FreeTextures)
+            SDL_DestroyTexture(texture);
+        m_FreeTextures.clear();
+        m_Scale = {0.0f, 0.0f};
+        m_ChunkWorldSize = {0.0f, 0.0f};
+        m_Stats.textures = 0;
+    }
+}
@@ -0,0 +1,112 @@
+#pragma once
+
+#include "core/RenderQueue.h"
+#include "core/Transform2D.h"
+#include <SDL2/SDL.h>
+#include <glm/glm.hpp>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+namespace Engine {
+
+    /**
+     * @brief Sprites of static render layers composited into world-aligned chunk textures.
+     *
+     * The world is cut into squares that cover ChunkPixels target pixels at the current zoom. Each visible
+     * chunk of a static layer is a SDL_TEXTUREACCESS_TARGET texture holding all its sprites, drawn once and
+     * then submitted as a single quad, so thousands of decoration sprites cost a few quads per frame.
+     * A chunk is redrawn only after invalidate() touched it; a zoom change drops every chunk, since the
+     * textures are in target pixels. Camera movement and rotation only move the chunk quads.
+     * Textures hold premultiplied color and are drawn with a matching blend mode, so soft edges stay correct.
+     */
+    class StaticLayerCache {
+    public:
+        static constexpr int ChunkPixels = 512;
+        static constexpr size_t MaxChunks = 96; // least recently drawn chunks above this give their texture back
+
+        /** @brief One sprite to composite, in world space like the RendererSystem batch. */
+        struct Sprite {
+            uint64_t key; // order inside the chunk
+            SDL_Texture* texture;
+            SDL_Rect region;
+            SDL_Rect src;
+            Affine2D world;
+            glm::vec2 halfSize;
+            SDL_RendererFlip flip;
+            SDL_Color color;
+        };
+
+        /** @brief Appends the sprites of layer overlapping [min, max] to out. */
+        using GatherFn = std::function<void(int layer, const glm::vec2& min, const glm::vec2& max, std::vector<Sprite>& out)>;
+
+        struct Stats {
+            int chunks = 0;   // chunk quads submitted
+            int redrawn = 0;  // chunks composited again this frame
+            int textures = 0; // chunk textures alive
+        };
+
+        StaticLayerCache() = default;
+        ~StaticLayerCache();
+
+        StaticLayerCache(const StaticLayerCache&) = delete;
+        StaticLayerCache& operator=(const StaticLayerCache&) = delete;
+
+        /** @brief Marks the chunks of layer overlapping the world rect for redraw. */
+        void invalidate(int layer, const glm::vec2& min, const glm::vec2& max);
+        void invalidateAll();
+
+        /**
+         * @brief Redraws the dirty chunks of layer overlapping the view and submits one quad per chunk.
+         * Has to run on the renderer's thread; the current render target is restored afterwards.
+         * @return false if the layer could not be drawn from chunks (view needs more than MaxChunks, a chunk
+         * texture could not be created); nothing was submitted and the caller draws the sprites itself
+         */
+        bool submitLayer(RenderQueue& queue, SDL_Renderer* renderer, const Affine2D& worldToScreen, int layer,
+                         const glm::vec2& viewMin, const glm::vec2& viewMax, const GatherFn& gather);
+
+        /** @brief Frees chunks not drawn this frame above MaxChunks; call once after all layers were submitted. */
+        void endFrame();
+
+        /** @brief Destroys every chunk texture. */
+        void clear();
+
+        const Stats& getStats() const { return m_Stats; }
+        /** @brief Zeroes the per-frame counters; textures keeps counting live textures. */
+        void resetStats()
+        {
+            int textures = m_Stats.textures;
+            m_Stats = Stats();
+            m_Stats.textures = textures;
+        }
+
+    private:
+        struct Chunk {
+            SDL_Texture* texture = nullptr; // null while the chunk has no sprites
+            bool dirty = true;
+            uint64_t lastUsed = 0;
+        };
+
+        static uint64_t ChunkKey(int layer, int x, int y);
+        void updateScale(const Affine2D& worldToScreen);
+        void redraw(Chunk& chunk, SDL_Renderer* renderer, int layer, const glm::vec2& min, const glm::vec2& max,
+                    const GatherFn& gather);
+        void releaseTexture(SDL_Texture* texture);
+
+        std::unordered_map<uint64_t, Chunk> m_Chunks;
+        std::vector<SDL_Texture*> m_FreeTextures;
+        glm::vec2 m_Scale = {0.0f, 0.0f}; // target pixels per world unit the chunks were drawn at
+        glm::vec2 m_ChunkWorldSize = {0.0f, 0.0f};
+        uint64_t m_Frame = 0;
+        uint32_t m_UncachedLayers = 0; // layers whose last submitLayer failed, warned once until they recover
+
+        // Scratch pre skladanie jedneho chunku
+        RenderQueue m_ChunkQueue;
+        std::vector<Sprite> m_Sprites;
+        std::vector<Affine2D> m_World;
+        std::vector<glm::vec2> m_HalfSizes;
+        std::vector<ScreenQuad> m_Quads;
+
+        Stats m_Stats;
+    };
+}
@@ -0,0 +1,306 @@
+#include "TextureAtlas.h"
+#include "core/Log.h"
+#include "SDL_image.h"
+#include <SDL2/SDL.h>
+#include <algorithm>
+#include <cctype>
+#include <climits>
+#include <fstream>
+#include <nlohmann/json.hpp>
+
+namespace fs = std::filesystem;
+using json = nlohmann::json;
+
+namespace Engine {
+
+    AtlasPacker::AtlasPacker(int width, int height, int padding)
+        : m_Width(width), m_Height(height), m_Padding(padding)
+    {
+        if (width > 0)
+            m_Skyline.push_back({0, 0, width});
+    }
+
+    // Top of the skyline under a w-wide rect starting at segment `index`, -1 if it does not fit there
+    int AtlasPacker::fitAt(size_t index, int w, int h) const
+    {
+        int x = m_Skyline[index].x;
+        if (x + w > m_Width)
+            return -1;
+
+        int y = 0;
+        int remaining = w;
+        for (size_t i = index; remaining > 0; ++i)
+        {
+            if (i >= m_Skyline.size())
+                return -1;
+            y = std::max(y, m_Skyline[i].y);
+            if (y + h > m_Height)
+                return -1;
+            remaining -= m_Skyline[i].w;
+        }
+        return y;
+    }
+
+    bool AtlasPacker::insert(int w, int h, AtlasRect& out)
+    {
+        if (w <= 0 || h <= 0)
+            return false;
+
+        // The last column/row needs no padding behind it
+        int paddedW = std::min(w + m_Padding, m_Width);
+        int paddedH = std::min(h + m_Padding, m_Height);
+        if (w > m_Width || h > m_Height)
+            return false;
+        if (insertFree(w, h, out))
+            return true;
+
+        // Bottom-left rule: lowest resulting top edge, then the narrowest segment
+        int bestTop = INT_MAX;
+        int bestWidth = INT_MAX;
+        int bestY = 0;
+        size_t bestIndex = m_Skyline.size();
+        for (size_t i = 0; i < m_Skyline.size(); ++i)
+        {
+            int y = fitAt(i, paddedW, paddedH);
+            if (y < 0)
+                continue;
+            if (y + paddedH < bestTop || (y + paddedH == bestTop && m_Skyline[i].w < bestWidth))
+            {
+                bestTop = y + paddedH;
+                bestWidth = m_Skyline[i].w;
+                bestY = y;
+                bestIndex = i;
+            }
+        }
+        if (bestIndex == m_Skyline.size())
+            return false;
+
+        int x = m_Skyline[bestIndex].x;
+        m_Skyline.insert(m_Skyline.begin() + bestIndex, {x, bestTop, paddedW});
+
+        // Segments now covered by the new one shrink or disappear
+        for (size_t i = bestIndex + 1; i < m_Skyline.size();)
+        {
+            int coveredTo = m_Skyline[i - 1].x + m_Skyline[i - 1].w;
+            if (m_Skyline[i].x >= coveredTo)
+                break;
+
+            int shrink = coveredTo - m_Skyline[i].x;
+            m_Skyline[i].x += shrink;
+            m_Skyline[i].w -= shrink;
+            if (m_Skyline[i].w > 0)
+                break;
+            m_Skyline.erase(m_Skyline.begin() + i);
+        }
+
+        for (size_t i = 0; i + 1 < m_Skyline.size();)
+        {
+            if (m_Skyline[i].y == m_Skyline[i + 1].y)
+            {
+                m_Skyline[i].w += m_Skyline[i + 1].w;
+                m_Skyline.erase(m_Skyline.begin() + i + 1);
+            }
+            else
+            {
+                ++i;
+            }
+        }
+
+        out = {x, bestY, w, h};
+        m_UsedArea += (long long)w * h;
+        ++m_RectCount;
+        return true;
+    }
+
+    // Smallest released rect that holds w x h plus padding (none needed at the page edge)
+    bool AtlasPacker::insertFree(int w, int h, AtlasRect& out)
+    {
+        size_t best = m_FreeRects.size();
+        long long bestArea = LLONG_MAX;
+        for (size_t i = 0; i < m_FreeRects.size(); ++i)
+        {
+            const AtlasRect& free = m_FreeRects[i];
+            bool fitsW = w + m_Padding <= free.w || (w <= free.w && free.x + free.w >= m_Width);
+            bool fitsH = h + m_Padding <= free.h || (h <= free.h && free.y + free.h >= m_Height);
+            long long area = (long long)free.w * free.h;
+            if (fitsW && fitsH && area < bestArea)
+            {
+                best = i;
+                bestArea = area;
+            }
+        }
+        if (best == m_FreeRects.size())
+            return false;
+
+        AtlasRect free = m_FreeRects[best];
+        m_FreeRects.erase(m_FreeRects.begin() + best);
+        int usedW = std::min(w + m_Padding, free.w);
+        int usedH = std::min(h + m_Padding, free.h);
+
+        // Zvysok sa deli na pas vpravo (vyska obrazka) a pas pod nim (cela sirka)
+        if (free.w > usedW)
+            m_FreeRects.push_back({free.x + usedW, free.y, free.w - usedW, usedH});
+        if (free.h > usedH)
+            m_FreeRects.push_back({free.x, free.y + usedH, free.w, free.h - usedH});
+
+        out = {free.x, free.y, w, h};
+        m_UsedArea += (long long)w * h;
+        ++m_RectCount;
+        return true;
+    }
+
+    void AtlasPacker::release(const AtlasRect& rect)
+    {
+        if (rect.w <= 0 || rect.h <= 0 || m_RectCount <= 0)
+            return;
+
+        m_UsedArea -= (long long)rect.w * rect.h;
+        if (--m_RectCount == 0)
+        {
+            // Prazdna stranka: skyline aj volne miesto od zaciatku
+            m_Skyline.assign(1, {0, 0, m_Width});
+            m_FreeRects.clear();
+            m_UsedArea = 0;
+            return;
+        }
+        m_FreeRects.push_back({rect.x, rect.y, std::min(rect.w + m_Padding, m_Width - rect.x),
+                               std::min(rect.h + m_Padding, m_Height - rect.y)});
+    }
+
+    float AtlasPacker::getOccupancy() const
+    {
+        if (m_Width <= 0 || m_Height <= 0)
+            return 0.0f;
+        return (float)((double)m_UsedArea / ((double)m_Width * m_Height));
+    }
+
+    namespace TextureAtlas {
+
+        bool IsImageExtension(std::string extension)
+        {
+            std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+            return extension == ".png" || extension == ".jpg" || extension == ".jpeg" || extension == ".tga" || extension == ".bmp";
+        }
+
+        bool PackDirectory(const fs::path& assetsRoot)
+        {
+            struct Source {
+                fs::path path;
+                std::string assetId;
+                SDL_Surface* surface;
+            };
+
+            std::vector<Source> sources;
+            for (const auto& entry : fs::recursive_directory_iterator(assetsRoot))
+            {
+                if (!entry.is_regular_file() || !IsImageExtension(entry.path().extension().string()))
+                    continue;
+
+                SDL_Surface* surface = IMG_Load(entry.path().string().c_str());
+                if (!surface)
+                {
+                    Log::warn("Atlas: cannot load " + entry.path().string() + ", left as a separate file | " + IMG_GetError());
+                    continue;
+                }
+                if (surface->w > MaxPackedSize || surface->h > MaxPackedSize)
+                {
+                    SDL_FreeSurface(surface);
+                    continue;
+                }
+
+                // Rovnake ID ako AssetManager v editore: cesta relativna k assets
+                sources.push_back({entry.path(), fs::relative(entry.path(), assetsRoot).string(), surface});
+            }
+
+            if (sources.empty())
+                return true;
+
+            // Najvyssie prve; ID na koniec, aby rovnake assety dali vzdy rovnake stranky
+            std::sort(sources.begin(), sources.end(), [](const Source& a, const Source& b)
+                      {
+                if (a.surface->h != b.surface->h)
+                    return a.surface->h > b.surface->h;
+                if (a.surface->w != b.surface->w)
+                    return a.surface->w > b.surface->w;
+                return a.assetId < b.assetId; });
+
+            std::vector<AtlasPacker> packers;
+            std::vector<SDL_Surface*> pages;
+            json regions = json::object();
+            bool ok = true;
+
+            for (auto& source : sources)
+            {
+                AtlasRect rect;
+                size_t page = 0;
+                while (page < packers.size() && !packers[page].insert(source.surface->w, source.surface->h, rect))
+                    ++page;
+
+                if (page == packers.size())
+                {
+                    SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(0, PageSize, PageSize, 32, SDL_PIXELFORMAT_RGBA32);
+                    if (!surface)
+                    {
+                        Log::error(std::string("Atlas: cannot create page surface | ") + SDL_GetError());
+                        ok = false;
+                        break;
+                    }
+                    SDL_FillRect(surface, nullptr, 0);
+                    pages.push_back(surface);
+                    packers.emplace_back(PageSize, PageSize, Padding);
+                    packers.back().insert(source.surface->w, source.surface->h, rect);
+                }
+
+                // Kopia vratane alfy, bez miesania s prazdnou strankou
+                SDL_SetSurfaceBlendMode(source.surface, SDL_BLENDMODE_NONE);
+                SDL_Rect dest = {rect.x, rect.y, rect.w, rect.h};
+                SDL_BlitSurface(source.surface, nullptr, pages[page], &dest);
+
+                regions[source.assetId] = {{"Page", page}, {"Rect", {rect.x, rect.y, rect.w, rect.h}}};
+            }
+
+            json manifest;
+            manifest["Version"] = 1;
+            manifest["Pages"] = json::array();
+            for (size_t i = 0; ok && i < pages.size(); ++i)
+            {
+                std::string pageName = "texture_atlas_" + std::to_string(i) + ".png";
+                if (IMG_SavePNG(pages[i], (assetsRoot / pageName).string().c_str()) != 0)
+                {
+                    Log::error("Atlas: cannot write " + pageName + " | " + IMG_GetError());
+                    ok = false;
+                }
+                manifest["Pages"].push_back(pageName);
+            }
+            manifest["Regions"] = regions;
+
+            for (auto* page : pages)
+                SDL_FreeSurface(page);
+            for (auto& source : sources)
+                SDL_FreeSurface(source.surface);
+
+            if (!ok)
+                return false;
+
+            std::ofstream file(assetsRoot / ManifestFile);
+            if (!file.is_open())
+            {
+                Log::error("Atlas: cannot write the manifest to " + assetsRoot.string());
+                return false;
+            }
+            file << manifest.dump(2);
+            file.close();
+
+            // Zabalene obrazky uz v exporte netreba, runtime ich bere zo stranok
+            for (const auto& source : sources)
+                fs::remove(source.path);
+
+            float occupancy = 0.0f;
+            for (const auto& packer : packers)
+                occupancy += packer.getOccupancy();
+            Log::info("Atlas: packed " + std::to_string(sources.size()) + " textures into " + std::to_string(pages.size()) +
+                      " pages, " + std::to_string((int)(occupancy / pages.size() * 100.0f)) + "% used");
+            return true;
+        }
+    }
+}
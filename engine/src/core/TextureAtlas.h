@@ -0,0 +1,82 @@
+#pragma once
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace Engine {
+
+    /** @brief Placement of one image inside an atlas page, in page pixels. */
+    struct AtlasRect {
+        int x = 0;
+        int y = 0;
+        int w = 0;
+        int h = 0;
+    };
+
+    /**
+     * @brief Skyline rectangle packer for one atlas page.
+     * Rects can be added one at a time (editor loads textures on demand), the build
+     * feeds them tallest first, which packs noticeably tighter.
+     * Released rects go to a free list that later inserts try first; once every rect is released
+     * the page starts over empty.
+     */
+    class AtlasPacker {
+    public:
+        AtlasPacker(int width = 0, int height = 0, int padding = 0);
+
+        /** @brief Finds a free spot for a w x h image. False if the page has no room left for it. */
+        bool insert(int w, int h, AtlasRect& out);
+
+        /** @brief Gives back a rect returned by insert(), its space (with padding) can be reused. */
+        void release(const AtlasRect& rect);
+
+        int getWidth() const { return m_Width; }
+        int getHeight() const { return m_Height; }
+        /** @brief Used share of the page area, 0..1. */
+        float getOccupancy() const;
+        /** @brief Rects inserted and not released yet. */
+        int getRectCount() const { return m_RectCount; }
+
+    private:
+        // Horizontal segment of the top edge of everything packed so far
+        struct Segment {
+            int x;
+            int y;
+            int w;
+        };
+
+        int fitAt(size_t index, int w, int h) const;
+        bool insertFree(int w, int h, AtlasRect& out);
+
+        std::vector<Segment> m_Skyline;
+        std::vector<AtlasRect> m_FreeRects; // released space below the skyline, padding included
+        int m_Width = 0;
+        int m_Height = 0;
+        int m_Padding = 0;
+        long long m_UsedArea = 0;
+        int m_RectCount = 0;
+    };
+
+    /**
+     * @brief Build-time packing of project images into atlas pages.
+     * Pages and the manifest live in the assets root; the manifest maps asset id -> (page, rect)
+     * and AssetManager::loadAtlasManifest registers those regions instead of loading the files.
+     */
+    namespace TextureAtlas {
+        inline constexpr const char* ManifestFile = "texture_atlas.json";
+        inline constexpr int PageSize = 2048;
+        // Empty pixels between images, so linear filtering does not bleed neighbours in
+        inline constexpr int Padding = 2;
+        // Larger images (backgrounds) stay separate textures, they would fill a page alone
+        inline constexpr int MaxPackedSize = PageSize / 2;
+
+        bool IsImageExtension(std::string extension);
+
+        /**
+         * @brief Packs every image under assetsRoot that fits, writes the pages and the manifest
+         * next to them and deletes the packed source files. Meant for the export copy of the assets.
+         */
+        bool PackDirectory(const std::filesystem::path& assetsRoot);
+    }
+}
@@ -3,19 +3,24 @@
 
 namespace Engine {
     uint64_t Time::lastFrameTicks = 0;
+    uint64_t Time::startTicks = 0;
     float Time::deltaTime = 0.0f;
     float Time::runningTime = 0.0f;
 
     void Time::update() {
-        uint64_t currentTicks = SDL_GetTicks64();
+        // performance counter namiesto milisekund - fixny krok potrebuje presny deltaTime
+        uint64_t currentTicks = SDL_GetPerformanceCounter();
+        double frequency = static_cast<double>(SDL_GetPerformanceFrequency());
 
         if (lastFrameTicks > 0) {
             uint64_t deltaTicks = currentTicks - lastFrameTicks;
 
-            deltaTime = static_cast<float>(deltaTicks) / 1000.0f;
+            deltaTime = static_cast<float>(static_cast<double>(deltaTicks) / frequency);
+        } else {
+            startTicks = currentTicks;
         }
 
-        runningTime = static_cast<float>(currentTicks) / 1000.0f;
+        runningTime = static_cast<float>(static_cast<double>(currentTicks - startTicks) / frequency);
         lastFrameTicks = currentTicks;
     }
 }
\ No newline at end of file
@@ -12,6 +12,7 @@ namespace Engine {
         Time() = delete;
 
         static uint64_t lastFrameTicks;
+        static uint64_t startTicks;
         static float deltaTime;
         static float runningTime; 
     public:
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cmath>
+
+namespace Engine {
+
+    /**
+     * @brief 2D affine transform p' = x * p.x + y * p.y + origin, i.e. the 2x3 part of a 2D mat4.
+     * Rendering composes these instead of 4x4 matrices: 6 multiply-adds per point, no decomposition.
+     */
+    struct Affine2D {
+        glm::vec2 x = {1.0f, 0.0f};
+        glm::vec2 y = {0.0f, 1.0f};
+        glm::vec2 origin = {0.0f, 0.0f};
+
+        glm::vec2 apply(const glm::vec2& p) const { return x * p.x + y * p.y + origin; }
+        glm::vec2 applyVector(const glm::vec2& v) const { return x * v.x + y * v.y; }
+
+        /** @brief this after other, ako parent * local pri maticiach. */
+        Affine2D operator*(const Affine2D& other) const
+        {
+            Affine2D result;
+            result.x = applyVector(other.x);
+            result.y = applyVector(other.y);
+            result.origin = apply(other.origin);
+            return result;
+        }
+
+        /** @brief Translate * rotate (degrees, counter-clockwise) * scale, same order as TransformComponent. */
+        static Affine2D FromTRS(const glm::vec2& position, float degrees, const glm::vec2& scale)
+        {
+            float radians = glm::radians(degrees);
+            float s = std::sin(radians);
+            float c = std::cos(radians);
+
+            Affine2D result;
+            result.x = glm::vec2(c, s) * scale.x;
+            result.y = glm::vec2(-s, c) * scale.y;
+            result.origin = position;
+            return result;
+        }
+
+        /** @brief Drops z and perspective; exact for the engine's orthographic 2D matrices. */
+        static Affine2D FromMat4(const glm::mat4& m)
+        {
+            Affine2D result;
+            result.x = {m[0][0], m[0][1]};
+            result.y = {m[1][0], m[1][1]};
+            result.origin = {m[3][0], m[3][1]};
+            return result;
+        }
+    };
+}
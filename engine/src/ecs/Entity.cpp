@@ -9,8 +9,8 @@
 namespace Engine
 {
 
-    Entity::Entity(entt::entity handle, Scene *scene, const std::string &name)
-        : name(name), m_Handle(handle), m_Scene(scene)
+    Entity::Entity(entt::entity handle, Scene *scene, const std::string &name, uint64_t creationIndex)
+        : name(name), m_Handle(handle), m_Scene(scene), m_CreationIndex(creationIndex)
     {
         Log::info("New entity created: " + name);
         this->addComponent<TransformComponent>();
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Component.h"
+#include <cstdint>
 #include <typeindex>
 #include <unordered_map>
 #include <unordered_set>
@@ -22,6 +23,8 @@ namespace Engine {
         std::string name;
         entt::entity m_Handle = entt::null;
         Scene* m_Scene = nullptr;
+        // Poradie vytvorenia v scene, na rozdiel od handle sa nerecykluje
+        uint64_t m_CreationIndex = 0;
         
         std::unordered_set<std::type_index> m_PendingRemoval;
 
@@ -33,7 +36,7 @@ namespace Engine {
         bool isRemoved = false;
         std::unordered_map<std::type_index, std::unique_ptr<Component>> components;
     
-        Entity(entt::entity handle, Scene* scene, const std::string& name = "New entity");
+        Entity(entt::entity handle, Scene* scene, const std::string& name = "New entity", uint64_t creationIndex = 0);
         ~Entity();
 
         // Hierarchy Management
@@ -106,6 +109,7 @@ namespace Engine {
         const std::string& getName() const { return name; }
         void setName(const std::string& n_name) { name = n_name; }
         entt::entity getHandle() const { return m_Handle; }
+        uint64_t getCreationIndex() const { return m_CreationIndex; }
         Scene* getScene() const { return m_Scene; }
 
         Entity(const Entity&) = delete;
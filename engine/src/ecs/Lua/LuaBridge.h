@@ -15,10 +15,14 @@
 #include "ecs/components/RigidBodyComponent.h"
 #include "ecs/components/SoundComponent.h"
 #include "ecs/components/SpriteComponent.h"
+#include "ecs/components/TilemapComponent.h"
 #include "ecs/components/TransformComponent.h"
 #include "ecs/components/VelocityComponent.h"
+#include "ecs/systems/CollisionSystem.h"
+#include "ecs/systems/NavigationSystem.h"
 #include "sol/raii.hpp"
 #include "sol/table.hpp"
+#include <algorithm>
 #include <glm/glm.hpp>
 #include <sol/sol.hpp>
 #include "core/Project.h"
@@ -43,6 +47,50 @@ namespace Engine
     }
 
   private:
+    /**
+     * @brief Tabulka pre vysledky queries, vytvori sa raz na lua state a potom sa prepisuje,
+     * aby query v kazdom frame nealokovala
+     */
+    static sol::table ReusableTable(sol::this_state s, const char *key)
+    {
+      sol::state_view lua(s);
+      sol::object existing = lua.registry()[key];
+      if (existing.is<sol::table>())
+        return existing.as<sol::table>();
+
+      sol::table created = lua.create_table();
+      lua.registry()[key] = created;
+      return created;
+    }
+
+    static sol::object PushHit(sol::this_state s, bool found, const RaycastHit &hit, sol::optional<sol::table> out)
+    {
+      if (!found)
+        return sol::make_object(s, sol::lua_nil);
+
+      sol::table t = out ? *out : ReusableTable(s, "engine_raycast_hit");
+      t["entity"] = hit.entity;
+      t["point"] = hit.point;
+      t["normal"] = hit.normal;
+      t["distance"] = hit.distance;
+      return t;
+    }
+
+    static std::tuple<sol::table, int> PushEntities(sol::this_state s, const std::vector<Entity *> &entities, sol::optional<sol::table> out)
+    {
+      sol::table t = out ? *out : ReusableTable(s, "engine_overlap_results");
+
+      int count = static_cast<int>(entities.size());
+      for (int i = 0; i < count; ++i)
+        t[i + 1] = entities[i];
+
+      // zvysok z predchadzajucej, dlhsej query
+      for (int i = count + 1; t[i].valid(); ++i)
+        t[i] = sol::lua_nil;
+
+      return {t, count};
+    }
+
     static void RegisterCore(sol::state &lua, Project *project)
     {
       auto log = lua["Log"].get_or_create<sol::table>();
@@ -77,6 +125,18 @@ namespace Engine
         return "No Active Scene";
       };
 
+      // Pomenovane collision vrstvy projektu ako bitove hodnoty, napr. Layers.Player
+      auto layers = lua["Layers"].get_or_create<sol::table>();
+      if (project)
+      {
+        const auto &names = project->getConfig().layerNames;
+        for (int i = 0; i < MaxCollisionLayers; ++i)
+        {
+          if (!names[i].empty())
+            layers[names[i]] = 1u << i;
+        }
+      }
+
       auto input = lua["Input"].get_or_create<sol::table>();
 
       input["isKeyDown"] = [](SDL_Scancode scancode)
@@ -269,9 +329,15 @@ namespace Engine
           "RigidBody", "velocity", &RigidBodyComponent::velocity, "acceleration",
           &RigidBodyComponent::acceleration, "mass", &RigidBodyComponent::mass,
           "linearDrag", &RigidBodyComponent::linearDrag, "gravityScale",
-          &RigidBodyComponent::gravityScale, "bodyType",
-          &RigidBodyComponent::bodyType, "addForce",
-          &RigidBodyComponent::addForce);
+          &RigidBodyComponent::gravityScale, "restitution",
+          &RigidBodyComponent::restitution, "friction",
+          &RigidBodyComponent::friction, "continuousCollision",
+          &RigidBodyComponent::continuousCollision, "bodyType",
+          sol::property(&RigidBodyComponent::getBodyType, &RigidBodyComponent::setBodyType), "addForce",
+          &RigidBodyComponent::addForce, "allowSleep",
+          &RigidBodyComponent::allowSleep, "isAwake",
+          sol::readonly(&RigidBodyComponent::isAwake), "wake",
+          &RigidBodyComponent::wake);
 
       /**
        * COLLIDERS
@@ -285,7 +351,9 @@ namespace Engine
           "mask", &BoxColliderComponent::mask,
           "isTrigger", &BoxColliderComponent::isTrigger,
           "isStatic", &BoxColliderComponent::isStatic,
-          "onTriggerEnter", &BoxColliderComponent::onTriggerEnter);
+          "onTriggerEnter", &BoxColliderComponent::onTriggerEnter,
+          "onTriggerStay", &BoxColliderComponent::onTriggerStay,
+          "onTriggerExit", &BoxColliderComponent::onTriggerExit);
 
       // polygon collider
       lua.new_usertype<PolygonColliderComponent>(
@@ -298,6 +366,8 @@ namespace Engine
           "isTrigger", &PolygonColliderComponent::isTrigger,
           "isStatic", &PolygonColliderComponent::isStatic,
           "onTriggerEnter", &PolygonColliderComponent::onTriggerEnter,
+          "onTriggerStay", &PolygonColliderComponent::onTriggerStay,
+          "onTriggerExit", &PolygonColliderComponent::onTriggerExit,
           "addVertex", &PolygonColliderComponent::addVertex,
           "clearVertices", &PolygonColliderComponent::clearVertices);
 
@@ -308,6 +378,8 @@ namespace Engine
           "radius", &CircleColliderComponent::radius,
           "layer", &CircleColliderComponent::layer,
           "onTriggerEnter", &CircleColliderComponent::onTriggerEnter,
+          "onTriggerStay", &CircleColliderComponent::onTriggerStay,
+          "onTriggerExit", &CircleColliderComponent::onTriggerExit,
           "mask", &CircleColliderComponent::mask,
           "isTrigger", &CircleColliderComponent::isTrigger,
           "isStatic", &CircleColliderComponent::isStatic);
@@ -377,7 +449,18 @@ namespace Engine
           "assetId", &SpriteComponent::assetId,
           "visible", &SpriteComponent::visible,
           "zIndex", &SpriteComponent::zIndex,
-          "isFixed", &SpriteComponent::isFixed,
+          "layer", &SpriteComponent::layer,
+          // Stare skripty: isFixed = sprite na UI vrstve, kam sa nacitava aj ulozene IsFixed
+          "isFixed", sol::property(
+                         [](SpriteComponent &s)
+                         { return s.layer == DefaultScreenLayer; },
+                         [](SpriteComponent &s, bool fixed)
+                         {
+                           if (fixed)
+                             s.layer = DefaultScreenLayer;
+                           else if (s.layer == DefaultScreenLayer)
+                             s.layer = 0;
+                         }),
           "flipH", &SpriteComponent::flipH,
           "flipV", &SpriteComponent::flipV,
 
@@ -427,6 +510,23 @@ namespace Engine
                 (float)s.sourceRect.h);
           });
 
+      // tilemap, dlazdice sa citaju a zapisuju po jednej, prestavia sa len dotknuty chunk
+      lua.new_usertype<TilemapComponent>(
+          "Tilemap",
+          "tilesetAssetId", &TilemapComponent::tilesetAssetId,
+          "visible", &TilemapComponent::visible,
+          "zIndex", &TilemapComponent::zIndex,
+          "layer", &TilemapComponent::layer,
+          "collision", &TilemapComponent::collision,
+          "collisionLayer", &TilemapComponent::collisionLayer,
+          "collisionMask", &TilemapComponent::collisionMask,
+          "getTile", [](TilemapComponent &t, int x, int y)
+          { return (int)t.getTile(x, y); },
+          "setTile", [](TilemapComponent &t, int x, int y, int tile)
+          { t.setTile(x, y, (TilemapComponent::Tile)std::clamp(tile, 0, 0xFFFF)); },
+          "clear", &TilemapComponent::clear,
+          "getTileCount", &TilemapComponent::getTileCount);
+
       // SOUND
       lua.new_usertype<SoundComponent>(
           "Sound",
@@ -445,6 +545,69 @@ namespace Engine
           "Velocity",
           "velocity", &VelocityComponent::velocity);
 
+      // spatial queries, instancia sceny je v globale Physics (nastavuje ScriptSystem)
+      lua.new_usertype<CollisionSystem>(
+          "PhysicsWorld", sol::no_constructor,
+          "raycast",
+          [](CollisionSystem &world, glm::vec2 origin, glm::vec2 direction, float maxDistance,
+             sol::optional<uint32_t> mask, sol::optional<sol::table> out, sol::this_state s)
+          {
+            RaycastHit hit;
+            bool found = world.raycast(origin, direction, maxDistance, mask.value_or(CollisionLayer::All), hit);
+            return PushHit(s, found, hit, out);
+          },
+          "castCircle",
+          [](CollisionSystem &world, glm::vec2 origin, float radius, glm::vec2 direction, float maxDistance,
+             sol::optional<uint32_t> mask, sol::optional<sol::table> out, sol::this_state s)
+          {
+            RaycastHit hit;
+            bool found = world.castCircle(origin, radius, direction, maxDistance, mask.value_or(CollisionLayer::All), hit);
+            return PushHit(s, found, hit, out);
+          },
+          "overlapCircle",
+          [](CollisionSystem &world, glm::vec2 center, float radius,
+             sol::optional<uint32_t> mask, sol::optional<sol::table> out, sol::this_state s)
+          {
+            return PushEntities(s, world.overlapCircle(center, radius, mask.value_or(CollisionLayer::All)), out);
+          },
+          "overlapBox",
+          [](CollisionSystem &world, glm::vec2 center, glm::vec2 size,
+             sol::optional<uint32_t> mask, sol::optional<sol::table> out, sol::this_state s)
+          {
+            return PushEntities(s, world.overlapBox(center, size, mask.value_or(CollisionLayer::All)), out);
+          },
+          "overlapPoint",
+          [](CollisionSystem &world, glm::vec2 point,
+             sol::optional<uint32_t> mask, sol::optional<sol::table> out, sol::this_state s)
+          {
+            return PushEntities(s, world.overlapPoint(point, mask.value_or(CollisionLayer::All)), out);
+          });
+
+      // Cesta sa vracia vo vlastnej tabulke, agent si ju drzi dlhsie nez do dalsej query
+      lua.new_usertype<NavigationSystem>(
+          "NavigationGrid", sol::no_constructor,
+          "findPath",
+          [](NavigationSystem &nav, glm::vec2 from, glm::vec2 to, sol::optional<sol::table> out, sol::this_state s)
+              -> std::tuple<sol::object, int>
+          {
+            const std::vector<glm::vec2> *path = nav.findPath(from, to);
+            if (!path)
+              return {sol::make_object(s, sol::lua_nil), 0};
+
+            sol::table t = out ? *out : sol::state_view(s).create_table(static_cast<int>(path->size()), 0);
+            int count = static_cast<int>(path->size());
+            for (int i = 0; i < count; ++i)
+              t[i + 1] = (*path)[i];
+            for (int i = count + 1; t[i].valid(); ++i)
+              t[i] = sol::lua_nil;
+            return {t, count};
+          },
+          "flowDirection", &NavigationSystem::getFlowDirection,
+          "isWalkable", &NavigationSystem::isWalkable,
+          "rebake", &NavigationSystem::rebake,
+          "cellSize", sol::readonly_property(&NavigationSystem::getCellSize),
+          "version", sol::readonly_property(&NavigationSystem::getVersion));
+
       lua.new_usertype<InputMapping>("InputMapping", "actionName",
                                      &InputMapping::actionName, "scancode",
                                      &InputMapping::scancode);
@@ -474,6 +637,8 @@ namespace Engine
           { return e.getComponent<AnimationComponent>(); },
           "getCamera", [](Entity &e)
           { return e.getComponent<CameraComponent>(); },
+          "getTilemap", [](Entity &e)
+          { return e.getComponent<TilemapComponent>(); },
           "getInputController", [](Entity &e)
           { return e.getComponent<InputControllerComponent>(); });
     }
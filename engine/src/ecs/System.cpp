@@ -8,7 +8,8 @@ namespace Engine {
 
     /**
      * @brief Pridanie entity do listu entit systemu.
-     * @details Kontrola ci je entita uz present pred pridanim.
+     * @details Kontrola ci je entita uz present pred pridanim. List je zoradeny podla poradia vytvorenia,
+     * takze systemy iteruju rovnako nezavisle od toho, v akom poradi entity dostali komponenty.
      */
     void System::addEntity(Entity* entity) {
         if (!entity) {
@@ -19,7 +20,10 @@ namespace Engine {
         auto it = std::find(m_Entities.begin(), m_Entities.end(), entity);
         
         if (it == m_Entities.end()) {
-            m_Entities.push_back(entity);
+            // Nove entity maju najvyssi index, takze takmer vzdy ide o pridanie na koniec
+            auto pos = std::upper_bound(m_Entities.begin(), m_Entities.end(), entity->getCreationIndex(),
+                [](uint64_t index, const Entity* e) { return index < e->getCreationIndex(); });
+            m_Entities.insert(pos, entity);
             Log::info("System added entity: " + entity->getName()); 
         } else {
             Log::warn("Entity " + entity->getName() + " already subscribed to this system.");
@@ -1,4 +1,5 @@
 #pragma once
+#include <cstdint>
 #include <set>
 #include <vector>
 #include <typeinfo>
@@ -8,6 +9,15 @@ namespace Engine {
 }
 
 namespace Engine {
+    /**
+     * @brief V ktorej faze frame-u sa system updatuje. Systemy mozu byt aj v oboch.
+     * VariableStep = raz za frame s realnym dt, FixedStep = fixny krok simulacie (fyzika, kolizie).
+     */
+    enum SystemStage : uint8_t {
+        VariableStep = 1 << 0,
+        FixedStep = 1 << 1
+    };
+
     /**
      * @brief Zakladna class pre vsetky ECS systemy.
      * * Systemy definuju logiku a operuju na entitach ktore maju specificky set komponentov
@@ -18,6 +28,7 @@ namespace Engine {
 
         virtual void onInit() {};
         virtual void onUpdate(float dt) {};
+        virtual void onFixedUpdate(float fixedDt) {};
         virtual void onShutdown() {};
         virtual void addEntity(Entity* entity);
         virtual void removeEntity(Entity* entity);
@@ -27,6 +38,9 @@ namespace Engine {
         const std::set<const std::type_info*>& getComponentSignature() const {
             return m_ComponentSignature;
         }
+        uint8_t getUpdateStages() const {
+            return m_UpdateStages;
+        }
     protected:
         /**
          * @brief deklaruje component requirement pre dany system
@@ -37,9 +51,17 @@ namespace Engine {
         void requireComponent() {
             m_ComponentSignature.insert(&typeid(TComponent));
         }
+
+        /**
+         * @brief deklaruje, v ktorych fazach (SystemStage flagy) scena system updatuje. Default je VariableStep.
+         */
+        void setUpdateStages(uint8_t stages) {
+            m_UpdateStages = stages;
+        }
     
     private:
         std::vector<Entity*> m_Entities;
         std::set<const std::type_info*> m_ComponentSignature;
+        uint8_t m_UpdateStages = SystemStage::VariableStep;
     };
 }
\ No newline at end of file
@@ -45,6 +45,9 @@ namespace Engine {
 
         bool isTrigger;
         std::function<void(Entity* other)> onTriggerEnter;
+        // volane kazdy frame pocas prekryvu, iba ak je nastavene
+        std::function<void(Entity* other)> onTriggerStay;
+        std::function<void(Entity* other)> onTriggerExit;
         
         bool isStatic;
 
@@ -31,6 +31,9 @@ namespace Engine {
 
         // Callback for trigger events
         std::function<void(Entity* other)> onTriggerEnter;
+        // Fired every frame while overlapping, only when assigned
+        std::function<void(Entity* other)> onTriggerStay;
+        std::function<void(Entity* other)> onTriggerExit;
 
         // Standard constructor for the AddComponent pattern
         CircleColliderComponent() : Component() {}
@@ -0,0 +1,275 @@
+#include "PolygonColliderComponent.h"
+#include "core/Log.h"
+#include <algorithm>
+#include <cmath>
+#include <glm/glm.hpp>
+
+namespace Engine {
+    static constexpr float shapeEpsilon = 1e-6f;
+
+    static float Cross(const glm::vec2& a, const glm::vec2& b)
+    {
+        return a.x * b.y - a.y * b.x;
+    }
+
+    static float SignedArea(const std::vector<glm::vec2>& verts)
+    {
+        float area = 0.0f;
+        for (size_t i = 0; i < verts.size(); ++i)
+            area += Cross(verts[i], verts[(i + 1) % verts.size()]);
+        return area * 0.5f;
+    }
+
+    // Drops repeated and collinear points, they would only give zero-length edges and duplicate axes
+    static std::vector<glm::vec2> CleanOutline(const std::vector<glm::vec2>& verts)
+    {
+        std::vector<glm::vec2> out = verts;
+
+        bool removed = true;
+        while (removed && out.size() >= 3)
+        {
+            removed = false;
+            for (size_t i = 0; i < out.size() && out.size() >= 3; ++i)
+            {
+                const glm::vec2& prev = out[(i + out.size() - 1) % out.size()];
+                const glm::vec2& next = out[(i + 1) % out.size()];
+                glm::vec2 d = out[i] - prev;
+
+                if (glm::dot(d, d) < shapeEpsilon || std::abs(Cross(d, next - out[i])) < shapeEpsilon)
+                {
+                    out.erase(out.begin() + i);
+                    removed = true;
+                    break;
+                }
+            }
+        }
+        return out;
+    }
+
+    // Corners of a counter-clockwise outline never turn right
+    static bool IsConvexOutline(const std::vector<glm::vec2>& verts, const std::vector<int>& indices)
+    {
+        size_t n = indices.size();
+        for (size_t i = 0; i < n; ++i)
+        {
+            const glm::vec2& a = verts[indices[i]];
+            const glm::vec2& b = verts[indices[(i + 1) % n]];
+            const glm::vec2& c = verts[indices[(i + 2) % n]];
+            if (Cross(b - a, c - b) < -shapeEpsilon)
+                return false;
+        }
+        return true;
+    }
+
+    static bool PointInTriangle(const glm::vec2& p, const glm::vec2& a, const glm::vec2& b, const glm::vec2& c)
+    {
+        return Cross(b - a, p - a) >= 0.0f && Cross(c - b, p - b) >= 0.0f && Cross(a - c, p - c) >= 0.0f;
+    }
+
+    // Ear clipping of a simple counter-clockwise outline. False if no ear is left (self-intersection).
+    static bool Triangulate(const std::vector<glm::vec2>& verts, std::vector<std::vector<int>>& outTriangles)
+    {
+        std::vector<int> remaining(verts.size());
+        for (size_t i = 0; i < verts.size(); ++i)
+            remaining[i] = static_cast<int>(i);
+
+        while (remaining.size() > 3)
+        {
+            size_t n = remaining.size();
+            bool clipped = false;
+
+            for (size_t i = 0; i < n; ++i)
+            {
+                int ia = remaining[(i + n - 1) % n];
+                int ib = remaining[i];
+                int ic = remaining[(i + 1) % n];
+                const glm::vec2& a = verts[ia];
+                const glm::vec2& b = verts[ib];
+                const glm::vec2& c = verts[ic];
+
+                if (Cross(b - a, c - b) <= shapeEpsilon)
+                    continue; // reflex corner
+
+                bool blocked = false;
+                for (int other : remaining)
+                {
+                    if (other == ia || other == ib || other == ic)
+                        continue;
+                    if (PointInTriangle(verts[other], a, b, c))
+                    {
+                        blocked = true;
+                        break;
+                    }
+                }
+                if (blocked)
+                    continue;
+
+                outTriangles.push_back({ia, ib, ic});
+                remaining.erase(remaining.begin() + i);
+                clipped = true;
+                break;
+            }
+
+            if (!clipped)
+                return false;
+        }
+
+        outTriangles.push_back(remaining);
+        return true;
+    }
+
+    // Joins two pieces across the diagonal u -> v of a (v -> u of b). Empty if they share no such edge.
+    static std::vector<int> MergeAcrossDiagonal(const std::vector<int>& a, const std::vector<int>& b)
+    {
+        for (size_t i = 0; i < a.size(); ++i)
+        {
+            int u = a[i];
+            int v = a[(i + 1) % a.size()];
+
+            for (size_t j = 0; j < b.size(); ++j)
+            {
+                if (b[j] != v || b[(j + 1) % b.size()] != u)
+                    continue;
+
+                // a from v around to u, then the rest of b from after u up to before v
+                std::vector<int> merged;
+                merged.reserve(a.size() + b.size() - 2);
+                for (size_t k = 0; k < a.size(); ++k)
+                    merged.push_back(a[(i + 1 + k) % a.size()]);
+                for (size_t k = 2; k < b.size(); ++k)
+                    merged.push_back(b[(j + k) % b.size()]);
+                return merged;
+            }
+        }
+        return {};
+    }
+
+    // Hertel-Mehlhorn: drop every diagonal whose removal keeps both sides convex
+    static void MergeConvexPieces(const std::vector<glm::vec2>& verts, std::vector<std::vector<int>>& pieces)
+    {
+        bool merged = true;
+        while (merged)
+        {
+            merged = false;
+            for (size_t i = 0; i < pieces.size() && !merged; ++i)
+            {
+                for (size_t j = i + 1; j < pieces.size() && !merged; ++j)
+                {
+                    std::vector<int> joined = MergeAcrossDiagonal(pieces[i], pieces[j]);
+                    if (joined.empty() || !IsConvexOutline(verts, joined))
+                        continue;
+
+                    pieces[i] = std::move(joined);
+                    pieces.erase(pieces.begin() + j);
+                    merged = true;
+                }
+            }
+        }
+    }
+
+    // Monotone chain, counter-clockwise. Fallback for outlines that cross themselves.
+    static std::vector<glm::vec2> ConvexHull(std::vector<glm::vec2> points)
+    {
+        std::sort(points.begin(), points.end(), [](const glm::vec2& l, const glm::vec2& r)
+                  { return l.x < r.x || (l.x == r.x && l.y < r.y); });
+
+        std::vector<glm::vec2> hull(points.size() * 2);
+        size_t k = 0;
+        for (size_t i = 0; i < points.size(); ++i)
+        {
+            while (k >= 2 && Cross(hull[k - 1] - hull[k - 2], points[i] - hull[k - 2]) <= 0.0f)
+                --k;
+            hull[k++] = points[i];
+        }
+        for (size_t i = points.size() - 1, lower = k + 1; i > 0; --i)
+        {
+            while (k >= lower && Cross(hull[k - 1] - hull[k - 2], points[i - 1] - hull[k - 2]) <= 0.0f)
+                --k;
+            hull[k++] = points[i - 1];
+        }
+
+        hull.resize(k > 1 ? k - 1 : k);
+        return hull;
+    }
+
+    static ConvexPiece MakePiece(std::vector<glm::vec2> verts)
+    {
+        ConvexPiece piece;
+        piece.vertices = std::move(verts);
+        piece.normals.reserve(piece.vertices.size());
+
+        for (size_t i = 0; i < piece.vertices.size(); ++i)
+        {
+            glm::vec2 edge = piece.vertices[(i + 1) % piece.vertices.size()] - piece.vertices[i];
+            piece.normals.push_back(glm::normalize(glm::vec2(edge.y, -edge.x)));
+            piece.center += piece.vertices[i];
+        }
+        piece.center /= (float)piece.vertices.size();
+
+        for (const auto& v : piece.vertices)
+            piece.radius = std::max(piece.radius, glm::length(v - piece.center));
+        return piece;
+    }
+
+    void PolygonColliderComponent::rebuildShape()
+    {
+        m_ShapeSource = vertices;
+        m_ShapeBuilt = true;
+        m_Pieces.clear();
+        m_IsConvex = true;
+
+        m_BoundingRadius = 0.0f;
+        for (const auto& v : vertices)
+            m_BoundingRadius = std::max(m_BoundingRadius, glm::length(v));
+
+        std::vector<glm::vec2> outline = CleanOutline(vertices);
+        if (outline.size() < 3)
+            return;
+
+        float area = SignedArea(outline);
+        if (std::abs(area) < shapeEpsilon)
+        {
+            // Crossing lobes cancel out - only a self-intersecting outline with real extent gets here
+            std::vector<glm::vec2> hull = ConvexHull(outline);
+            if (hull.size() >= 3)
+            {
+                Log::warn("Polygon collider outline intersects itself, using its convex hull.");
+                m_Pieces.push_back(MakePiece(std::move(hull)));
+            }
+            return;
+        }
+        if (area < 0.0f)
+            std::reverse(outline.begin(), outline.end());
+
+        std::vector<int> all(outline.size());
+        for (size_t i = 0; i < outline.size(); ++i)
+            all[i] = static_cast<int>(i);
+
+        if (IsConvexOutline(outline, all))
+        {
+            m_Pieces.push_back(MakePiece(std::move(outline)));
+            return;
+        }
+
+        std::vector<std::vector<int>> pieces;
+        if (!Triangulate(outline, pieces))
+        {
+            Log::warn("Polygon collider outline intersects itself, using its convex hull.");
+            m_Pieces.push_back(MakePiece(ConvexHull(outline)));
+            return;
+        }
+
+        MergeConvexPieces(outline, pieces);
+
+        m_IsConvex = pieces.size() == 1;
+        m_Pieces.reserve(pieces.size());
+        for (const auto& indices : pieces)
+        {
+            std::vector<glm::vec2> verts;
+            verts.reserve(indices.size());
+            for (int index : indices)
+                verts.push_back(outline[index]);
+            m_Pieces.push_back(MakePiece(std::move(verts)));
+        }
+    }
+}
@@ -8,6 +8,14 @@
 #include <memory>
 #include <vector>
 namespace Engine {
+    /** @brief Convex part of a polygon collider in collider-local space, counter-clockwise. */
+    struct ConvexPiece {
+        std::vector<glm::vec2> vertices;
+        std::vector<glm::vec2> normals; // outward unit normal of the edge vertices[i] -> vertices[i + 1]
+        glm::vec2 center = {0.0f, 0.0f};
+        float radius = 0.0f; // bounding circle around center
+    };
+
     class PolygonColliderComponent : public Component {
     public:
         std::vector<glm::vec2> vertices;
@@ -22,6 +30,8 @@ namespace Engine {
         bool isStatic = false;
 
         std::function<void(Entity* other)> onTriggerEnter;
+        std::function<void(Entity* other)> onTriggerStay;
+        std::function<void(Entity* other)> onTriggerExit;
 
         PolygonColliderComponent() {
             vertices = {
@@ -39,5 +49,27 @@ namespace Engine {
         void addVertex(const glm::vec2& p) {vertices.push_back(p);}
         void clearVertices(){ vertices.clear(); }
 
+        /**
+         * @brief Convex pieces of the outline with precomputed normals.
+         * Rebuilt lazily whenever `vertices` differ from the outline of the last build,
+         * so the editor, Lua and the serializer can keep writing the vector directly.
+         */
+        const std::vector<ConvexPiece>& getConvexPieces() { ensureShape(); return m_Pieces; }
+
+        /** @brief Radius of the circle around the collider origin that contains every vertex. */
+        float getBoundingRadius() { ensureShape(); return m_BoundingRadius; }
+
+        /** @brief False if the outline had to be decomposed into several pieces. */
+        bool isConvex() { ensureShape(); return m_IsConvex; }
+
+    private:
+        void ensureShape() { if (!m_ShapeBuilt || vertices != m_ShapeSource) rebuildShape(); }
+        void rebuildShape();
+
+        std::vector<glm::vec2> m_ShapeSource;
+        std::vector<ConvexPiece> m_Pieces;
+        float m_BoundingRadius = 0.0f;
+        bool m_IsConvex = true;
+        bool m_ShapeBuilt = false;
     };
-}
\ No newline at end of file
+}
@@ -0,0 +1,16 @@
+#include "RigidBodyComponent.h"
+#include "ecs/Entity.h"
+#include "scene/Scene.h"
+
+namespace Engine {
+    void RigidBodyComponent::setBodyType(BodyType type)
+    {
+        if (type == m_BodyType)
+            return;
+        m_BodyType = type;
+
+        // Rovnaka cesta ako pridanie komponentu, PhysicsSystem si pri nej preradi buckety
+        if (owner && owner->getScene())
+            owner->getScene()->checkEntitySubscriptions(owner);
+    }
+}
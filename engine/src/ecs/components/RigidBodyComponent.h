@@ -9,8 +9,6 @@ namespace Engine {
 
     class RigidBodyComponent : public Component {
     public:
-        BodyType bodyType = BodyType::Dynamic;
-
         float mass = 1.0f;
         float gravityScale = 1.0f;
 
@@ -19,16 +17,49 @@ namespace Engine {
 
         float linearDrag = 0.1f;
 
-        RigidBodyComponent(BodyType type = BodyType::Dynamic) : bodyType(type) {}
+        // Material pre contact solver: pri dotyku sa friction kombinuje geometrickym priemerom, restitution maximom
+        float restitution = 0.0f;
+        float friction = 0.2f;
+
+        // CCD: rychle telo sa testuje po celej drahe kroku proti statickej geometrii, aby nepreletelo cez tenke steny
+        bool continuousCollision = false;
+
+        // Sleeping: pokojne telo sa neintegruje ani netestuje proti statickym/spiacim telesam
+        bool allowSleep = true;
+        bool isAwake = true;
+        float sleepTime = 0.0f;
+
+        RigidBodyComponent(BodyType type = BodyType::Dynamic) : m_BodyType(type) {}
+
+        BodyType getBodyType() const { return m_BodyType; }
+
+        /** @brief Changes the body type and lets the scene re-sort the entity, systems bucket bodies by type. */
+        void setBodyType(BodyType type);
+
+        void wake() {
+            isAwake = true;
+            sleepTime = 0.0f;
+        }
+
+        void sleep() {
+            isAwake = false;
+            sleepTime = 0.0f;
+            velocity = glm::vec2(0.0f);
+            acceleration = glm::vec2(0.0f);
+        }
 
         void addForce(glm::vec2 force) {
-            if (bodyType == BodyType::Dynamic && mass > 0.0f) {
+            if (m_BodyType == BodyType::Dynamic && mass > 0.0f) {
                 acceleration += force / mass;
+                wake();
             }
         }
         std::unique_ptr<Component> clone() const override
         {
             return std::make_unique<RigidBodyComponent>(*this);
         }
+
+    private:
+        BodyType m_BodyType = BodyType::Dynamic;
     };
 }
\ No newline at end of file
@@ -6,6 +6,7 @@
 #include "SDL_render.h"
 #include "core/Log.h"
 #include <SDL2/SDL.h>
+#include <cstdint>
 #include <memory>
 #include <cmath>
 #include <string>
@@ -21,7 +22,7 @@ namespace Engine {
         SDL_Texture* texture = nullptr;
         std::string assetId;
         SDL_Rect sourceRect;
-        bool isFixed = false; // sprite position relativna ku obrazovke ak true
+        int layer = 0; // render vrstva projektu; v screen-space vrstve je pozicia v pixeloch obrazovky
 
         bool visible = true;
         bool flipH = false;
@@ -30,6 +31,11 @@ namespace Engine {
 
         SDL_Color color = {255, 255, 255, 255};
 
+        // Kde lezi assetId v atlase (sourceRect je relativny k nemu). Neuklada sa, renderer ho
+        // obnovi ked sa zmeni AssetManager::getAtlasVersion().
+        SDL_Rect atlasRegion = {0, 0, 0, 0};
+        uint32_t atlasVersion = 0;
+
         SpriteComponent(const std::string& id = "", SDL_Texture* tex = nullptr,
                         int srcX = 0, int srcY = 0, int srcW = 0, int srcH = 0, int z = 0)
             : assetId(id), texture(tex), zIndex(z) {
@@ -17,8 +17,10 @@ public:
 
     SDL_Color color {255,255,255,255};
 
-    bool isFixed = false;
+    int layer = 0; // render vrstva projektu, screen-space vrstvy su UI
     int zIndex = 0;
+    // Casto menene texty (skore, casovace) sa skladaju z atlasu glyphov namiesto vlastnej textury
+    bool dynamic = false;
 
     std::shared_ptr<Font> font = nullptr;
 
@@ -26,7 +28,7 @@ public:
     int lastFontSize = 0;
 
     TextComponent()
-    : text("Text"), fontPath("assets/fonts/Default.ttf"), fontSize(24), color{255,255,255,255}, isFixed(false), zIndex(0), font(nullptr), dirty(true) {}
+    : text("Text"), fontPath("assets/fonts/Default.ttf"), fontSize(24), color{255,255,255,255}, layer(0), zIndex(0), dynamic(false), font(nullptr), dirty(true) {}
 
     std::unique_ptr<Component> clone() const override
         {
@@ -0,0 +1,206 @@
+#include "TilemapComponent.h"
+#include <algorithm>
+
+namespace Engine {
+
+    // Posun znamienkoveho bitu, aby zaporne suradnice boli v mape pred kladnymi
+    static uint32_t BiasCoord(int value)
+    {
+        return (uint32_t)value ^ 0x80000000u;
+    }
+
+    uint64_t TilemapComponent::ChunkKey(int chunkX, int chunkY)
+    {
+        return ((uint64_t)BiasCoord(chunkX) << 32) | BiasCoord(chunkY);
+    }
+
+    glm::ivec2 TilemapComponent::ChunkCoords(uint64_t key)
+    {
+        return {(int)((uint32_t)(key >> 32) ^ 0x80000000u), (int)((uint32_t)key ^ 0x80000000u)};
+    }
+
+    TilemapComponent::Tile TilemapComponent::getTile(int x, int y) const
+    {
+        int chunkX = ChunkOf(x);
+        int chunkY = ChunkOf(y);
+        auto it = m_Chunks.find(ChunkKey(chunkX, chunkY));
+        if (it == m_Chunks.end())
+            return 0;
+
+        int localX = x - chunkX * ChunkSize;
+        int localY = y - chunkY * ChunkSize;
+        return it->second.tiles[localY * ChunkSize + localX];
+    }
+
+    void TilemapComponent::setTile(int x, int y, Tile tile)
+    {
+        int chunkX = ChunkOf(x);
+        int chunkY = ChunkOf(y);
+        uint64_t key = ChunkKey(chunkX, chunkY);
+
+        auto it = m_Chunks.find(key);
+        if (it == m_Chunks.end())
+        {
+            if (tile == 0)
+                return;
+            it = m_Chunks.emplace(key, Chunk()).first;
+        }
+
+        Chunk& chunk = it->second;
+        Tile& slot = chunk.tiles[(y - chunkY * ChunkSize) * ChunkSize + (x - chunkX * ChunkSize)];
+        if (slot == tile)
+            return;
+
+        if ((tile != 0) != (slot != 0))
+            m_CollisionVersion++;
+        chunk.tileCount += (tile != 0) - (slot != 0);
+        slot = tile;
+        if (chunk.tileCount == 0)
+        {
+            m_Chunks.erase(it);
+            return;
+        }
+        chunk.geometryDirty = true;
+        chunk.collidersDirty = true;
+    }
+
+    void TilemapComponent::clear()
+    {
+        m_Chunks.clear();
+        m_CollisionVersion++;
+    }
+
+    void TilemapComponent::invalidateGeometry()
+    {
+        for (auto& [key, chunk] : m_Chunks)
+            chunk.geometryDirty = true;
+    }
+
+    int TilemapComponent::getTileCount() const
+    {
+        int count = 0;
+        for (const auto& [key, chunk] : m_Chunks)
+            count += chunk.tileCount;
+        return count;
+    }
+
+    const std::vector<SDL_Vertex>& TilemapComponent::getChunkGeometry(uint64_t key, int textureW, int textureH)
+    {
+        static const std::vector<SDL_Vertex> empty;
+        auto it = m_Chunks.find(key);
+        if (it == m_Chunks.end())
+            return empty;
+
+        Chunk& chunk = it->second;
+        const SDL_Rect& built = chunk.builtRegion;
+        bool regionChanged = built.x != atlasRegion.x || built.y != atlasRegion.y || built.w != atlasRegion.w ||
+                             built.h != atlasRegion.h;
+        if (chunk.geometryDirty || regionChanged || chunk.builtTileSize != tileSize)
+            buildGeometry(key, chunk, textureW, textureH);
+        return chunk.vertices;
+    }
+
+    void TilemapComponent::buildGeometry(uint64_t key, Chunk& chunk, int textureW, int textureH)
+    {
+        chunk.vertices.clear();
+        chunk.geometryDirty = false;
+        chunk.builtTileSize = tileSize;
+        chunk.builtRegion = atlasRegion;
+
+        if (tileSize.x <= 0 || tileSize.y <= 0 || textureW <= 0 || textureH <= 0)
+            return;
+
+        SDL_Rect region = atlasRegion;
+        if (region.w <= 0 || region.h <= 0)
+            region = {0, 0, textureW, textureH};
+        int columns = region.w / tileSize.x;
+        int rows = region.h / tileSize.y;
+        if (columns <= 0 || rows <= 0)
+            return;
+
+        glm::ivec2 origin = ChunkCoords(key) * ChunkSize;
+        chunk.vertices.reserve(chunk.tileCount * 4);
+        for (int localY = 0; localY < ChunkSize; ++localY)
+        {
+            for (int localX = 0; localX < ChunkSize; ++localX)
+            {
+                Tile tile = chunk.tiles[localY * ChunkSize + localX];
+                if (tile == 0 || tile > columns * rows)
+                    continue;
+
+                int index = tile - 1;
+                float u0 = (region.x + (index % columns) * tileSize.x) / (float)textureW;
+                float v0 = (region.y + (index / columns) * tileSize.y) / (float)textureH;
+                float u1 = u0 + tileSize.x / (float)textureW;
+                float v1 = v0 + tileSize.y / (float)textureH;
+
+                float x0 = (float)((origin.x + localX) * tileSize.x);
+                float y0 = (float)((origin.y + localY) * tileSize.y);
+                float x1 = x0 + tileSize.x;
+                float y1 = y0 + tileSize.y;
+
+                // Horny okraj textury je vo svete +y
+                const float corners[4][4] = {{x0, y1, u0, v0}, {x1, y1, u1, v0}, {x1, y0, u1, v1}, {x0, y0, u0, v1}};
+                for (const auto& corner : corners)
+                {
+                    SDL_Vertex vertex;
+                    vertex.position = {corner[0], corner[1]};
+                    vertex.color = {255, 255, 255, 255};
+                    vertex.tex_coord = {corner[2], corner[3]};
+                    chunk.vertices.push_back(vertex);
+                }
+            }
+        }
+    }
+
+    const std::vector<TilemapComponent::TileRect>& TilemapComponent::getChunkColliders(uint64_t key)
+    {
+        static const std::vector<TileRect> empty;
+        auto it = m_Chunks.find(key);
+        if (it == m_Chunks.end())
+            return empty;
+
+        Chunk& chunk = it->second;
+        if (!chunk.collidersDirty)
+            return chunk.colliders;
+
+        // Greedy: najsirsi beh v riadku, potom rast nahor kym je cely beh plny
+        chunk.colliders.clear();
+        chunk.collidersDirty = false;
+        std::array<bool, ChunkSize * ChunkSize> used{};
+        auto solid = [&](int x, int y)
+        {
+            int i = y * ChunkSize + x;
+            return chunk.tiles[i] != 0 && !used[i];
+        };
+
+        for (int y = 0; y < ChunkSize; ++y)
+        {
+            for (int x = 0; x < ChunkSize; ++x)
+            {
+                if (!solid(x, y))
+                    continue;
+
+                int w = 1;
+                while (x + w < ChunkSize && solid(x + w, y))
+                    ++w;
+
+                int h = 1;
+                while (y + h < ChunkSize)
+                {
+                    bool full = true;
+                    for (int i = 0; i < w && full; ++i)
+                        full = solid(x + i, y + h);
+                    if (!full)
+                        break;
+                    ++h;
+                }
+
+                for (int j = 0; j < h; ++j)
+                    std::fill_n(used.begin() + (y + j) * ChunkSize + x, w, true);
+                chunk.colliders.push_back({x, y, w, h});
+            }
+        }
+        return chunk.colliders;
+    }
+}
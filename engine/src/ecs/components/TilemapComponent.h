@@ -0,0 +1,109 @@
+#pragma once
+
+#include "ecs/Component.h"
+#include <SDL2/SDL.h>
+#include <glm/glm.hpp>
+#include <array>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Engine {
+
+    /**
+     * @brief Grid of tiles drawn from one tileset asset, stored in 32x32 chunks.
+     *
+     * Tile (x, y) covers [x, x + 1] * tileSize in the entity's local space, rows grow upward like the world.
+     * Tile value 0 is empty, n is the n-th tile of the tileset counted row by row from 1.
+     * Every chunk keeps its quads prebuilt in local space and its solid tiles merged into a few rectangles;
+     * setTile() only marks the chunk it touches, so editing a level rebuilds one chunk, not the whole map.
+     */
+    class TilemapComponent : public Component {
+    public:
+        static constexpr int ChunkSize = 32;
+        using Tile = uint16_t;
+
+        /** @brief Solid area of a chunk in tiles, relative to the chunk's first tile. */
+        struct TileRect {
+            int x, y, w, h;
+        };
+
+        struct Chunk {
+            std::array<Tile, ChunkSize * ChunkSize> tiles{};
+            int tileCount = 0;
+
+            // Cache, postavi sa az ked ho renderer alebo kolizie potrebuju
+            std::vector<SDL_Vertex> vertices; // 4 per tile, local space, same corner order as a RenderQueue quad
+            std::vector<TileRect> colliders;
+            bool geometryDirty = true;
+            bool collidersDirty = true;
+            glm::ivec2 builtTileSize = {0, 0};
+            SDL_Rect builtRegion = {0, 0, 0, 0};
+        };
+
+        std::string tilesetAssetId;
+        glm::ivec2 tileSize = {16, 16}; // pixels of one tile in the tileset, also its size in world units
+
+        int layer = 0;
+        int zIndex = 0;
+        SDL_Color color = {255, 255, 255, 255};
+        bool visible = true;
+
+        // Vsetky neprazdne dlazdice su pevne, spolu tvoria staticke collidery
+        bool collision = true;
+        uint32_t collisionLayer = 1;
+        uint32_t collisionMask = 0xFFFFFFFF;
+
+        // Kde lezi tileset v atlase. Neuklada sa, TilemapSystem ho obnovi s AssetManager::getAtlasVersion().
+        SDL_Texture* texture = nullptr;
+        SDL_Rect atlasRegion = {0, 0, 0, 0};
+        uint32_t atlasVersion = 0;
+
+        TilemapComponent() = default;
+        TilemapComponent(const std::string& tilesetAssetId, glm::ivec2 tileSize)
+            : tilesetAssetId(tilesetAssetId), tileSize(tileSize) {}
+
+        std::unique_ptr<Component> clone() const override
+        {
+            return std::make_unique<TilemapComponent>(*this);
+        }
+
+        Tile getTile(int x, int y) const;
+        /** @brief Writes one tile; empty chunks are dropped so cleared areas cost nothing. */
+        void setTile(int x, int y, Tile tile);
+        void clear();
+
+        /** @brief Marks every chunk for a geometry rebuild, e.g. after the tileset changed. */
+        void invalidateGeometry();
+
+        int getTileCount() const;
+
+        /** @brief Increases whenever a tile turns solid or empty, so obstacle caches can skip unchanged maps. */
+        uint32_t getCollisionVersion() const { return m_CollisionVersion; }
+        const std::map<uint64_t, Chunk>& getChunks() const { return m_Chunks; }
+
+        /**
+         * @brief Quads of a chunk, rebuilt only if its tiles, tileSize or the tileset region changed.
+         * @param textureW, textureH size of the texture holding atlasRegion, for normalized UVs
+         */
+        const std::vector<SDL_Vertex>& getChunkGeometry(uint64_t key, int textureW, int textureH);
+
+        /** @brief Solid tiles of a chunk merged into rectangles, rebuilt only after its tiles changed. */
+        const std::vector<TileRect>& getChunkColliders(uint64_t key);
+
+        /** @brief Chunk keys order by x then y, so iterating the map is deterministic. */
+        static uint64_t ChunkKey(int chunkX, int chunkY);
+        static glm::ivec2 ChunkCoords(uint64_t key);
+
+        /** @brief Chunk of a tile; floor division, so negative tiles land in negative chunks. */
+        static int ChunkOf(int tile) { return tile >= 0 ? tile / ChunkSize : (tile + 1) / ChunkSize - 1; }
+
+    private:
+        void buildGeometry(uint64_t key, Chunk& chunk, int textureW, int textureH);
+
+        std::map<uint64_t, Chunk> m_Chunks;
+        uint32_t m_CollisionVersion = 0;
+    };
+}
@@ -15,8 +15,30 @@ namespace Engine {
         float rotation = 0.0f;
         glm::vec2 scale = {1.0f, 1.0f};
 
+        // Stav pred a po poslednom fixnom kroku - renderer medzi nimi interpoluje
+        glm::vec2 previousPosition = {0.0f, 0.0f};
+        float previousRotation = 0.0f;
+        glm::vec2 simulatedPosition = {0.0f, 0.0f};
+        float simulatedRotation = 0.0f;
+
         TransformComponent(glm::vec2 pos = {0.0f, 0.0f}, float rot = 0.0f, glm::vec2 scl = {1.0f, 1.0f}) 
-            : position(pos), rotation(rot), scale(scl) {}
+            : position(pos), rotation(rot), scale(scl),
+              previousPosition(pos), previousRotation(rot), simulatedPosition(pos), simulatedRotation(rot) {}
+
+        /**
+         * @brief Pozicia na vykreslenie. Ak entitu posunulo nieco mimo fixneho kroku (skript, editor),
+         * vrati aktualnu poziciu bez interpolacie.
+         */
+        glm::vec2 getRenderPosition(float alpha) const {
+            if (position != simulatedPosition) return position;
+            return previousPosition + (position - previousPosition) * alpha;
+        }
+
+        float getRenderRotation(float alpha) const {
+            if (rotation != simulatedRotation) return rotation;
+            return previousRotation + (rotation - previousRotation) * alpha;
+        }
+
             std::unique_ptr<Component> clone() const override
         {
             return std::make_unique<TransformComponent>(*this);
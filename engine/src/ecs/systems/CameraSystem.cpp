@@ -11,7 +11,7 @@ CameraSystem::CameraSystem() {
     requireComponent<CameraComponent>();
 }
 
-void CameraSystem::updateCamera(Camera* mainCamera) {
+void CameraSystem::updateCamera(Camera* mainCamera, float alpha) {
     if (!mainCamera) {
         return;
     }
@@ -21,8 +21,8 @@ void CameraSystem::updateCamera(Camera* mainCamera) {
         if (cameraComp && cameraComp->isPrimary) {
             auto transform = entity->getComponent<TransformComponent>();
             if (transform) {
-                mainCamera->setPosition(transform->position);
-                mainCamera->setRotation(transform->rotation);
+                mainCamera->setPosition(transform->getRenderPosition(alpha));
+                mainCamera->setRotation(transform->getRenderRotation(alpha));
             }
             break; 
         }
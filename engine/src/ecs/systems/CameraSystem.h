@@ -11,6 +11,6 @@ namespace Engine {
         CameraSystem();
 
         void onUpdate(float dt) override {}; // Does nothing, but satisfies virtual function
-        void updateCamera(Camera* mainCamera);
+        void updateCamera(Camera* mainCamera, float alpha = 1.0f);
     };
 }
\ No newline at end of file
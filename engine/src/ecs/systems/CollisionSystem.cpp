@@ -4,7 +4,11 @@
 #include "../components/CircleColliderComponent.h"
 #include "../components/PolygonColliderComponent.h"
 #include "../components/RigidBodyComponent.h"
+#include "../components/TilemapComponent.h"
+#include "../components/VelocityComponent.h"
 #include "../Entity.h"
+#include "core/JobSystem.h"
+#include "PhysicsTransform.h"
 #include <algorithm>
 #include <limits>
 #include <glm/glm.hpp>
@@ -13,31 +17,10 @@
 namespace Engine
 {
 
-    // Same hierarchy world-matrix logic as renderer
-    static glm::mat4 GetWorldMatrix(Engine::Entity *e)
-    {
-        if (!e)
-            return glm::mat4(1.0f);
-
-        auto tr = e->getComponent<Engine::TransformComponent>();
-        if (!tr)
-            return glm::mat4(1.0f);
-
-        glm::mat4 local(1.0f);
-        local = glm::translate(local, glm::vec3(tr->position, 0.0f));
-        local = glm::rotate(local, glm::radians(tr->rotation), glm::vec3(0, 0, 1));
-        local = glm::scale(local, glm::vec3(tr->scale, 1.0f));
-
-        if (e->getParent())
-            return GetWorldMatrix(e->getParent()) * local;
-        return local;
-    }
-
-    static glm::vec2 TransformPoint(const glm::mat4 &m, const glm::vec2 &p)
-    {
-        glm::vec4 r = m * glm::vec4(p.x, p.y, 0.0f, 1.0f);
-        return {r.x, r.y};
-    }
+    // World matrices shared with NavigationSystem, rotation through StableMath
+    using PhysicsTransform::GetWorldMatrix;
+    using PhysicsTransform::RotateZ;
+    using PhysicsTransform::TransformPoint;
 
     // Extract world XY scale from matrix columns (robust for parent scaling)
     static glm::vec2 ExtractScaleXY(const glm::mat4 &m)
@@ -62,18 +45,31 @@ namespace Engine
         return a + ab * t;
     }
 
-    static void ProjectPolygon(const std::vector<glm::vec2> &verts, const glm::vec2 &axis, float &outMin, float &outMax)
+    static void ProjectPolygon(const ConvexPolygonView &poly, const glm::vec2 &axis, float &outMin, float &outMax)
     {
         outMin = std::numeric_limits<float>::max();
         outMax = -std::numeric_limits<float>::max();
-        for (const auto &v : verts)
+        for (uint32_t i = 0; i < poly.count; i++)
         {
-            float p = glm::dot(v, axis);
+            float p = glm::dot(poly.vertices[i], axis);
             outMin = std::min(outMin, p);
             outMax = std::max(outMax, p);
         }
     }
 
+    // Largest stretch the linear part of m applies to any direction (spectral norm of the 2x2 block)
+    static float MaxLinearScale(const glm::mat4 &m)
+    {
+        float a = m[0][0], b = m[1][0], c = m[0][1], d = m[1][1];
+        float frob2 = a * a + b * b + c * c + d * d;
+        float det = a * d - b * c;
+        float disc = std::max(frob2 * frob2 - 4.0f * det * det, 0.0f);
+        return std::sqrt((frob2 + std::sqrt(disc)) * 0.5f);
+    }
+
+    static const glm::vec2 boxCorners[4] = {{-0.5f, -0.5f}, {0.5f, -0.5f}, {0.5f, 0.5f}, {-0.5f, 0.5f}};
+    static const glm::vec2 boxNormals[4] = {{0.0f, -1.0f}, {1.0f, 0.0f}, {0.0f, 1.0f}, {-1.0f, 0.0f}};
+
     static void ProjectCircle(const glm::vec2 &center, float radius, const glm::vec2 &axis, float &outMin, float &outMax)
     {
         float c = glm::dot(center, axis);
@@ -104,318 +100,1307 @@ namespace Engine
         }
     }
 
-    static glm::vec2 GetCircleWorldCenter(Engine::Entity *e, Engine::CircleColliderComponent *c)
+    // Ray against a convex polygon (Cyrus-Beck). dir must be normalized. Origin inside gives t = 0.
+    static bool RayPolygon(const glm::vec2 &origin, const glm::vec2 &dir, float maxDist,
+                           const ConvexPolygonView &poly, float &tHit, glm::vec2 &normal)
+    {
+        if (poly.count < 3)
+            return false;
+
+        float tEnter = 0.0f;
+        float tExit = maxDist;
+        glm::vec2 enterNormal(0.0f);
+
+        for (uint32_t i = 0; i < poly.count; i++)
+        {
+            const glm::vec2 &p1 = poly.vertices[i];
+            const glm::vec2 &n = poly.normals[i];
+
+            float num = glm::dot(n, p1 - origin);
+            float denom = glm::dot(n, dir);
+
+            if (std::abs(denom) < 1e-8f)
+            {
+                if (num < 0.0f)
+                    return false; // parallel and outside this edge
+                continue;
+            }
+
+            float t = num / denom;
+            if (denom < 0.0f)
+            {
+                if (t > tEnter)
+                {
+                    tEnter = t;
+                    enterNormal = n;
+                }
+            }
+            else
+            {
+                tExit = std::min(tExit, t);
+            }
+
+            if (tEnter > tExit)
+                return false;
+        }
+
+        tHit = tEnter;
+        normal = enterNormal == glm::vec2(0.0f) ? -dir : enterNormal;
+        return true;
+    }
+
+    // Ray against a circle. dir must be normalized. Origin inside gives t = 0.
+    static bool RayCircle(const glm::vec2 &origin, const glm::vec2 &dir, float maxDist,
+                          const glm::vec2 &center, float radius, float &tHit, glm::vec2 &normal)
+    {
+        glm::vec2 m = origin - center;
+        float b = glm::dot(m, dir);
+        float c = glm::dot(m, m) - radius * radius;
+        if (c > 0.0f && b > 0.0f)
+            return false;
+
+        float disc = b * b - c;
+        if (disc < 0.0f)
+            return false;
+
+        float t = std::max(-b - std::sqrt(disc), 0.0f);
+        if (t > maxDist)
+            return false;
+
+        glm::vec2 toHit = origin + dir * t - center;
+        tHit = t;
+        normal = glm::dot(toHit, toHit) > 1e-10f ? glm::normalize(toHit) : -dir;
+        return true;
+    }
+
+    // Circle of given radius swept along a ray against a convex polygon: ray against the
+    // polygon rounded by radius, i.e. its edges pushed out plus a circle at every vertex.
+    static bool SweptCirclePolygon(const glm::vec2 &origin, const glm::vec2 &dir, float maxDist, float radius,
+                                   const ConvexPolygonView &poly, float &tHit, glm::vec2 &normal)
+    {
+        if (poly.count < 3)
+            return false;
+
+        const glm::vec2 *verts = poly.vertices;
+        uint32_t count = poly.count;
+
+        // Already overlapping at the start
+        float t0;
+        glm::vec2 n0;
+        if (RayPolygon(origin, dir, 0.0f, poly, t0, n0))
+        {
+            tHit = 0.0f;
+            normal = -dir;
+            return true;
+        }
+        for (uint32_t i = 0; i < count; i++)
+        {
+            glm::vec2 away = origin - ClosestPointOnSegment(verts[i], verts[(i + 1) % count], origin);
+            float dist2 = glm::dot(away, away);
+            if (dist2 <= radius * radius)
+            {
+                tHit = 0.0f;
+                normal = dist2 > 1e-10f ? away / std::sqrt(dist2) : -dir;
+                return true;
+            }
+        }
+
+        float best = maxDist;
+        bool found = false;
+
+        for (uint32_t i = 0; i < count; i++)
+        {
+            const glm::vec2 &p1 = verts[i];
+            const glm::vec2 &n = poly.normals[i];
+            glm::vec2 edge = verts[(i + 1) % count] - p1;
+            float edgeLen2 = glm::dot(edge, edge);
+            if (edgeLen2 < 1e-10f)
+                continue;
+
+            float denom = glm::dot(n, dir);
+            if (denom >= 0.0f)
+                continue; // moving away from this face
+
+            glm::vec2 a = p1 + n * radius;
+            float t = glm::dot(n, a - origin) / denom;
+            if (t < 0.0f || t > best)
+                continue;
+
+            float s = glm::dot(origin + dir * t - a, edge) / edgeLen2;
+            if (s < 0.0f || s > 1.0f)
+                continue;
+
+            best = t;
+            normal = n;
+            found = true;
+        }
+
+        for (uint32_t i = 0; i < count; i++)
+        {
+            float t;
+            glm::vec2 n;
+            if (RayCircle(origin, dir, best, verts[i], radius, t, n) && (!found || t < best))
+            {
+                best = t;
+                normal = n;
+                found = true;
+            }
+        }
+
+        tHit = best;
+        return found;
+    }
+
+    // Translational time of impact of two convex polygons: the relative motion cast against their Minkowski
+    // difference, whose edge normals are the edge normals of both. Per axis the projections overlap in one
+    // time interval; the polygons touch in the intersection of all of them. t is a fraction of motion.
+    static bool SweptPolygonPolygon(const ConvexPolygonView &moving, const glm::vec2 &motion, const ConvexPolygonView &target, float &tHit)
+    {
+        if (moving.count < 3 || target.count < 3)
+            return false;
+
+        float tEnter = 0.0f;
+        float tExit = 1.0f;
+        auto clipAxis = [&](const glm::vec2 &axis)
+        {
+            float minA, maxA, minB, maxB;
+            ProjectPolygon(moving, axis, minA, maxA);
+            ProjectPolygon(target, axis, minB, maxB);
+            float speed = glm::dot(motion, axis);
+            if (std::abs(speed) < 1e-8f)
+                return maxA >= minB && minA <= maxB; // parallel: overlapping for the whole step or never
+
+            float t0 = (minB - maxA) / speed;
+            float t1 = (maxB - minA) / speed;
+            if (t0 > t1)
+                std::swap(t0, t1);
+            tEnter = std::max(tEnter, t0);
+            tExit = std::min(tExit, t1);
+            return tEnter <= tExit;
+        };
+
+        for (uint32_t i = 0; i < moving.count; i++)
+        {
+            if (!clipAxis(moving.normals[i]))
+                return false;
+        }
+        for (uint32_t i = 0; i < target.count; i++)
+        {
+            if (!clipAxis(target.normals[i]))
+                return false;
+        }
+
+        tHit = tEnter;
+        return true;
+    }
+
+    // Posun entity (alebo rodica) skriptom ci editorom medzi krokmi: pozicia na zaciatku kroku nie je ta, s ktorou skoncil minuly
+    static bool MovedOutsideStep(Engine::Entity *e, glm::vec2 &delta, bool &rotated)
+    {
+        delta = glm::vec2(0.0f);
+        rotated = false;
+        for (; e; e = e->getParent())
+        {
+            auto tr = e->getComponent<TransformComponent>();
+            if (!tr)
+                continue;
+            delta += tr->previousPosition - tr->simulatedPosition;
+            rotated |= tr->previousRotation != tr->simulatedRotation;
+        }
+        return rotated || delta != glm::vec2(0.0f);
+    }
+
+    static uint64_t MakePairKey(Entity *a, Entity *b)
     {
-        glm::mat4 world = GetWorldMatrix(e);
-        glm::mat4 col(1.0f);
-        col = glm::translate(col, glm::vec3(c->offset, 0.0f));
-        glm::vec4 p = (world * col) * glm::vec4(0, 0, 0, 1);
-        return {p.x, p.y};
+        uint32_t ha = static_cast<uint32_t>(a->getHandle());
+        uint32_t hb = static_cast<uint32_t>(b->getHandle());
+        if (ha > hb)
+            std::swap(ha, hb);
+        return (static_cast<uint64_t>(ha) << 32) | hb;
     }
 
-    static float GetCircleWorldRadius(Engine::Entity *e, Engine::CircleColliderComponent *c)
+    // Invokes the callback of a given collider type that matches the trigger phase
+    template <typename TCollider>
+    static void InvokeTriggerCallback(Entity *self, Entity *other, CollisionSystem::TriggerPhase phase)
     {
-        glm::mat4 world = GetWorldMatrix(e);
-        glm::vec2 xAxis = glm::vec2(world[0][0], world[1][0]); // transformed (1,0)
-        glm::vec2 yAxis = glm::vec2(world[0][1], world[1][1]); // transformed (0,1)
-        float sx = glm::length(xAxis);
-        float sy = glm::length(yAxis);
-        float s = (sx + sy) * 0.5f;
-        return c->radius * s;
+        auto c = self->getComponent<TCollider>();
+        if (!c)
+            return;
+
+        switch (phase)
+        {
+        case CollisionSystem::TriggerPhase::Enter:
+            if (c->onTriggerEnter)
+                c->onTriggerEnter(other);
+            break;
+        case CollisionSystem::TriggerPhase::Stay:
+            if (c->onTriggerStay)
+                c->onTriggerStay(other);
+            break;
+        case CollisionSystem::TriggerPhase::Exit:
+            if (c->onTriggerExit)
+                c->onTriggerExit(other);
+            break;
+        }
+    }
+
+    static void NotifyTrigger(Entity *self, Entity *other, CollisionSystem::TriggerPhase phase)
+    {
+        InvokeTriggerCallback<BoxColliderComponent>(self, other, phase);
+        InvokeTriggerCallback<CircleColliderComponent>(self, other, phase);
+        InvokeTriggerCallback<PolygonColliderComponent>(self, other, phase);
     }
 
     CollisionSystem::CollisionSystem()
     {
         requireComponent<TransformComponent>();
+        setUpdateStages(SystemStage::FixedStep);
+        m_LayerMatrix.fill(CollisionLayer::All);
+    }
+
+    void CollisionSystem::onFixedUpdate(float dt)
+    {
+        buildProxies();
+        resolveContinuousCollisions();
+        generateCandidatePairs();
+        runNarrowphase();
+
+        // Solving stays on this thread, in sorted contact order
+        prepareContactConstraints();
+        warmStartContacts();
+        for (int i = 0; i < m_VelocityIterations; ++i)
+            solveVelocityConstraints();
+        for (int i = 0; i < m_PositionIterations; ++i)
+            solvePositionConstraints();
+        storeContactImpulses();
+        applySolverResults();
+
+        updateSleep(dt);
+
+        updateTriggers();
+        fireTriggerEvents();
+    }
+
+    void CollisionSystem::setTriggerInterval(int steps)
+    {
+        m_TriggerInterval = std::max(steps, 1);
+        m_StepsUntilTriggers = 0;
+    }
+
+    void CollisionSystem::removeEntity(Entity *entity)
+    {
+        System::removeEntity(entity);
+        m_WakeAllBodies = true;
+
+        // Queries between steps must not hand out the removed entity
+        for (auto &proxy : m_Proxies)
+        {
+            if (proxy.entity == entity)
+                proxy.entity = nullptr;
+        }
+
+        // Udalosti, ktore este len cakaju na callback, by mali visiaci ukazovatel
+        for (auto *events : {&m_FiringEvents, &m_RemovalExits})
+        {
+            for (auto &ev : *events)
+            {
+                if (ev.a == entity || ev.b == entity)
+                    ev.a = ev.b = nullptr;
+            }
+        }
+        m_TriggerEvents.erase(std::remove_if(m_TriggerEvents.begin(), m_TriggerEvents.end(), [entity](const TriggerEvent &ev)
+                                             { return ev.a == entity || ev.b == entity; }),
+                              m_TriggerEvents.end());
+
+        // Entita este zije, druha strana kazdeho paru dostane Exit hned. Callback moze znicit dalsiu entitu,
+        // vnoreny removeEntity potom vynuluje jej udalosti aj v tomto zozname.
+        size_t firstExit = m_RemovalExits.size();
+        for (auto it = m_TriggerPairs.begin(); it != m_TriggerPairs.end();)
+        {
+            if (it->second.a == entity || it->second.b == entity)
+            {
+                Entity *other = it->second.a == entity ? it->second.b : it->second.a;
+                m_RemovalExits.push_back({other, entity, TriggerPhase::Exit});
+                it = m_TriggerPairs.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+        std::sort(m_RemovalExits.begin() + firstExit, m_RemovalExits.end(), [](const TriggerEvent &l, const TriggerEvent &r)
+                  { return static_cast<uint32_t>(l.a->getHandle()) < static_cast<uint32_t>(r.a->getHandle()); });
+
+        for (size_t i = firstExit; i < m_RemovalExits.size(); ++i)
+        {
+            TriggerEvent ev = m_RemovalExits[i];
+            if (ev.a && ev.b)
+                NotifyTrigger(ev.a, ev.b, ev.phase);
+        }
+        m_RemovalExits.resize(firstExit);
+    }
+
+    void CollisionSystem::setSolverIterations(int velocityIterations, int positionIterations)
+    {
+        m_VelocityIterations = std::max(velocityIterations, 1);
+        m_PositionIterations = std::max(positionIterations, 0);
+    }
+
+    void CollisionSystem::setLayerMatrix(const std::array<uint32_t, MaxCollisionLayers> &matrix)
+    {
+        m_LayerMatrix = matrix;
+    }
+
+    void CollisionSystem::buildProxies()
+    {
+        m_Proxies.clear();
+
+        for (auto entity : getSystemEntities())
+        {
+            if (auto tilemap = entity->getComponent<TilemapComponent>())
+                buildTilemapProxies(entity, *tilemap);
+
+            auto box = entity->getComponent<BoxColliderComponent>();
+            auto circ = entity->getComponent<CircleColliderComponent>();
+            auto poly = entity->getComponent<PolygonColliderComponent>();
+
+            if (!box && !circ && !poly)
+                continue;
+
+            ColliderProxy proxy;
+            proxy.entity = entity;
+            proxy.body = entity->getComponent<RigidBodyComponent>();
+
+            proxy.friction = defaultFriction;
+
+            if (proxy.body)
+            {
+                if (m_WakeAllBodies && proxy.body->getBodyType() == BodyType::Dynamic)
+                    proxy.body->wake();
+
+                if (proxy.body->getBodyType() == BodyType::Dynamic)
+                {
+                    proxy.isActive = proxy.body->isAwake;
+                    proxy.invMass = proxy.body->mass > 0.0f ? 1.0f / proxy.body->mass : 0.0f;
+                }
+                else if (proxy.body->getBodyType() == BodyType::Kinematic)
+                {
+                    proxy.isActive = proxy.body->velocity != glm::vec2(0.0f);
+                }
+
+                // Kinematic velocity still feeds friction and bounces of the dynamic partner
+                if (proxy.body->getBodyType() != BodyType::Static)
+                    proxy.velocity = proxy.body->velocity;
+                proxy.friction = proxy.body->friction;
+                proxy.restitution = proxy.body->restitution;
+            }
+            else if (auto vel = entity->getComponent<VelocityComponent>())
+            {
+                proxy.isActive = vel->velocity != glm::vec2(0.0f);
+            }
+
+            proxy.hasPolygon = box || poly;
+            proxy.hasCircle = circ != nullptr;
+            proxy.isTrigger = (box && box->isTrigger) || (circ && circ->isTrigger) || (poly && poly->isTrigger);
+
+            // Layer flags come from the first collider found, same priority as before
+            if (box)
+            {
+                proxy.layer = box->layer;
+                proxy.mask = box->mask;
+            }
+            else if (circ)
+            {
+                proxy.layer = circ->layer;
+                proxy.mask = circ->mask;
+            }
+            else
+            {
+                proxy.layer = poly->layer;
+                proxy.mask = poly->mask;
+            }
+            proxy.collidesWith = layerReach(proxy.layer) & proxy.mask;
+
+            glm::vec2 lo(std::numeric_limits<float>::max());
+            glm::vec2 hi(-std::numeric_limits<float>::max());
+
+            if (proxy.hasPolygon)
+            {
+                buildPolygonPieces(entity, proxy);
+                for (const auto &v : proxy.vertices)
+                {
+                    lo = glm::min(lo, v);
+                    hi = glm::max(hi, v);
+                }
+            }
+
+            if (circ)
+            {
+                glm::mat4 world = GetWorldMatrix(entity);
+                glm::vec2 s = ExtractScaleXY(world);
+                proxy.circleCenter = TransformPoint(world, circ->offset);
+                proxy.circleRadius = circ->radius * (s.x + s.y) * 0.5f;
+
+                lo = glm::min(lo, proxy.circleCenter - glm::vec2(proxy.circleRadius));
+                hi = glm::max(hi, proxy.circleCenter + glm::vec2(proxy.circleRadius));
+            }
+
+            proxy.aabbMin = lo;
+            proxy.aabbMax = hi;
+
+            glm::vec2 delta;
+            bool rotated;
+            if (MovedOutsideStep(entity, delta, rotated))
+            {
+                // Stara poloha je novy AABB posunuty spat; pri otoceni pokryje obe polohy kruh okolo stredu
+                glm::vec2 sweptLo = lo, sweptHi = hi;
+                if (rotated)
+                {
+                    glm::vec2 center = (lo + hi) * 0.5f;
+                    float radius = glm::length(hi - lo) * 0.5f;
+                    sweptLo = center - glm::vec2(radius);
+                    sweptHi = center + glm::vec2(radius);
+                }
+                sweptLo = glm::min(sweptLo, sweptLo - delta) - glm::vec2(penetrationSlop);
+                sweptHi = glm::max(sweptHi, sweptHi - delta) + glm::vec2(penetrationSlop);
+                m_MovedBounds.push_back({sweptLo, sweptHi});
+
+                if (proxy.body && proxy.body->getBodyType() == BodyType::Dynamic)
+                {
+                    proxy.body->wake();
+                    proxy.isActive = true;
+                }
+            }
+
+            m_Proxies.push_back(std::move(proxy));
+        }
+
+        // Co lezalo na presunutom tele alebo ho teraz prekryva, sa prebudi; dalsie telesa ostrova
+        // sa prebudia cez kontakty s nimi v updateSleep
+        for (const auto &[sweptLo, sweptHi] : m_MovedBounds)
+        {
+            for (auto &proxy : m_Proxies)
+            {
+                if (!proxy.body || proxy.body->getBodyType() != BodyType::Dynamic || proxy.body->isAwake)
+                    continue;
+                if (proxy.aabbMax.x < sweptLo.x || proxy.aabbMin.x > sweptHi.x ||
+                    proxy.aabbMax.y < sweptLo.y || proxy.aabbMin.y > sweptHi.y)
+                    continue;
+                proxy.body->wake();
+                proxy.isActive = true;
+            }
+        }
+        m_MovedBounds.clear();
+
+        m_WakeAllBodies = false;
+    }
+
+    bool CollisionSystem::sweepTimeOfImpact(const ColliderProxy &proxy, glm::vec2 delta, const ColliderProxy &other, float &toi)
+    {
+        float distance = glm::length(delta);
+        if (distance <= 0.0f)
+            return false;
+        glm::vec2 dir = delta / distance;
+
+        // Dotyk uz na zaciatku riesi bezny kontakt, CCD hlada prvy novy dotyk na drahe
+        toi = 1.0f;
+        bool found = false;
+        auto consider = [&](float t)
+        {
+            if (t > 0.0f && t < toi)
+            {
+                toi = t;
+                found = true;
+            }
+        };
+
+        float t;
+        glm::vec2 normal;
+        if (proxy.hasPolygon)
+        {
+            // Proxy geometry sits at the end of the step, the sweep starts delta back
+            m_SweepVertices.resize(proxy.vertices.size());
+            for (size_t i = 0; i < proxy.vertices.size(); ++i)
+                m_SweepVertices[i] = proxy.vertices[i] - delta;
+
+            for (const auto &piece : proxy.pieces)
+            {
+                ConvexPolygonView view = pieceView(proxy, piece, m_SweepVertices.data());
+                view.center -= delta;
+
+                for (const auto &otherPiece : other.pieces)
+                {
+                    if (SweptPolygonPolygon(view, delta, pieceView(other, otherPiece), t))
+                        consider(t);
+                }
+                // Kruh oproti kusu ide opacnym smerom
+                if (other.hasCircle && SweptCirclePolygon(other.circleCenter, -dir, distance, other.circleRadius, view, t, normal))
+                    consider(t / distance);
+            }
+        }
+
+        if (proxy.hasCircle)
+        {
+            glm::vec2 start = proxy.circleCenter - delta;
+            for (const auto &otherPiece : other.pieces)
+            {
+                if (SweptCirclePolygon(start, dir, distance, proxy.circleRadius, pieceView(other, otherPiece), t, normal))
+                    consider(t / distance);
+            }
+            if (other.hasCircle && RayCircle(start, dir, distance, other.circleCenter, proxy.circleRadius + other.circleRadius, t, normal))
+                consider(t / distance);
+        }
+
+        return found;
+    }
+
+    bool CollisionSystem::proxiesOverlap(const ColliderProxy &a, const ColliderProxy &b)
+    {
+        glm::vec2 normal;
+        float penetration;
+
+        for (const auto &pieceA : a.pieces)
+        {
+            ConvexPolygonView view = pieceView(a, pieceA);
+            for (const auto &pieceB : b.pieces)
+            {
+                if (checkPolygonPolygon(view, pieceView(b, pieceB), normal, penetration))
+                    return true;
+            }
+            if (b.hasCircle && checkCirclePolygon(b.circleCenter, b.circleRadius, view, normal, penetration))
+                return true;
+        }
+
+        if (a.hasCircle)
+        {
+            for (const auto &pieceB : b.pieces)
+            {
+                if (checkCirclePolygon(a.circleCenter, a.circleRadius, pieceView(b, pieceB), normal, penetration))
+                    return true;
+            }
+            if (b.hasCircle && checkCircleCircle(a.circleCenter, a.circleRadius, b.circleCenter, b.circleRadius, normal, penetration))
+                return true;
+        }
+
+        return false;
+    }
+
+    void CollisionSystem::resolveContinuousCollisions()
+    {
+        bool collected = false;
+
+        for (auto &proxy : m_Proxies)
+        {
+            RigidBodyComponent *rb = proxy.body;
+            if (!rb || !rb->continuousCollision || rb->getBodyType() != BodyType::Dynamic || !rb->isAwake || proxy.isTrigger)
+                continue;
+
+            // Pohyb pocas kroku vo svete, pre dieta aj s pohybom rodica
+            glm::vec2 delta = TransformPoint(GetWorldMatrix(proxy.entity), glm::vec2(0.0f)) -
+                              TransformPoint(GetWorldMatrix(proxy.entity, true), glm::vec2(0.0f));
+            glm::vec2 extent = proxy.aabbMax - proxy.aabbMin;
+            float minExtent = std::min(extent.x, extent.y);
+            float distance = glm::length(delta);
+            if (minExtent <= 0.0f || distance <= minExtent * ccdMotionThreshold)
+                continue;
+
+            if (!collected)
+            {
+                m_StaticProxies.clear();
+                for (uint32_t i = 0; i < m_Proxies.size(); ++i)
+                {
+                    const ColliderProxy &p = m_Proxies[i];
+                    bool isStatic = !p.body || p.body->getBodyType() == BodyType::Static;
+                    if (isStatic && !p.isActive && !p.isTrigger)
+                        m_StaticProxies.push_back(i);
+                }
+                collected = true;
+            }
+
+            // Swept AABB broadphase over the whole path
+            glm::vec2 sweptMin = glm::min(proxy.aabbMin, proxy.aabbMin - delta);
+            glm::vec2 sweptMax = glm::max(proxy.aabbMax, proxy.aabbMax - delta);
+
+            // Earliest analytic time of impact against every static proxy on the path
+            float hitTime = 1.0f;
+            for (uint32_t index : m_StaticProxies)
+            {
+                const ColliderProxy &other = m_Proxies[index];
+                if (other.aabbMin.x > sweptMax.x || sweptMin.x > other.aabbMax.x ||
+                    other.aabbMin.y > sweptMax.y || sweptMin.y > other.aabbMax.y)
+                    continue;
+                if (!canCollide(proxy, other))
+                    continue;
+
+                float toi;
+                if (sweepTimeOfImpact(proxy, delta, other, toi))
+                    hitTime = std::min(hitTime, toi);
+            }
+
+            // Stop just past the first touch so the regular contact registers and the solver stops the body
+            float stopTime = hitTime + ccdContactDepth / distance;
+            if (stopTime >= 1.0f)
+                continue;
+
+            glm::vec2 correction = -delta * (1.0f - stopTime);
+            ApplyWorldTranslation(proxy.entity, correction);
+
+            for (auto &v : proxy.vertices)
+                v += correction;
+            for (auto &piece : proxy.pieces)
+                piece.center += correction;
+            proxy.circleCenter += correction;
+            proxy.aabbMin += correction;
+            proxy.aabbMax += correction;
+        }
+    }
+
+    uint32_t CollisionSystem::layerReach(uint32_t layer) const
+    {
+        uint32_t reach = 0;
+        for (int bit = 0; bit < MaxCollisionLayers && layer; ++bit)
+        {
+            if (layer & (1u << bit))
+            {
+                reach |= m_LayerMatrix[bit];
+                layer &= ~(1u << bit);
+            }
+        }
+        return reach;
+    }
+
+    void CollisionSystem::buildLayerGroups()
+    {
+        for (auto &group : m_LayerGroups)
+        {
+            group.members.clear();
+            group.maxWidth = 0.0f;
+        }
+        m_TriggerMembers.clear();
+        m_TriggerMaxWidth = 0.0f;
+
+        for (uint32_t i = 0; i < m_Proxies.size(); ++i)
+        {
+            const ColliderProxy &proxy = m_Proxies[i];
+            if (!proxy.layer)
+                continue;
+
+            // Sensors never reach the solid sweep or the solver
+            if (proxy.isTrigger)
+            {
+                m_TriggerMembers.push_back(i);
+                m_TriggerMaxWidth = std::max(m_TriggerMaxWidth, proxy.aabbMax.x - proxy.aabbMin.x);
+                continue;
+            }
+
+            // Usually a handful of distinct layer values, a linear search is enough
+            auto it = std::find_if(m_LayerGroups.begin(), m_LayerGroups.end(), [&](const LayerGroup &g)
+                                   { return g.layer == proxy.layer; });
+            if (it == m_LayerGroups.end())
+            {
+                LayerGroup group;
+                group.layer = proxy.layer;
+                m_LayerGroups.push_back(std::move(group));
+                it = m_LayerGroups.end() - 1;
+            }
+
+            it->members.push_back(i);
+            it->maxWidth = std::max(it->maxWidth, proxy.aabbMax.x - proxy.aabbMin.x);
+        }
+
+        // Skupiny vrstiev, ktore uz nikto nepouziva, by sa s kazdou zmenou vrstvy len hromadili
+        m_LayerGroups.erase(std::remove_if(m_LayerGroups.begin(), m_LayerGroups.end(), [](const LayerGroup &g)
+                                           { return g.members.empty(); }),
+                            m_LayerGroups.end());
+
+        for (auto &group : m_LayerGroups)
+        {
+            group.reach = layerReach(group.layer);
+            std::sort(group.members.begin(), group.members.end(), [this](uint32_t l, uint32_t r)
+                      {
+                float lx = m_Proxies[l].aabbMin.x;
+                float rx = m_Proxies[r].aabbMin.x;
+                return lx < rx || (lx == rx && l < r); });
+        }
+
+        std::sort(m_TriggerMembers.begin(), m_TriggerMembers.end(), [this](uint32_t l, uint32_t r)
+                  {
+            float lx = m_Proxies[l].aabbMin.x;
+            float rx = m_Proxies[r].aabbMin.x;
+            return lx < rx || (lx == rx && l < r); });
+    }
+
+    void CollisionSystem::generateCandidatePairs()
+    {
+        m_CandidatePairs.clear();
+        buildLayerGroups();
+
+        auto tryPair = [this](uint32_t ia, uint32_t ib)
+        {
+            const ColliderProxy &a = m_Proxies[ia];
+            const ColliderProxy &b = m_Proxies[ib];
+
+            if (b.aabbMin.y > a.aabbMax.y || a.aabbMin.y > b.aabbMax.y)
+                return;
+
+            // Nothing moves between two resting/static proxies
+            if (!a.isActive && !b.isActive)
+                return;
+
+            if (!canCollide(a, b))
+                return;
+
+            m_CandidatePairs.emplace_back(std::min(ia, ib), std::max(ia, ib));
+        };
+
+        for (size_t gi = 0; gi < m_LayerGroups.size(); ++gi)
+        {
+            const LayerGroup &groupA = m_LayerGroups[gi];
+            if (groupA.members.empty())
+                continue;
+
+            for (size_t gj = gi; gj < m_LayerGroups.size(); ++gj)
+            {
+                const LayerGroup &groupB = m_LayerGroups[gj];
+                if (groupB.members.empty())
+                    continue;
+                if (!(groupA.layer & groupB.reach) || !(groupB.layer & groupA.reach))
+                    continue;
+
+                const auto &listA = groupA.members;
+                const auto &listB = groupB.members;
+
+                if (gi == gj)
+                {
+                    for (size_t i = 0; i < listA.size(); ++i)
+                    {
+                        const ColliderProxy &a = m_Proxies[listA[i]];
+                        for (size_t j = i + 1; j < listA.size(); ++j)
+                        {
+                            if (m_Proxies[listA[j]].aabbMin.x > a.aabbMax.x)
+                                break;
+                            tryPair(listA[i], listA[j]);
+                        }
+                    }
+                    continue;
+                }
+
+                // Two sorted lists: for every a, start in B where a member could still reach a.min.x
+                for (uint32_t ia : listA)
+                {
+                    const ColliderProxy &a = m_Proxies[ia];
+                    float startX = a.aabbMin.x - groupB.maxWidth;
+                    auto first = std::lower_bound(listB.begin(), listB.end(), startX, [this](uint32_t index, float x)
+                                                  { return m_Proxies[index].aabbMin.x < x; });
+
+                    for (auto it = first; it != listB.end(); ++it)
+                    {
+                        const ColliderProxy &b = m_Proxies[*it];
+                        if (b.aabbMin.x > a.aabbMax.x)
+                            break;
+                        if (b.aabbMax.x < a.aabbMin.x)
+                            continue;
+                        tryPair(ia, *it);
+                    }
+                }
+            }
+        }
     }
 
-    void CollisionSystem::onUpdate(float dt)
+    void CollisionSystem::runNarrowphase()
     {
-        auto entities = getSystemEntities();
+        m_Contacts.clear();
 
-        // O(n^2) check - acceptable for moderate entity counts
-        for (size_t i = 0; i < entities.size(); ++i)
+        auto testRange = [this](size_t begin, size_t end, unsigned slot)
         {
-            for (size_t j = i + 1; j < entities.size(); ++j)
+            auto &out = m_ThreadContacts[slot];
+            for (size_t i = begin; i < end; ++i)
             {
-                processCollisionPair(entities[i], entities[j]);
+                const auto &pair = m_CandidatePairs[i];
+                processCollisionPair(pair.first, pair.second, out);
             }
+        };
+
+        if (m_CandidatePairs.size() >= parallelPairThreshold)
+        {
+            m_ThreadContacts.resize(std::max<size_t>(m_ThreadContacts.size(), JobSystem::getSlotCount()));
+            JobSystem::parallelFor(m_CandidatePairs.size(), narrowphaseGrain, testRange);
+        }
+        else
+        {
+            m_ThreadContacts.resize(std::max<size_t>(m_ThreadContacts.size(), 1));
+            testRange(0, m_CandidatePairs.size(), 0);
+        }
+
+        for (auto &buffer : m_ThreadContacts)
+        {
+            m_Contacts.insert(m_Contacts.end(), buffer.begin(), buffer.end());
+            buffer.clear();
         }
+
+        // Contacts of one proxy pair come from a single buffer in generation order, so a stable
+        // sort by handles and then proxies gives the same sequence no matter how the pairs were split.
+        // Proxies matter for tilemaps, whose chunks are separate proxies of one entity.
+        std::stable_sort(m_Contacts.begin(), m_Contacts.end(), [](const Contact &l, const Contact &r)
+                         {
+                             uint64_t lk = MakePairKey(l.a, l.b);
+                             uint64_t rk = MakePairKey(r.a, r.b);
+                             if (lk != rk)
+                                 return lk < rk;
+                             if (l.proxyA != r.proxyA)
+                                 return l.proxyA < r.proxyA;
+                             return l.proxyB < r.proxyB; });
     }
 
-    void CollisionSystem::processCollisionPair(Entity *a, Entity *b)
+    void CollisionSystem::processCollisionPair(uint32_t ia, uint32_t ib, std::vector<Contact> &out)
     {
-        auto boxA = a->getComponent<BoxColliderComponent>();
-        auto circA = a->getComponent<CircleColliderComponent>();
-        auto polyA = a->getComponent<PolygonColliderComponent>();
+        // Keep the lower handle first so the merged contact list sorts by (entityA, entityB)
+        if (static_cast<uint32_t>(m_Proxies[ia].entity->getHandle()) > static_cast<uint32_t>(m_Proxies[ib].entity->getHandle()))
+            std::swap(ia, ib);
 
-        auto boxB = b->getComponent<BoxColliderComponent>();
-        auto circB = b->getComponent<CircleColliderComponent>();
-        auto polyB = b->getComponent<PolygonColliderComponent>();
-
-        if (!((boxA || circA || polyA) && (boxB || circB || polyB)))
-            return;
+        const ColliderProxy &a = m_Proxies[ia];
+        const ColliderProxy &b = m_Proxies[ib];
 
         glm::vec2 normal;
         float penetration;
 
-        if ((boxA || polyA) && (boxB || polyB))
+        // Concave colliders touch along several pieces; pieces pushing along the same normal
+        // collapse into the deepest one, since the solver only works along normals
+        size_t firstContact = out.size();
+        auto addContact = [&](glm::vec2 n, float depth)
         {
-            if (checkPolygonPolygon(getWorldVertices(a), getWorldVertices(b), normal, penetration))
+            for (size_t i = firstContact; i < out.size(); ++i)
             {
-                handleCollisionResult(a, b, normal, penetration);
+                if (glm::dot(out[i].normal, n) >= contactMergeNormalTolerance)
+                {
+                    out[i].penetration = std::max(out[i].penetration, depth);
+                    return;
+                }
+            }
+            out.push_back({a.entity, b.entity, ia, ib, n, depth});
+        };
+
+        for (const auto &pieceA : a.pieces)
+        {
+            for (const auto &pieceB : b.pieces)
+            {
+                glm::vec2 d = pieceA.center - pieceB.center;
+                float reach = pieceA.radius + pieceB.radius;
+                if (glm::dot(d, d) > reach * reach)
+                    continue;
+
+                if (checkPolygonPolygon(pieceView(a, pieceA), pieceView(b, pieceB), normal, penetration))
+                {
+                    addContact(normal, penetration);
+                }
             }
         }
 
-        if (circA && circB)
+        if (a.hasCircle && b.hasCircle)
         {
-            if (checkCircleCircle(a, circA, b, circB, normal, penetration))
+            if (checkCircleCircle(a.circleCenter, a.circleRadius, b.circleCenter, b.circleRadius, normal, penetration))
             {
-                handleCollisionResult(a, b, normal, penetration);
+                addContact(normal, penetration);
             }
         }
 
-        if (circA && (boxB || polyB))
+        if (a.hasCircle)
         {
-            if (checkCirclePolygon(a, circA, getWorldVertices(b), normal, penetration))
+            for (const auto &pieceB : b.pieces)
             {
-                handleCollisionResult(a, b, normal, penetration);
+                float reach = a.circleRadius + pieceB.radius;
+                glm::vec2 d = a.circleCenter - pieceB.center;
+                if (glm::dot(d, d) > reach * reach)
+                    continue;
+
+                if (checkCirclePolygon(a.circleCenter, a.circleRadius, pieceView(b, pieceB), normal, penetration))
+                {
+                    addContact(normal, penetration);
+                }
             }
         }
 
-        if ((boxA || polyA) && circB)
+        if (b.hasCircle)
         {
-            if (checkCirclePolygon(b, circB, getWorldVertices(a), normal, penetration))
+            for (const auto &pieceA : a.pieces)
             {
-                handleCollisionResult(a, b, -normal, penetration);
+                float reach = b.circleRadius + pieceA.radius;
+                glm::vec2 d = b.circleCenter - pieceA.center;
+                if (glm::dot(d, d) > reach * reach)
+                    continue;
+
+                if (checkCirclePolygon(b.circleCenter, b.circleRadius, pieceView(a, pieceA), normal, penetration))
+                {
+                    addContact(-normal, penetration);
+                }
             }
         }
     }
 
-    void CollisionSystem::handleCollisionResult(Entity *a, Entity *b, glm::vec2 normal, float penetration)
+    uint32_t CollisionSystem::findIsland(uint32_t i)
     {
-        if (!canCollide(a, b))
-            return;
+        while (m_IslandParent[i] != i)
+        {
+            m_IslandParent[i] = m_IslandParent[m_IslandParent[i]];
+            i = m_IslandParent[i];
+        }
+        return i;
+    }
+
+    void CollisionSystem::updateSleep(float dt)
+    {
+        auto isDynamic = [](const ColliderProxy &p)
+        { return p.body && p.body->getBodyType() == BodyType::Dynamic; };
 
-        if (isTriggerPair(a, b))
+        // 1) Sleep timers from the velocities left after resolution
+        for (auto &proxy : m_Proxies)
         {
-            fireTriggerEvents(a, b);
-            return;
+            if (!isDynamic(proxy) || !proxy.body->isAwake)
+                continue;
+
+            RigidBodyComponent *rb = proxy.body;
+            float speedSq = glm::dot(rb->velocity, rb->velocity);
+            if (!rb->allowSleep || speedSq > sleepLinearTolerance * sleepLinearTolerance)
+                rb->sleepTime = 0.0f;
+            else
+                rb->sleepTime += dt;
+        }
+
+        // 2) Islands from solid contacts. Pairs are only generated with an active partner,
+        //    so any contact touching a sleeping body means it got hit and has to wake up.
+        m_IslandParent.resize(m_Proxies.size());
+        for (uint32_t i = 0; i < m_IslandParent.size(); ++i)
+            m_IslandParent[i] = i;
+
+        for (const auto &contact : m_Contacts)
+        {
+            const ColliderProxy &pa = m_Proxies[contact.proxyA];
+            const ColliderProxy &pb = m_Proxies[contact.proxyB];
+
+            if (isDynamic(pa) && !pa.body->isAwake)
+                pa.body->wake();
+            if (isDynamic(pb) && !pb.body->isAwake)
+                pb.body->wake();
+
+            if (isDynamic(pa) && isDynamic(pb))
+                m_IslandParent[findIsland(contact.proxyA)] = findIsland(contact.proxyB);
+        }
+
+        // 3) An island sleeps only when its least-rested body has rested long enough
+        m_IslandMinSleep.assign(m_Proxies.size(), std::numeric_limits<float>::max());
+        for (uint32_t i = 0; i < m_Proxies.size(); ++i)
+        {
+            if (!isDynamic(m_Proxies[i]) || !m_Proxies[i].body->isAwake)
+                continue;
+
+            float &minSleep = m_IslandMinSleep[findIsland(i)];
+            minSleep = std::min(minSleep, m_Proxies[i].body->sleepTime);
+        }
+
+        for (uint32_t i = 0; i < m_Proxies.size(); ++i)
+        {
+            if (!isDynamic(m_Proxies[i]) || !m_Proxies[i].body->isAwake)
+                continue;
+
+            if (m_IslandMinSleep[findIsland(i)] >= timeToSleep)
+                m_Proxies[i].body->sleep();
         }
+    }
 
-        resolveCollision(a, b, normal, penetration);
+    bool CollisionSystem::canCollide(const ColliderProxy &a, const ColliderProxy &b) const
+    {
+        // Proxies of one entity (tilemap chunks) never touch each other
+        return a.entity != b.entity && (a.layer & b.collidesWith) && (b.layer & a.collidesWith);
     }
 
-    bool CollisionSystem::canCollide(Entity *a, Entity *b)
+    void CollisionSystem::updateTriggers()
     {
-        uint32_t lA = 0, mA = 0, lB = 0, mB = 0;
+        // Between trigger steps the cached pairs stay as they are, otherwise they would all exit
+        if (--m_StepsUntilTriggers > 0)
+            return;
+        m_StepsUntilTriggers = m_TriggerInterval;
 
-        auto getFlags = [](Entity *e, uint32_t &l, uint32_t &m)
+        for (size_t i = 0; i < m_TriggerMembers.size(); ++i)
         {
-            if (auto c = e->getComponent<BoxColliderComponent>())
+            const ColliderProxy &trigger = m_Proxies[m_TriggerMembers[i]];
+            if (!trigger.entity)
+                continue;
+
+            // Solid colliders: the same walk as the spatial queries, limited to layers the trigger reaches
+            queryBroadphase(trigger.aabbMin, trigger.aabbMax, trigger.collidesWith, false);
+            for (uint32_t index : m_QueryCandidates)
             {
-                l = c->layer;
-                m = c->mask;
-                return;
+                const ColliderProxy &other = m_Proxies[index];
+                if (canCollide(trigger, other) && proxiesOverlap(trigger, other))
+                    recordTriggerOverlap(trigger.entity, other.entity);
             }
-            if (auto c = e->getComponent<CircleColliderComponent>())
+
+            // Other triggers: forward sweep over the sorted trigger list
+            for (size_t j = i + 1; j < m_TriggerMembers.size(); ++j)
             {
-                l = c->layer;
-                m = c->mask;
-                return;
+                const ColliderProxy &other = m_Proxies[m_TriggerMembers[j]];
+                if (other.aabbMin.x > trigger.aabbMax.x)
+                    break;
+                if (!other.entity || other.aabbMin.y > trigger.aabbMax.y || trigger.aabbMin.y > other.aabbMax.y)
+                    continue;
+                if (canCollide(trigger, other) && proxiesOverlap(trigger, other))
+                    recordTriggerOverlap(trigger.entity, other.entity);
+            }
+        }
+
+        collectTriggerExits();
+    }
+
+    void CollisionSystem::recordTriggerOverlap(Entity *a, Entity *b)
+    {
+        auto [it, inserted] = m_TriggerPairs.try_emplace(MakePairKey(a, b));
+        TriggerPair &pair = it->second;
+
+        if (inserted)
+        {
+            pair.a = a;
+            pair.b = b;
+            pair.touched = true;
+            m_TriggerEvents.push_back({a, b, TriggerPhase::Enter});
+            return;
+        }
+
+        // A pair can be reported more than once per frame (e.g. box + circle on one entity)
+        if (pair.touched)
+            return;
+
+        pair.touched = true;
+        if (wantsTriggerStay(a, b))
+            m_TriggerEvents.push_back({pair.a, pair.b, TriggerPhase::Stay});
+    }
+
+    void CollisionSystem::collectTriggerExits()
+    {
+        size_t firstExit = m_TriggerEvents.size();
+
+        for (auto it = m_TriggerPairs.begin(); it != m_TriggerPairs.end();)
+        {
+            if (!it->second.touched)
+            {
+                m_TriggerEvents.push_back({it->second.a, it->second.b, TriggerPhase::Exit});
+                it = m_TriggerPairs.erase(it);
             }
-            if (auto c = e->getComponent<PolygonColliderComponent>())
+            else
             {
-                l = c->layer;
-                m = c->mask;
-                return;
+                it->second.touched = false;
+                ++it;
             }
-        };
-
-        getFlags(a, lA, mA);
-        getFlags(b, lB, mB);
+        }
 
-        return (lA & mB) && (lB & mA);
+        // Hash map order differs between runs and platforms; callbacks fire in pair order
+        std::sort(m_TriggerEvents.begin() + firstExit, m_TriggerEvents.end(), [](const TriggerEvent &l, const TriggerEvent &r)
+                  { return MakePairKey(l.a, l.b) < MakePairKey(r.a, r.b); });
     }
 
-    bool CollisionSystem::isTriggerPair(Entity *a, Entity *b)
+    bool CollisionSystem::wantsTriggerStay(Entity *a, Entity *b)
     {
-        auto isT = [](Entity *e)
+        auto hasStay = [](Entity *e)
         {
             auto ba = e->getComponent<BoxColliderComponent>();
             auto ca = e->getComponent<CircleColliderComponent>();
             auto pa = e->getComponent<PolygonColliderComponent>();
-            return (ba && ba->isTrigger) || (ca && ca->isTrigger) || (pa && pa->isTrigger);
+            return (ba && ba->onTriggerStay) || (ca && ca->onTriggerStay) || (pa && pa->onTriggerStay);
         };
-        return isT(a) || isT(b);
+        return hasStay(a) || hasStay(b);
     }
 
-    void CollisionSystem::fireTriggerEvents(Entity *a, Entity *b)
+    void CollisionSystem::fireTriggerEvents()
     {
-        auto notify = [](Entity *self, Entity *other)
+        if (m_TriggerEvents.empty())
+            return;
+
+        // Swap out the queue so callbacks that touch colliders cannot invalidate the iteration;
+        // removeEntity clears the events of an entity a callback destroys
+        m_FiringEvents.swap(m_TriggerEvents);
+
+        for (size_t i = 0; i < m_FiringEvents.size(); ++i)
         {
-            if (auto c = self->getComponent<BoxColliderComponent>())
-                if (c->onTriggerEnter)
-                    c->onTriggerEnter(other);
-            if (auto c = self->getComponent<CircleColliderComponent>())
-                if (c->onTriggerEnter)
-                    c->onTriggerEnter(other);
-            if (auto c = self->getComponent<PolygonColliderComponent>())
-                if (c->onTriggerEnter)
-                    c->onTriggerEnter(other);
-        };
-        notify(a, b);
-        notify(b, a);
+            const TriggerEvent &ev = m_FiringEvents[i];
+            TriggerPhase phase = ev.phase;
+            if (!ev.a || !ev.b)
+                continue;
+            NotifyTrigger(ev.a, ev.b, phase);
+            if (!ev.a || !ev.b)
+                continue;
+            NotifyTrigger(ev.b, ev.a, phase);
+        }
+
+        m_FiringEvents.clear();
+        if (m_TriggerEvents.empty())
+            m_TriggerEvents.swap(m_FiringEvents);
+    }
+
+    ConvexPolygonView CollisionSystem::pieceView(const ColliderProxy &proxy, const ProxyPiece &piece, const glm::vec2 *vertices)
+    {
+        ConvexPolygonView view;
+        view.vertices = (vertices ? vertices : proxy.vertices.data()) + piece.first;
+        view.normals = proxy.normals.data() + piece.first;
+        view.count = piece.count;
+        view.center = piece.center;
+        return view;
     }
 
-    std::vector<glm::vec2> CollisionSystem::getWorldVertices(Entity *ent)
+    void CollisionSystem::buildPolygonPieces(Entity *ent, ColliderProxy &proxy)
     {
-        std::vector<glm::vec2> out;
+        proxy.vertices.clear();
+        proxy.normals.clear();
+        proxy.pieces.clear();
         if (!ent)
-            return out;
+            return;
 
         glm::mat4 world = GetWorldMatrix(ent);
 
-        // Polygon collider
+        // Polygon collider: pieces and normals were prepared when its vertices last changed
         if (auto poly = ent->getComponent<PolygonColliderComponent>())
         {
             // collider local transform: offset + collider rotation
             glm::mat4 col(1.0f);
             col = glm::translate(col, glm::vec3(poly->offset, 0.0f));
-            col = glm::rotate(col, glm::radians(poly->rotation), glm::vec3(0, 0, 1));
+            col = RotateZ(col, poly->rotation);
 
             glm::mat4 M = world * col;
 
-            out.reserve(poly->vertices.size());
-            for (const auto &v : poly->vertices)
-            {
-                glm::vec4 p = M * glm::vec4(v.x, v.y, 0.0f, 1.0f);
-                out.push_back(glm::vec2(p.x, p.y));
-            }
-            return out;
+            for (const auto &piece : poly->getConvexPieces())
+                appendPiece(proxy, M, piece.vertices.data(), piece.normals.data(), piece.vertices.size(), piece.center, piece.radius);
+            return;
         }
 
-        // Box collider (treat as 4 vertices around origin)
+        // Box collider: unit square scaled to size
         if (auto box = ent->getComponent<BoxColliderComponent>())
         {
-            glm::vec2 half = box->size * 0.5f;
-
-            glm::vec2 corners[4] = {
-                {-half.x, -half.y},
-                {half.x, -half.y},
-                {half.x, half.y},
-                {-half.x, half.y}};
-
             glm::mat4 col(1.0f);
             col = glm::translate(col, glm::vec3(box->offset, 0.0f));
-            col = glm::rotate(col, glm::radians(box->rotation), glm::vec3(0, 0, 1));
-
-            glm::mat4 M = world * col;
+            col = RotateZ(col, box->rotation);
+            col = glm::scale(col, glm::vec3(box->size, 1.0f));
 
-            out.reserve(4);
-            for (int i = 0; i < 4; i++)
-            {
-                glm::vec4 p = M * glm::vec4(corners[i].x, corners[i].y, 0.0f, 1.0f);
-                out.push_back(glm::vec2(p.x, p.y));
-            }
-            return out;
+            appendPiece(proxy, world * col, boxCorners, boxNormals, 4, glm::vec2(0.0f), glm::length(boxCorners[0]));
         }
-
-        return out;
     }
 
-    bool CollisionSystem::checkPolygonPolygon(const std::vector<glm::vec2> &vertsA, const std::vector<glm::vec2> &vertsB, glm::vec2 &normal, float &penetration)
+    void CollisionSystem::appendPiece(ColliderProxy &proxy, const glm::mat4 &M, const glm::vec2 *verts,
+                                      const glm::vec2 *normals, size_t count, glm::vec2 center, float radius)
     {
-        if (vertsA.empty() || vertsB.empty())
-            return false;
+        // Normals go through the inverse transpose of the linear part; the determinant sign
+        // keeps them pointing outwards when the transform mirrors the shape
+        float a = M[0][0], b = M[1][0], c = M[0][1], d = M[1][1];
+        float flip = (a * d - b * c) < 0.0f ? -1.0f : 1.0f;
+
+        ProxyPiece piece;
+        piece.first = static_cast<uint32_t>(proxy.vertices.size());
+        piece.count = static_cast<uint32_t>(count);
+        piece.center = TransformPoint(M, center);
+        piece.radius = radius * MaxLinearScale(M);
+
+        for (size_t i = 0; i < count; i++)
+        {
+            proxy.vertices.push_back(TransformPoint(M, verts[i]));
 
-        float minOverlap = std::numeric_limits<float>::max();
-        glm::vec2 smallestAxis;
+            glm::vec2 n = glm::vec2(d * normals[i].x - c * normals[i].y, -b * normals[i].x + a * normals[i].y) * flip;
+            float len2 = glm::dot(n, n);
+            proxy.normals.push_back(len2 > 1e-12f ? n / std::sqrt(len2) : normals[i]);
+        }
+        proxy.pieces.push_back(piece);
+    }
 
-        auto getAxes = [](const std::vector<glm::vec2> &verts)
-        {
-            std::vector<glm::vec2> axes;
-            for (size_t i = 0; i < verts.size(); i++)
-            {
-                glm::vec2 p1 = verts[i];
-                glm::vec2 p2 = verts[(i + 1) % verts.size()];
-                glm::vec2 edge = p2 - p1;
-                axes.push_back(glm::normalize(glm::vec2(-edge.y, edge.x)));
-            }
-            return axes;
-        };
+    void CollisionSystem::buildTilemapProxies(Entity *entity, TilemapComponent &tilemap)
+    {
+        if (!tilemap.collision || tilemap.tileSize.x <= 0 || tilemap.tileSize.y <= 0)
+            return;
 
-        std::vector<glm::vec2> allAxes = getAxes(vertsA);
-        std::vector<glm::vec2> axesB = getAxes(vertsB);
-        allAxes.insert(allAxes.end(), axesB.begin(), axesB.end());
+        glm::mat4 world = GetWorldMatrix(entity);
+        glm::vec2 tileSize(tilemap.tileSize);
 
-        for (const auto &axis : allAxes)
+        // Mapa chunkov je zoradena podla suradnic, poradie proxy je rovnake na kazdom stroji
+        for (const auto &[key, chunk] : tilemap.getChunks())
         {
-            float minA = std::numeric_limits<float>::max(), maxA = -std::numeric_limits<float>::max();
-            float minB = std::numeric_limits<float>::max(), maxB = -std::numeric_limits<float>::max();
+            const auto &rects = tilemap.getChunkColliders(key);
+            if (rects.empty())
+                continue;
 
-            for (const auto &v : vertsA)
+            ColliderProxy proxy;
+            proxy.entity = entity;
+            proxy.hasPolygon = true;
+            proxy.isTilemapChunk = true;
+            proxy.friction = defaultFriction;
+            proxy.layer = tilemap.collisionLayer;
+            proxy.mask = tilemap.collisionMask;
+            proxy.collidesWith = layerReach(proxy.layer) & proxy.mask;
+
+            glm::ivec2 firstTile = TilemapComponent::ChunkCoords(key) * TilemapComponent::ChunkSize;
+            for (const auto &rect : rects)
             {
-                float p = glm::dot(v, axis);
-                minA = std::min(minA, p);
-                maxA = std::max(maxA, p);
+                // Jednotkovy stvorec boxu natiahnuty na obdlznik dlazdic
+                glm::vec2 size = glm::vec2(rect.w, rect.h) * tileSize;
+                glm::vec2 center = (glm::vec2(firstTile.x + rect.x, firstTile.y + rect.y)) * tileSize + size * 0.5f;
+
+                glm::mat4 col = glm::translate(glm::mat4(1.0f), glm::vec3(center, 0.0f));
+                col = glm::scale(col, glm::vec3(size, 1.0f));
+                appendPiece(proxy, world * col, boxCorners, boxNormals, 4, glm::vec2(0.0f), glm::length(boxCorners[0]));
             }
-            for (const auto &v : vertsB)
+
+            proxy.aabbMin = proxy.vertices[0];
+            proxy.aabbMax = proxy.vertices[0];
+            for (const auto &v : proxy.vertices)
             {
-                float p = glm::dot(v, axis);
-                minB = std::min(minB, p);
-                maxB = std::max(maxB, p);
+                proxy.aabbMin = glm::min(proxy.aabbMin, v);
+                proxy.aabbMax = glm::max(proxy.aabbMax, v);
             }
+            m_Proxies.push_back(std::move(proxy));
+        }
+    }
 
-            if (maxA < minB || maxB < minA)
-                return false;
+    bool CollisionSystem::checkPolygonPolygon(const ConvexPolygonView &a, const ConvexPolygonView &b, glm::vec2 &normal, float &penetration)
+    {
+        if (a.count < 3 || b.count < 3)
+            return false;
 
-            float overlap = std::min(maxA, maxB) - std::max(minA, minB);
-            if (overlap < minOverlap)
+        float minOverlap = std::numeric_limits<float>::max();
+        glm::vec2 smallestAxis(0.0f);
+
+        auto testAxes = [&](const ConvexPolygonView &source)
+        {
+            for (uint32_t i = 0; i < source.count; i++)
             {
-                minOverlap = overlap;
-                smallestAxis = axis;
+                const glm::vec2 &axis = source.normals[i];
+
+                float minA, maxA, minB, maxB;
+                ProjectPolygon(a, axis, minA, maxA);
+                ProjectPolygon(b, axis, minB, maxB);
+
+                if (maxA < minB || maxB < minA)
+                    return false;
+
+                float overlap = std::min(maxA, maxB) - std::max(minA, minB);
+                if (overlap < minOverlap)
+                {
+                    minOverlap = overlap;
+                    smallestAxis = axis;
+                }
             }
-        }
+            return true;
+        };
+
+        if (!testAxes(a) || !testAxes(b))
+            return false;
 
         penetration = minOverlap;
         normal = smallestAxis;
-
-        glm::vec2 centerA(0), centerB(0);
-        for (auto &v : vertsA)
-            centerA += v;
-        centerA /= (float)vertsA.size();
-        for (auto &v : vertsB)
-            centerB += v;
-        centerB /= (float)vertsB.size();
-        if (glm::dot(centerA - centerB, normal) < 0)
+        if (glm::dot(a.center - b.center, normal) < 0)
             normal = -normal;
 
         return true;
     }
 
-    bool Engine::CollisionSystem::checkCircleCircle(
-        Entity *a, CircleColliderComponent *ca,
-        Entity *b, CircleColliderComponent *cb,
+    bool CollisionSystem::checkCircleCircle(
+        glm::vec2 centerA, float rA,
+        glm::vec2 centerB, float rB,
         glm::vec2 &normal, float &penetration)
     {
-        if (!a || !b || !ca || !cb)
-            return false;
-
-        // World matrices (include parent transform + scale)
-        glm::mat4 wA = GetWorldMatrix(a);
-        glm::mat4 wB = GetWorldMatrix(b);
-
-        // Circle centers in world space (offset is local to entity)
-        glm::vec2 centerA = TransformPoint(wA, ca->offset);
-        glm::vec2 centerB = TransformPoint(wB, cb->offset);
-
-        // World radius (conservative for non-uniform scale)
-        glm::vec2 sA = ExtractScaleXY(wA);
-        glm::vec2 sB = ExtractScaleXY(wB);
-        float rA = ca->radius * std::max(std::abs(sA.x), std::abs(sA.y));
-        float rB = cb->radius * std::max(std::abs(sB.x), std::abs(sB.y));
-
         glm::vec2 delta = centerA - centerB;
         float distSq = glm::dot(delta, delta);
         float rSum = rA + rB;
@@ -439,39 +1424,24 @@ namespace Engine
         return true;
     }
 
-    bool Engine::CollisionSystem::checkCirclePolygon(
-        Entity *circleEnt, CircleColliderComponent *circ,
-        const std::vector<glm::vec2> &polyVerts,
+    bool CollisionSystem::checkCirclePolygon(
+        glm::vec2 center, float radius,
+        const ConvexPolygonView &poly,
         glm::vec2 &normal, float &penetration)
     {
-        if (!circleEnt || !circ || polyVerts.size() < 3)
+        if (poly.count < 3)
             return false;
 
-        // World center + radius
-        glm::mat4 wC = GetWorldMatrix(circleEnt);
-        glm::vec2 center = TransformPoint(wC, circ->offset);
-
-        glm::vec2 sC = ExtractScaleXY(wC);
-        float radius = circ->radius * std::max(std::abs(sC.x), std::abs(sC.y));
-
         float minOverlap = std::numeric_limits<float>::max();
         glm::vec2 bestAxis(0.0f);
 
         // 1) SAT vs polygon edge normals
-        for (size_t i = 0; i < polyVerts.size(); i++)
+        for (uint32_t i = 0; i < poly.count; i++)
         {
-            const glm::vec2 &p1 = polyVerts[i];
-            const glm::vec2 &p2 = polyVerts[(i + 1) % polyVerts.size()];
-            glm::vec2 edge = p2 - p1;
-
-            float len2 = glm::dot(edge, edge);
-            if (len2 < 1e-10f)
-                continue;
-
-            glm::vec2 axis = glm::normalize(glm::vec2(-edge.y, edge.x));
+            const glm::vec2 &axis = poly.normals[i];
 
             float minP, maxP, minC, maxC;
-            ProjectPolygon(polyVerts, axis, minP, maxP);
+            ProjectPolygon(poly, axis, minP, maxP);
             ProjectCircle(center, radius, axis, minC, maxC);
 
             if (maxP < minC || maxC < minP)
@@ -486,13 +1456,13 @@ namespace Engine
         }
 
         // 2) Extra axis: center -> closest point on polygon (fixes corner cases)
-        glm::vec2 closest = polyVerts[0];
+        glm::vec2 closest = poly.vertices[0];
         float bestDistSq = std::numeric_limits<float>::max();
 
-        for (size_t i = 0; i < polyVerts.size(); i++)
+        for (uint32_t i = 0; i < poly.count; i++)
         {
-            const glm::vec2 &a = polyVerts[i];
-            const glm::vec2 &b = polyVerts[(i + 1) % polyVerts.size()];
+            const glm::vec2 &a = poly.vertices[i];
+            const glm::vec2 &b = poly.vertices[(i + 1) % poly.count];
             glm::vec2 cp = ClosestPointOnSegment(a, b, center);
             float d2 = glm::dot(center - cp, center - cp);
             if (d2 < bestDistSq)
@@ -506,10 +1476,10 @@ namespace Engine
         float toLen2 = glm::dot(toCenter, toCenter);
         if (toLen2 > 1e-10f)
         {
-            glm::vec2 axis = glm::normalize(toCenter);
+            glm::vec2 axis = toCenter / std::sqrt(toLen2);
 
             float minP, maxP, minC, maxC;
-            ProjectPolygon(polyVerts, axis, minP, maxP);
+            ProjectPolygon(poly, axis, minP, maxP);
             ProjectCircle(center, radius, axis, minC, maxC);
 
             if (maxP < minC || maxC < minP)
@@ -527,54 +1497,350 @@ namespace Engine
         penetration = minOverlap;
         normal = bestAxis;
 
-        glm::vec2 polyCenter(0.0f);
-        for (auto &v : polyVerts)
-            polyCenter += v;
-        polyCenter /= (float)polyVerts.size();
-
-        if (glm::dot(center - polyCenter, normal) < 0.0f)
+        if (glm::dot(center - poly.center, normal) < 0.0f)
             normal = -normal;
 
         return true;
     }
 
-    void CollisionSystem::resolveCollision(Entity *a, Entity *b, glm::vec2 normal, float penetration)
+    void CollisionSystem::prepareContactConstraints()
+    {
+        m_Constraints.clear();
+
+        uint64_t runKey = 0;
+        uint32_t ordinal = 0;
+
+        for (const auto &contact : m_Contacts)
+        {
+            const ColliderProxy &pa = m_Proxies[contact.proxyA];
+            const ColliderProxy &pb = m_Proxies[contact.proxyB];
+
+            float invMassSum = pa.invMass + pb.invMass;
+            if (invMassSum <= 0.0f)
+                continue;
+
+            // Contacts of one pair are adjacent after the sort, count them for the cache slot
+            uint64_t key = MakePairKey(contact.a, contact.b);
+            ordinal = (key == runKey && !m_Constraints.empty()) ? ordinal + 1 : 0;
+            runKey = key;
+            if (ordinal >= maxContactsPerPair)
+                continue;
+
+            ContactConstraint c;
+            c.proxyA = contact.proxyA;
+            c.proxyB = contact.proxyB;
+            c.pairKey = key;
+            c.ordinal = ordinal;
+            c.normal = contact.normal;
+            c.tangent = glm::vec2(-contact.normal.y, contact.normal.x);
+            c.penetration = contact.penetration;
+            c.normalMass = 1.0f / invMassSum;
+            c.friction = std::sqrt(pa.friction * pb.friction);
+
+            // Bounce target from the approach speed before any impulse is applied
+            float restitution = std::max(pa.restitution, pb.restitution);
+            float vn = glm::dot(pa.velocity - pb.velocity, c.normal);
+            c.velocityBias = vn < -restitutionThreshold ? -restitution * vn : 0.0f;
+
+            auto it = m_ContactCache.find(key);
+            if (it != m_ContactCache.end() && ordinal < it->second.count)
+            {
+                const CachedImpulse &cached = it->second.impulses[ordinal];
+                if (glm::dot(cached.normal, c.normal) > warmStartNormalTolerance)
+                {
+                    c.normalImpulse = cached.normalImpulse;
+                    c.tangentImpulse = cached.tangentImpulse;
+                }
+            }
+
+            m_Constraints.push_back(c);
+        }
+    }
+
+    void CollisionSystem::warmStartContacts()
+    {
+        for (const auto &c : m_Constraints)
+        {
+            ColliderProxy &pa = m_Proxies[c.proxyA];
+            ColliderProxy &pb = m_Proxies[c.proxyB];
+
+            glm::vec2 impulse = c.normal * c.normalImpulse + c.tangent * c.tangentImpulse;
+            pa.velocity += impulse * pa.invMass;
+            pb.velocity -= impulse * pb.invMass;
+        }
+    }
+
+    void CollisionSystem::solveVelocityConstraints()
+    {
+        for (auto &c : m_Constraints)
+        {
+            ColliderProxy &pa = m_Proxies[c.proxyA];
+            ColliderProxy &pb = m_Proxies[c.proxyB];
+
+            // Friction first, bounded by the normal impulse from the previous pass
+            float vt = glm::dot(pa.velocity - pb.velocity, c.tangent);
+            float maxFriction = c.friction * c.normalImpulse;
+            float newTangent = std::clamp(c.tangentImpulse - vt * c.normalMass, -maxFriction, maxFriction);
+            glm::vec2 impulse = c.tangent * (newTangent - c.tangentImpulse);
+            c.tangentImpulse = newTangent;
+            pa.velocity += impulse * pa.invMass;
+            pb.velocity -= impulse * pb.invMass;
+
+            // Non-penetration: the accumulated impulse may only push
+            float vn = glm::dot(pa.velocity - pb.velocity, c.normal);
+            float newNormal = std::max(c.normalImpulse + (c.velocityBias - vn) * c.normalMass, 0.0f);
+            impulse = c.normal * (newNormal - c.normalImpulse);
+            c.normalImpulse = newNormal;
+            pa.velocity += impulse * pa.invMass;
+            pb.velocity -= impulse * pb.invMass;
+        }
+    }
+
+    void CollisionSystem::solvePositionConstraints()
+    {
+        for (const auto &c : m_Constraints)
+        {
+            ColliderProxy &pa = m_Proxies[c.proxyA];
+            ColliderProxy &pb = m_Proxies[c.proxyB];
+
+            // Bodies move only by translation, so the remaining depth follows from the corrections so far
+            float depth = c.penetration - glm::dot(pa.positionCorrection - pb.positionCorrection, c.normal);
+            float correction = std::min(penetrationPercent * (depth - penetrationSlop), maxPositionCorrection);
+            if (correction <= 0.0f)
+                continue;
+
+            glm::vec2 push = c.normal * (correction * c.normalMass);
+            pa.positionCorrection += push * pa.invMass;
+            pb.positionCorrection -= push * pb.invMass;
+        }
+    }
+
+    void CollisionSystem::storeContactImpulses()
     {
-        auto rbA = a->getComponent<RigidBodyComponent>();
-        auto rbB = b->getComponent<RigidBodyComponent>();
-        auto transA = a->getComponent<TransformComponent>();
-        auto transB = b->getComponent<TransformComponent>();
+        for (auto &[key, entry] : m_ContactCache)
+            entry.count = 0;
 
-        bool aDyn = rbA && rbA->bodyType == BodyType::Dynamic;
-        bool bDyn = rbB && rbB->bodyType == BodyType::Dynamic;
-        if (!aDyn && !bDyn)
+        for (const auto &c : m_Constraints)
+        {
+            ContactCacheEntry &entry = m_ContactCache[c.pairKey];
+            entry.impulses[c.ordinal] = {c.normal, c.normalImpulse, c.tangentImpulse};
+            entry.count = std::max(entry.count, c.ordinal + 1);
+        }
+
+        for (auto it = m_ContactCache.begin(); it != m_ContactCache.end();)
+        {
+            if (it->second.count == 0)
+                it = m_ContactCache.erase(it);
+            else
+                ++it;
+        }
+    }
+
+    void CollisionSystem::applySolverResults()
+    {
+        if (m_Constraints.empty())
             return;
 
-        if (aDyn && !bDyn)
+        for (auto &proxy : m_Proxies)
+        {
+            if (proxy.invMass <= 0.0f)
+                continue;
+
+            proxy.body->velocity = proxy.velocity;
+            if (proxy.positionCorrection != glm::vec2(0.0f))
+                ApplyWorldTranslation(proxy.entity, proxy.positionCorrection);
+        }
+    }
+
+    void CollisionSystem::queryBroadphase(glm::vec2 lo, glm::vec2 hi, uint32_t mask, bool includeTriggers)
+    {
+        m_QueryCandidates.clear();
+
+        // No member starting before lo.x - widest width can still reach lo.x
+        auto collect = [&](const std::vector<uint32_t> &members, float maxWidth, bool checkLayer)
         {
-            transA->position += normal * penetration;
+            auto first = std::lower_bound(members.begin(), members.end(), lo.x - maxWidth, [this](uint32_t index, float x)
+                                          { return m_Proxies[index].aabbMin.x < x; });
+
+            for (auto it = first; it != members.end(); ++it)
+            {
+                const ColliderProxy &proxy = m_Proxies[*it];
+                if (proxy.aabbMin.x > hi.x)
+                    break;
+
+                if (!proxy.entity || (checkLayer && !(proxy.layer & mask)))
+                    continue;
+                if (proxy.aabbMax.x < lo.x || proxy.aabbMin.y > hi.y || proxy.aabbMax.y < lo.y)
+                    continue;
+
+                m_QueryCandidates.push_back(*it);
+            }
+        };
+
+        for (const auto &group : m_LayerGroups)
+        {
+            if ((group.layer & mask) && !group.members.empty())
+                collect(group.members, group.maxWidth, false);
+        }
+
+        // Triggers share one list across layers, so the mask is checked per member
+        if (includeTriggers)
+            collect(m_TriggerMembers, m_TriggerMaxWidth, true);
+    }
+
+    bool CollisionSystem::castShape(glm::vec2 origin, float radius, glm::vec2 direction, float maxDistance, uint32_t mask, RaycastHit &hit)
+    {
+        float length = glm::length(direction);
+        if (length < 1e-8f || maxDistance < 0.0f)
+            return false;
+
+        glm::vec2 dir = direction / length;
+        glm::vec2 end = origin + dir * maxDistance;
+        queryBroadphase(glm::min(origin, end) - glm::vec2(radius), glm::max(origin, end) + glm::vec2(radius), mask, false);
+
+        float best = maxDistance;
+        bool found = false;
+
+        for (uint32_t index : m_QueryCandidates)
+        {
+            const ColliderProxy &proxy = m_Proxies[index];
+            if (proxy.isTrigger)
+                continue;
+
+            float t;
+            glm::vec2 n;
+
+            for (const auto &piece : proxy.pieces)
+            {
+                ConvexPolygonView view = pieceView(proxy, piece);
+                bool touched = radius > 0.0f
+                                   ? SweptCirclePolygon(origin, dir, best, radius, view, t, n)
+                                   : RayPolygon(origin, dir, best, view, t, n);
+                if (touched && (!found || t < best))
+                {
+                    best = t;
+                    hit.entity = proxy.entity;
+                    hit.normal = n;
+                    found = true;
+                }
+            }
+
+            if (proxy.hasCircle && RayCircle(origin, dir, best, proxy.circleCenter, proxy.circleRadius + radius, t, n) && (!found || t < best))
+            {
+                best = t;
+                hit.entity = proxy.entity;
+                hit.normal = n;
+                found = true;
+            }
         }
-        else if (!aDyn && bDyn)
+
+        if (found)
         {
-            transB->position -= normal * penetration;
+            hit.distance = best;
+            hit.point = origin + dir * best - hit.normal * radius;
         }
-        else
+        return found;
+    }
+
+    bool CollisionSystem::raycast(glm::vec2 origin, glm::vec2 direction, float maxDistance, uint32_t mask, RaycastHit &hit)
+    {
+        return castShape(origin, 0.0f, direction, maxDistance, mask, hit);
+    }
+
+    bool CollisionSystem::castCircle(glm::vec2 origin, float radius, glm::vec2 direction, float maxDistance, uint32_t mask, RaycastHit &hit)
+    {
+        return castShape(origin, std::max(radius, 0.0f), direction, maxDistance, mask, hit);
+    }
+
+    void CollisionSystem::addQueryResult(const ColliderProxy &proxy)
+    {
+        if (proxy.isTilemapChunk && std::find(m_QueryResults.begin(), m_QueryResults.end(), proxy.entity) != m_QueryResults.end())
+            return;
+        m_QueryResults.push_back(proxy.entity);
+    }
+
+    const std::vector<Entity *> &CollisionSystem::overlapCircle(glm::vec2 center, float radius, uint32_t mask)
+    {
+        m_QueryResults.clear();
+        queryBroadphase(center - glm::vec2(radius), center + glm::vec2(radius), mask);
+
+        glm::vec2 normal;
+        float penetration;
+        for (uint32_t index : m_QueryCandidates)
         {
-            transA->position += normal * (penetration * 0.5f);
-            transB->position -= normal * (penetration * 0.5f);
+            const ColliderProxy &proxy = m_Proxies[index];
+            bool touched = proxy.hasCircle && checkCircleCircle(center, radius, proxy.circleCenter, proxy.circleRadius, normal, penetration);
+            for (size_t i = 0; i < proxy.pieces.size() && !touched; ++i)
+                touched = checkCirclePolygon(center, radius, pieceView(proxy, proxy.pieces[i]), normal, penetration);
+
+            if (touched)
+                addQueryResult(proxy);
         }
+        return m_QueryResults;
+    }
+
+    const std::vector<Entity *> &CollisionSystem::overlapBox(glm::vec2 center, glm::vec2 size, uint32_t mask)
+    {
+        m_QueryResults.clear();
+        glm::vec2 half = glm::abs(size) * 0.5f;
+        queryBroadphase(center - half, center + half, mask);
 
-        if (aDyn)
+        glm::vec2 corners[4];
+        for (int i = 0; i < 4; i++)
+            corners[i] = center + boxCorners[i] * half * 2.0f;
+
+        ConvexPolygonView query;
+        query.vertices = corners;
+        query.normals = boxNormals;
+        query.count = 4;
+        query.center = center;
+
+        glm::vec2 normal;
+        float penetration;
+        for (uint32_t index : m_QueryCandidates)
         {
-            float dot = glm::dot(rbA->velocity, normal);
-            if (dot < 0)
-                rbA->velocity -= normal * dot;
+            const ColliderProxy &proxy = m_Proxies[index];
+            bool touched = proxy.hasCircle && checkCirclePolygon(proxy.circleCenter, proxy.circleRadius, query, normal, penetration);
+            for (size_t i = 0; i < proxy.pieces.size() && !touched; ++i)
+                touched = checkPolygonPolygon(query, pieceView(proxy, proxy.pieces[i]), normal, penetration);
+
+            if (touched)
+                addQueryResult(proxy);
         }
-        if (bDyn)
+        return m_QueryResults;
+    }
+
+    const std::vector<Entity *> &CollisionSystem::overlapPoint(glm::vec2 point, uint32_t mask)
+    {
+        m_QueryResults.clear();
+        queryBroadphase(point, point, mask);
+
+        for (uint32_t index : m_QueryCandidates)
         {
-            float dot = glm::dot(rbB->velocity, normal);
-            if (dot > 0)
-                rbB->velocity -= normal * dot;
+            const ColliderProxy &proxy = m_Proxies[index];
+
+            bool inside = false;
+            if (proxy.hasCircle)
+            {
+                glm::vec2 d = point - proxy.circleCenter;
+                inside = glm::dot(d, d) <= proxy.circleRadius * proxy.circleRadius;
+            }
+
+            // Convex piece: point is behind every outward edge normal
+            for (size_t p = 0; p < proxy.pieces.size() && !inside; ++p)
+            {
+                const ProxyPiece &piece = proxy.pieces[p];
+                inside = piece.count >= 3;
+                for (uint32_t i = 0; i < piece.count && inside; i++)
+                {
+                    uint32_t v = piece.first + i;
+                    inside = glm::dot(proxy.normals[v], point - proxy.vertices[v]) <= 0.0f;
+                }
+            }
+
+            if (inside)
+                addQueryResult(proxy);
         }
+        return m_QueryResults;
     }
 }
\ No newline at end of file
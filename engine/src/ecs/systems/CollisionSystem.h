@@ -1,7 +1,12 @@
 #pragma once
 
 #include "../System.h"
+#include "core/Project.h"
 #include <glm/glm.hpp>
+#include <array>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace Engine {
@@ -10,54 +15,364 @@ namespace Engine {
     class BoxColliderComponent;
     class CircleColliderComponent;
     class PolygonColliderComponent;
+    class RigidBodyComponent;
+    class TilemapComponent;
+
+    /** @brief Result of a raycast or shape cast. Point is where the shapes touch, normal faces the caster. */
+    struct RaycastHit {
+        Entity* entity = nullptr;
+        glm::vec2 point = {0.0f, 0.0f};
+        glm::vec2 normal = {0.0f, 0.0f};
+        float distance = 0.0f;
+    };
+
+    /** @brief Non-owning view of one convex world-space polygon. Normals are outward unit edge normals. */
+    struct ConvexPolygonView {
+        const glm::vec2* vertices = nullptr;
+        const glm::vec2* normals = nullptr; // normals[i] belongs to the edge vertices[i] -> vertices[i + 1]
+        uint32_t count = 0;
+        glm::vec2 center = {0.0f, 0.0f};
+    };
 
     /**
      * @brief High-performance 2D Collision System.
      * Handles SAT-based Polygon/Box collisions and Circle-based collisions.
+     * Sweep-and-prune broadphase feeds a narrowphase that runs across JobSystem workers;
+     * contacts are merged in (entityA, entityB) order and resolved on the calling thread
+     * by a sequential-impulse solver warm started from the previous step's impulses.
+     * Trigger colliders live in their own sorted list and only get overlap tests, optionally
+     * every few steps, so sensors never produce contacts or reach the solver.
      */
     class CollisionSystem : public System {
     public:
         CollisionSystem();
         virtual ~CollisionSystem() = default;
 
-        /** @brief Process all entity collisions in the scene. */
-        void onUpdate(float dt) override;
+        /** @brief Process all entity collisions in the scene, once per fixed step. */
+        void onFixedUpdate(float dt) override;
+
+        /**
+         * @brief Drops cached trigger pairs and queued events of the removed entity so no event references it.
+         * The other entity of each overlapping pair gets its Exit callback right away, while both are still alive.
+         */
+        void removeEntity(Entity* entity) override;
+
+        /** @brief Number of velocity and position solver passes per step. More = stiffer stacks, more CPU. */
+        void setSolverIterations(int velocityIterations, int positionIterations);
+
+        /** @brief Project layer interaction matrix: row i is the mask of layers that layer i collides with. */
+        void setLayerMatrix(const std::array<uint32_t, MaxCollisionLayers>& matrix);
+
+        /** @brief Trigger overlaps are checked every given number of fixed steps. 1 = every step. */
+        void setTriggerInterval(int steps);
+
+        // --- Spatial Queries ---
+        // Answered from the broadphase of the last fixed step. Only colliders whose layer is in mask are reported.
+        // Overlap results live in a buffer reused by the next query; copy them if you need to keep them.
+
+        /** @brief First solid collider hit by the ray. Direction does not need to be normalized. */
+        bool raycast(glm::vec2 origin, glm::vec2 direction, float maxDistance, uint32_t mask, RaycastHit& hit);
+
+        /** @brief First solid collider hit by a circle moving from origin along direction. */
+        bool castCircle(glm::vec2 origin, float radius, glm::vec2 direction, float maxDistance, uint32_t mask, RaycastHit& hit);
+
+        const std::vector<Entity*>& overlapCircle(glm::vec2 center, float radius, uint32_t mask);
+
+        /** @brief Axis-aligned box given by its center and full size. */
+        const std::vector<Entity*>& overlapBox(glm::vec2 center, glm::vec2 size, uint32_t mask);
+
+        const std::vector<Entity*>& overlapPoint(glm::vec2 point, uint32_t mask);
+
+        /** @brief Which trigger callback of a collider an event fires. */
+        enum class TriggerPhase { Enter, Stay, Exit };
 
     private:
-        /** @brief Helper to check and handle collision between two entities. */
-        void processCollisionPair(Entity* a, Entity* b);
+        /** @brief Overlapping trigger pair remembered between frames. */
+        struct TriggerPair {
+            Entity* a = nullptr;
+            Entity* b = nullptr;
+            bool touched = false;
+        };
+
+        struct TriggerEvent {
+            Entity* a;
+            Entity* b;
+            TriggerPhase phase;
+        };
+
+        /** @brief One convex piece of a proxy: a range of its vertices and normals plus a bounding circle. */
+        struct ProxyPiece {
+            uint32_t first = 0;
+            uint32_t count = 0;
+            glm::vec2 center = {0.0f, 0.0f};
+            float radius = 0.0f;
+        };
+
+        /** @brief World-space snapshot of an entity's colliders, built once per frame. */
+        struct ColliderProxy {
+            Entity* entity = nullptr;
+            RigidBodyComponent* body = nullptr;
+            bool isActive = false; // moving this frame (awake dynamic, kinematic or velocity-driven)
+            bool hasPolygon = false; // box or polygon collider
+            bool hasCircle = false;
+            std::vector<glm::vec2> vertices; // convex pieces back to back
+            std::vector<glm::vec2> normals; // parallel to vertices
+            std::vector<ProxyPiece> pieces;
+            glm::vec2 circleCenter = {0.0f, 0.0f};
+            float circleRadius = 0.0f;
+            glm::vec2 aabbMin = {0.0f, 0.0f};
+            glm::vec2 aabbMax = {0.0f, 0.0f};
+            uint32_t layer = 0;
+            uint32_t mask = 0;
+            uint32_t collidesWith = 0; // layer matrix rows of all layer bits, limited by the collider mask
+            bool isTrigger = false;
+            bool isTilemapChunk = false; // one of several static proxies of a tilemap entity
+
+            // Solver state - only dynamic bodies have non-zero inverse mass
+            float invMass = 0.0f;
+            float friction = 0.0f;
+            float restitution = 0.0f;
+            glm::vec2 velocity = {0.0f, 0.0f};
+            glm::vec2 positionCorrection = {0.0f, 0.0f};
+        };
+
+        /** @brief Narrowphase result between two solid proxies. Normal points from b to a, handle of a is lower than b. */
+        struct Contact {
+            Entity* a;
+            Entity* b;
+            uint32_t proxyA;
+            uint32_t proxyB;
+            glm::vec2 normal;
+            float penetration;
+        };
+
+        /** @brief Solver row built from one solid contact. Impulses accumulate across iterations. */
+        struct ContactConstraint {
+            uint32_t proxyA;
+            uint32_t proxyB;
+            uint64_t pairKey;
+            uint32_t ordinal; // index of the contact within its pair, matches the warm start slot
+            glm::vec2 normal;
+            glm::vec2 tangent;
+            float penetration;
+            float normalMass;
+            float friction;
+            float velocityBias;
+            float normalImpulse = 0.0f;
+            float tangentImpulse = 0.0f;
+        };
+
+        static constexpr uint32_t maxContactsPerPair = 4;
+
+        /** @brief Impulses of one pair from the last step, used to warm start the next one. */
+        struct CachedImpulse {
+            glm::vec2 normal = {0.0f, 0.0f};
+            float normalImpulse = 0.0f;
+            float tangentImpulse = 0.0f;
+        };
+
+        struct ContactCacheEntry {
+            std::array<CachedImpulse, maxContactsPerPair> impulses;
+            uint32_t count = 0;
+        };
+
+        /**
+         * @brief Snapshots world convex pieces, circle and AABB of every collider entity.
+         * Colliders a script or the editor moved since the last step wake the sleeping bodies around their old and new place.
+         */
+        void buildProxies();
+
+        /**
+         * @brief Continuous collision for bodies with the CCD flag, children included. Sweeps the step's world
+         * motion against static proxies (swept AABB first), computes the analytic time of impact and
+         * moves the body back to the first touch so the regular contact stops it.
+         */
+        void resolveContinuousCollisions();
+
+        /**
+         * @brief First time (fraction of delta) the proxy, moved from its end-of-step place back by delta and then
+         * along it, starts touching other. Pieces already touching at the start are left to the regular contact.
+         * Uses m_SweepVertices as scratch.
+         */
+        bool sweepTimeOfImpact(const ColliderProxy& proxy, glm::vec2 delta, const ColliderProxy& other, float& toi);
+
+        /** @brief Proxies sharing one layer value, sorted by AABB min x for sweep-and-prune. */
+        struct LayerGroup {
+            uint32_t layer = 0;
+            uint32_t reach = 0; // union of the matrix rows of the group's layer bits
+            float maxWidth = 0.0f; // widest member, bounds how far back a sweep has to start
+            std::vector<uint32_t> members;
+        };
+
+        /** @brief Layers reachable from any bit of the given layer value according to the matrix. */
+        uint32_t layerReach(uint32_t layer) const;
+
+        /** @brief Sorts solid proxies into per-layer groups and triggers into their own list. Proxies on no layer are left out. */
+        void buildLayerGroups();
 
-        /** @brief Centralized resolution for triggers and physical response. */
-        void handleCollisionResult(Entity* a, Entity* b, glm::vec2 normal, float penetration);
+        /**
+         * @brief Sweep-and-prune inside each layer group and between every two groups the matrix
+         * lets interact. Groups that never interact are never swept against each other.
+         */
+        void generateCandidatePairs();
 
-        /** @brief Filtering based on layer and mask bitflags. */
-        bool canCollide(Entity* a, Entity* b);
+        /** @brief Collects proxies in mask whose AABB overlaps [lo, hi], walking the sorted layer groups and trigger list. */
+        void queryBroadphase(glm::vec2 lo, glm::vec2 hi, uint32_t mask, bool includeTriggers = true);
 
-        /** @brief Checks if any collider in the pair is marked as a trigger. */
-        bool isTriggerPair(Entity* a, Entity* b);
+        /** @brief Shared body of raycast and castCircle; radius 0 is a plain ray. */
+        bool castShape(glm::vec2 origin, float radius, glm::vec2 direction, float maxDistance, uint32_t mask, RaycastHit& hit);
 
-        /** @brief Executes onTriggerEnter callbacks for both entities. */
-        void fireTriggerEvents(Entity* a, Entity* b);
+        /** @brief Tests candidate pairs in parallel and merges per-thread contacts in deterministic order. */
+        void runNarrowphase();
+
+        /** @brief Helper to check a pair of proxies and append its contacts. Safe to call from workers. */
+        void processCollisionPair(uint32_t ia, uint32_t ib, std::vector<Contact>& out);
+
+        /**
+         * @brief Advances sleep timers, wakes bodies hit by active ones and puts to sleep
+         * every island (dynamic bodies linked by contacts) that has been resting long enough.
+         */
+        void updateSleep(float dt);
+
+        uint32_t findIsland(uint32_t i);
+
+        /** @brief Filtering based on the precomputed layer reach of both proxies. */
+        bool canCollide(const ColliderProxy& a, const ColliderProxy& b) const;
+
+        /**
+         * @brief Trigger pass, every m_TriggerInterval steps: each trigger queries the solid groups and
+         * sweeps the later triggers of the sorted list; AABB first, then an exact overlap test.
+         */
+        void updateTriggers();
+
+        /** @brief True if any piece or circle of a overlaps any of b. No normal or depth is kept. */
+        bool proxiesOverlap(const ColliderProxy& a, const ColliderProxy& b);
+
+        /** @brief Marks the pair as overlapping this trigger step and queues enter/stay events. */
+        void recordTriggerOverlap(Entity* a, Entity* b);
+
+        /** @brief Queues exit events for pairs that stopped overlapping and resets the cache for next frame. */
+        void collectTriggerExits();
+
+        /** @brief Executes the queued trigger callbacks for both entities of every pair in one batch. */
+        void fireTriggerEvents();
+
+        /** @brief True if either entity has an onTriggerStay callback assigned. */
+        bool wantsTriggerStay(Entity* a, Entity* b);
 
         // --- Geometric Intersection Logic ---
         
-        /** @brief Returns world-space vertices for Box or Polygon colliders. */
-        std::vector<glm::vec2> getWorldVertices(Entity* ent);
+        /**
+         * @brief Transforms the cached convex pieces of the Polygon collider (or the Box collider)
+         * into the proxy. Vertices, normals and bounding circles are only transformed, never recomputed.
+         */
+        void buildPolygonPieces(Entity* ent, ColliderProxy& proxy);
+
+        /** @brief Appends one convex piece given in the space of M, normals go through its inverse transpose. */
+        static void appendPiece(ColliderProxy& proxy, const glm::mat4& M, const glm::vec2* verts, const glm::vec2* normals,
+                                size_t count, glm::vec2 center, float radius);
+
+        /**
+         * @brief One static proxy per chunk of the tilemap, built from the chunk's merged tile rectangles.
+         * Chunks keep their rectangles until a tile in them changes, so a level is a few hundred boxes at most.
+         */
+        void buildTilemapProxies(Entity* entity, TilemapComponent& tilemap);
 
-        /** @brief SAT implementation for two convex polygons. */
-        bool checkPolygonPolygon(const std::vector<glm::vec2>& vertsA, const std::vector<glm::vec2>& vertsB, glm::vec2& normal, float& penetration);
+        /** @brief Adds the proxy's entity to the query results once, even if several of its proxies matched. */
+        void addQueryResult(const ColliderProxy& proxy);
+
+        /** @brief View of one proxy piece; vertices can be redirected to a shifted copy of the proxy's vertices. */
+        static ConvexPolygonView pieceView(const ColliderProxy& proxy, const ProxyPiece& piece, const glm::vec2* vertices = nullptr);
+
+        /** @brief SAT implementation for two convex polygons, using their precomputed edge normals as axes. */
+        bool checkPolygonPolygon(const ConvexPolygonView& a, const ConvexPolygonView& b, glm::vec2& normal, float& penetration);
         
         /** @brief Intersection test between a circle and a convex polygon. */
-        bool checkCirclePolygon(Entity* circleEnt, CircleColliderComponent* circ, const std::vector<glm::vec2>& polyVerts, glm::vec2& normal, float& penetration);
+        bool checkCirclePolygon(glm::vec2 center, float radius, const ConvexPolygonView& poly, glm::vec2& normal, float& penetration);
         
         /** @brief Intersection test between two circles. */
-        bool checkCircleCircle(Entity* a, CircleColliderComponent* ca, Entity* b, CircleColliderComponent* cb, glm::vec2& normal, float& penetration);
+        bool checkCircleCircle(glm::vec2 centerA, float radiusA, glm::vec2 centerB, float radiusB, glm::vec2& normal, float& penetration);
         
-        /** @brief Static resolution that adjusts positions and velocities. */
-        void resolveCollision(Entity* a, Entity* b, glm::vec2 normal, float penetration);
+        // --- Contact Solver ---
+
+        /** @brief Builds constraints from solid contacts and seeds them with cached impulses. */
+        void prepareContactConstraints();
 
-        static constexpr float penetrationSlop = 0.01f;
+        /** @brief Applies the seeded impulses before the first velocity iteration. */
+        void warmStartContacts();
+
+        /** @brief One pass of friction and non-penetration impulses over all constraints. */
+        void solveVelocityConstraints();
+
+        /** @brief One pass of penetration correction, accumulated per body and applied once. */
+        void solvePositionConstraints();
+
+        /** @brief Stores the final impulses for the next step and drops pairs that stopped touching. */
+        void storeContactImpulses();
+
+        /** @brief Writes solved velocities and position corrections back to the dynamic bodies. */
+        void applySolverResults();
+
+        // Penetration (px) left uncorrected so resting contacts persist, and the share corrected per pass
+        static constexpr float penetrationSlop = 0.5f;
         static constexpr float penetrationPercent = 0.8f;
+        static constexpr float maxPositionCorrection = 20.0f;
+
+        // Approach speed (px/s) below which restitution is ignored, so resting bodies do not jitter
+        static constexpr float restitutionThreshold = 50.0f;
+        // Material of colliders without a RigidBody
+        static constexpr float defaultFriction = 0.2f;
+        // Cached impulse is reused only if the contact normal barely turned
+        static constexpr float warmStartNormalTolerance = 0.95f;
+        // Contacts of one pair whose normals are closer than this (cosine) merge into the deepest one
+        static constexpr float contactMergeNormalTolerance = 0.95f;
+
+        // Below this many candidate pairs the narrowphase stays on the calling thread
+        static constexpr size_t parallelPairThreshold = 128;
+        static constexpr size_t narrowphaseGrain = 32;
+
+        // Body speed (px/s) under which it counts as resting, and how long it must rest to sleep
+        static constexpr float sleepLinearTolerance = 5.0f;
+        static constexpr float timeToSleep = 0.5f;
+
+        // CCD kicks in once a body moves more than this share of its smallest extent in one step
+        static constexpr float ccdMotionThreshold = 0.5f;
+        // How far (px) past the time of impact a swept body is left, inside penetrationSlop, so its contact registers
+        static constexpr float ccdContactDepth = 0.25f;
+
+        // Persistent trigger overlap cache keyed by the ordered pair of entity handles
+        std::unordered_map<uint64_t, TriggerPair> m_TriggerPairs;
+        std::vector<TriggerEvent> m_TriggerEvents;
+        std::vector<TriggerEvent> m_FiringEvents; // events whose callbacks are running
+        std::vector<TriggerEvent> m_RemovalExits; // exits sent by removeEntity, nested when a callback destroys more
+
+        // Per-frame scratch, kept as members so capacity is reused
+        std::vector<ColliderProxy> m_Proxies;
+        std::vector<LayerGroup> m_LayerGroups;
+        std::vector<uint32_t> m_TriggerMembers; // trigger proxies sorted by AABB min x, all layers together
+        float m_TriggerMaxWidth = 0.0f;
+        std::array<uint32_t, MaxCollisionLayers> m_LayerMatrix;
+        std::vector<std::pair<uint32_t, uint32_t>> m_CandidatePairs;
+        std::vector<std::vector<Contact>> m_ThreadContacts;
+        std::vector<Contact> m_Contacts;
+        std::vector<uint32_t> m_IslandParent;
+        std::vector<float> m_IslandMinSleep;
+        std::vector<uint32_t> m_StaticProxies;
+        std::vector<std::pair<glm::vec2, glm::vec2>> m_MovedBounds; // old and new place of colliders moved outside the step
+        std::vector<glm::vec2> m_SweepVertices;
+
+        std::vector<uint32_t> m_QueryCandidates;
+        std::vector<Entity*> m_QueryResults;
+
+        std::vector<ContactConstraint> m_Constraints;
+        std::unordered_map<uint64_t, ContactCacheEntry> m_ContactCache;
+
+        int m_VelocityIterations = 8;
+        int m_PositionIterations = 3;
+        int m_TriggerInterval = 1;
+        int m_StepsUntilTriggers = 0;
 
+        // Set when an entity is removed - anything resting on it has to re-check
+        bool m_WakeAllBodies = false;
     };
-}
\ No newline at end of file
+}
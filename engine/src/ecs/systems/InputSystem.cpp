@@ -9,10 +9,24 @@
 namespace Engine {
 InputSystem::InputSystem() {
   requireComponent<InputControllerComponent>();
+  // Fixna faza sa pouziva len v deterministickom rezime, vid setFixedStepInput
+  setUpdateStages(SystemStage::VariableStep | SystemStage::FixedStep);
   Log::info("InputSystem inicializovany.");
 }
 
 void InputSystem::onUpdate(float dt) {
+  if (!m_FixedStepInput) {
+    applyInput();
+  }
+}
+
+void InputSystem::onFixedUpdate(float fixedDt) {
+  if (m_FixedStepInput) {
+    applyInput();
+  }
+}
+
+void InputSystem::applyInput() {
   for (auto entity : getSystemEntities()) {
     auto controller = entity->getComponent<InputControllerComponent>();
     if (!controller->overrideDefaultSettings) {
@@ -16,5 +16,15 @@ namespace Engine {
          * @brief Cita input state a aktualizuje pohybove hodnoty kontrolovatelnych entit.
          */
         void onUpdate(float dt) override;
+
+        /** @brief V deterministickom rezime sa input aplikuje raz za fixny krok namiesto raz za frame. */
+        void onFixedUpdate(float fixedDt) override;
+
+        void setFixedStepInput(bool enabled) { m_FixedStepInput = enabled; }
+
+    private:
+        void applyInput();
+
+        bool m_FixedStepInput = false;
     };
 }
\ No newline at end of file
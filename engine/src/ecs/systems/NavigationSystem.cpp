@@ -0,0 +1,832 @@
+#include "NavigationSystem.h"
+#include "../components/TransformComponent.h"
+#include "../components/BoxColliderComponent.h"
+#include "../components/PolygonColliderComponent.h"
+#include "../components/RigidBodyComponent.h"
+#include "../components/TilemapComponent.h"
+#include "../components/VelocityComponent.h"
+#include "../Entity.h"
+#include "core/Log.h"
+#include "PhysicsTransform.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <glm/gtc/matrix_transform.hpp>
+
+namespace Engine
+{
+    // Free cells kept around the obstacles, so paths can go around the outermost ones
+    static constexpr int gridMarginCells = 4;
+    static constexpr int maxGridSide = 1024;
+    static constexpr int maxFlowFields = 8;
+    // Goal inside an obstacle snaps to the closest walkable cell at most this many cells away
+    static constexpr int goalSnapRing = 4;
+    static constexpr float diagonalCost = 1.41421356f;
+    static constexpr float infiniteCost = std::numeric_limits<float>::infinity();
+
+    static const int neighborOffsets[8][2] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}, {1, 1}, {-1, 1}, {1, -1}, {-1, -1}};
+    static const glm::vec2 boxCorners[4] = {{-0.5f, -0.5f}, {0.5f, -0.5f}, {0.5f, 0.5f}, {-0.5f, 0.5f}};
+
+    // Same world matrices as CollisionSystem, so the grid matches what physics collides with
+    using PhysicsTransform::GetWorldMatrix;
+    using PhysicsTransform::RotateZ;
+    using PhysicsTransform::TransformPoint;
+
+    static glm::vec2 NormalizeOrZero(const glm::vec2 &v)
+    {
+        float len2 = glm::dot(v, v);
+        return len2 > 1e-12f ? v / std::sqrt(len2) : glm::vec2(0.0f);
+    }
+
+    // SAT of one convex piece against an axis-aligned rectangle. Only touching does not count as overlap,
+    // so a wall aligned with the grid does not block the cells next to it.
+    static bool PieceOverlapsRect(const glm::vec2 *verts, uint32_t count, const glm::vec2 &rectMin, const glm::vec2 &rectMax)
+    {
+        glm::vec2 lo = verts[0], hi = verts[0];
+        for (uint32_t i = 1; i < count; i++)
+        {
+            lo = glm::min(lo, verts[i]);
+            hi = glm::max(hi, verts[i]);
+        }
+        if (hi.x <= rectMin.x || lo.x >= rectMax.x || hi.y <= rectMin.y || lo.y >= rectMax.y)
+            return false;
+
+        const glm::vec2 rect[4] = {rectMin, {rectMax.x, rectMin.y}, rectMax, {rectMin.x, rectMax.y}};
+        for (uint32_t i = 0; i < count; i++)
+        {
+            glm::vec2 edge = verts[(i + 1) % count] - verts[i];
+            glm::vec2 axis(edge.y, -edge.x);
+
+            float pMin = glm::dot(verts[0], axis), pMax = pMin;
+            for (uint32_t k = 1; k < count; k++)
+            {
+                float p = glm::dot(verts[k], axis);
+                pMin = std::min(pMin, p);
+                pMax = std::max(pMax, p);
+            }
+            float rMin = glm::dot(rect[0], axis), rMax = rMin;
+            for (int k = 1; k < 4; k++)
+            {
+                float p = glm::dot(rect[k], axis);
+                rMin = std::min(rMin, p);
+                rMax = std::max(rMax, p);
+            }
+            if (pMax <= rMin || rMax <= pMin)
+                return false;
+        }
+        return true;
+    }
+
+    NavigationSystem::NavigationSystem()
+    {
+        requireComponent<TransformComponent>();
+        setUpdateStages(SystemStage::FixedStep);
+        m_FlowFields.reserve(maxFlowFields);
+    }
+
+    void NavigationSystem::onFixedUpdate(float dt)
+    {
+        syncObstacles();
+    }
+
+    void NavigationSystem::removeEntity(Entity *entity)
+    {
+        auto it = m_Obstacles.find(entity);
+        if (it != m_Obstacles.end())
+        {
+            unstampObstacle(it->second);
+            m_Obstacles.erase(it);
+        }
+        System::removeEntity(entity);
+    }
+
+    void NavigationSystem::configure(float cellSize, float agentRadius)
+    {
+        float size = std::max(cellSize, 1.0f);
+        float radius = std::max(agentRadius, 0.0f);
+        if (size == m_CellSize && radius == m_AgentRadius)
+            return;
+
+        m_CellSize = size;
+        m_AgentRadius = radius;
+        m_BakePending = true;
+    }
+
+    void NavigationSystem::rebake()
+    {
+        m_BakePending = true;
+        syncObstacles();
+    }
+
+    bool NavigationSystem::describeObstacle(Entity *entity, ObstacleSource &out) const
+    {
+        out.world = GetWorldMatrix(entity);
+
+        // Tilemap je vzdy staticka, jej zlucene obdlzniky su kusy jednej prekazky
+        if (auto tilemap = entity->getComponent<TilemapComponent>(); tilemap && tilemap->collision)
+        {
+            out.offset = out.size = glm::vec2(0.0f);
+            out.rotation = 0.0f;
+            out.outline.clear();
+            out.tilemapVersion = tilemap->getCollisionVersion();
+            out.tileSize = tilemap->tileSize;
+            return true;
+        }
+
+        auto poly = entity->getComponent<PolygonColliderComponent>();
+        auto box = poly ? nullptr : entity->getComponent<BoxColliderComponent>();
+        if (!poly && !box)
+            return false;
+
+        bool isTrigger = poly ? poly->isTrigger : box->isTrigger;
+        if (isTrigger)
+            return false;
+
+        // Static = marked on the collider, a Static body, or nothing that would ever move it
+        bool isStatic = poly ? poly->isStatic : box->isStatic;
+        if (!isStatic)
+        {
+            auto rb = entity->getComponent<RigidBodyComponent>();
+            isStatic = rb ? rb->getBodyType() == BodyType::Static : !entity->getComponent<VelocityComponent>();
+        }
+        if (!isStatic)
+            return false;
+
+        out.tilemapVersion = 0;
+        out.tileSize = glm::ivec2(0, 0);
+        if (poly)
+        {
+            out.offset = poly->offset;
+            out.rotation = poly->rotation;
+            out.size = glm::vec2(0.0f);
+            out.outline = poly->vertices;
+        }
+        else
+        {
+            out.offset = box->offset;
+            out.rotation = box->rotation;
+            out.size = box->size;
+            out.outline.clear();
+        }
+        return true;
+    }
+
+    bool NavigationSystem::gatherObstacle(Entity *entity, Obstacle &out) const
+    {
+        if (auto tilemap = entity->getComponent<TilemapComponent>(); tilemap && tilemap->collision)
+            return gatherTilemapObstacle(entity, *tilemap, out);
+
+        auto poly = entity->getComponent<PolygonColliderComponent>();
+        auto box = poly ? nullptr : entity->getComponent<BoxColliderComponent>();
+        if (!poly && !box)
+            return false;
+
+        out.vertices.clear();
+        out.pieceSizes.clear();
+
+        glm::mat4 world = GetWorldMatrix(entity);
+        if (poly)
+        {
+            glm::mat4 col(1.0f);
+            col = glm::translate(col, glm::vec3(poly->offset, 0.0f));
+            col = RotateZ(col, poly->rotation);
+            glm::mat4 M = world * col;
+
+            for (const auto &piece : poly->getConvexPieces())
+            {
+                for (const auto &v : piece.vertices)
+                    out.vertices.push_back(TransformPoint(M, v));
+                out.pieceSizes.push_back(static_cast<uint32_t>(piece.vertices.size()));
+            }
+        }
+        else
+        {
+            glm::mat4 col(1.0f);
+            col = glm::translate(col, glm::vec3(box->offset, 0.0f));
+            col = RotateZ(col, box->rotation);
+            col = glm::scale(col, glm::vec3(box->size, 1.0f));
+            glm::mat4 M = world * col;
+
+            for (const auto &corner : boxCorners)
+                out.vertices.push_back(TransformPoint(M, corner));
+            out.pieceSizes.push_back(4);
+        }
+
+        if (out.vertices.empty())
+            return false;
+
+        out.min = out.vertices[0];
+        out.max = out.vertices[0];
+        for (const auto &v : out.vertices)
+        {
+            out.min = glm::min(out.min, v);
+            out.max = glm::max(out.max, v);
+        }
+        return true;
+    }
+
+    bool NavigationSystem::gatherTilemapObstacle(Entity *entity, TilemapComponent &tilemap, Obstacle &out) const
+    {
+        out.vertices.clear();
+        out.pieceSizes.clear();
+        if (tilemap.tileSize.x <= 0 || tilemap.tileSize.y <= 0)
+            return false;
+
+        glm::mat4 world = GetWorldMatrix(entity);
+        glm::vec2 tileSize(tilemap.tileSize);
+        for (const auto &[key, chunk] : tilemap.getChunks())
+        {
+            glm::ivec2 firstTile = TilemapComponent::ChunkCoords(key) * TilemapComponent::ChunkSize;
+            for (const auto &rect : tilemap.getChunkColliders(key))
+            {
+                glm::vec2 min = glm::vec2(firstTile.x + rect.x, firstTile.y + rect.y) * tileSize;
+                glm::vec2 max = min + glm::vec2(rect.w, rect.h) * tileSize;
+                const glm::vec2 corners[4] = {min, {max.x, min.y}, max, {min.x, max.y}};
+                for (const auto &corner : corners)
+                    out.vertices.push_back(TransformPoint(world, corner));
+                out.pieceSizes.push_back(4);
+            }
+        }
+
+        if (out.vertices.empty())
+            return false;
+
+        out.min = out.vertices[0];
+        out.max = out.vertices[0];
+        for (const auto &v : out.vertices)
+        {
+            out.min = glm::min(out.min, v);
+            out.max = glm::max(out.max, v);
+        }
+        return true;
+    }
+
+    void NavigationSystem::syncObstacles()
+    {
+        ++m_SyncStep;
+        bool fullBake = m_BakePending;
+
+        Obstacle scratch;
+        for (Entity *entity : getSystemEntities())
+        {
+            if (!describeObstacle(entity, m_SourceScratch))
+                continue;
+
+            // Nic, z coho sa prekazka sklada, sa nezmenilo - ani jej vrcholy, ani tilemapu netreba prechadzat
+            auto it = m_Obstacles.find(entity);
+            if (it != m_Obstacles.end() && !fullBake && it->second.source == m_SourceScratch)
+            {
+                it->second.seenStep = m_SyncStep;
+                continue;
+            }
+
+            // Prazdny tvar: stara prekazka ostane neoznacena a cyklus nizsie ju zmaze
+            if (!gatherObstacle(entity, scratch))
+                continue;
+
+            bool isNew = it == m_Obstacles.end();
+            if (isNew)
+                it = m_Obstacles.emplace(entity, Obstacle()).first;
+
+            Obstacle &obstacle = it->second;
+            obstacle.seenStep = m_SyncStep;
+            obstacle.source = m_SourceScratch;
+            if (!isNew && obstacle.vertices == scratch.vertices && obstacle.pieceSizes == scratch.pieceSizes)
+                continue;
+
+            m_Stats.changedObstacles++;
+            if (!fullBake)
+                unstampObstacle(obstacle);
+
+            obstacle.vertices.swap(scratch.vertices);
+            obstacle.pieceSizes.swap(scratch.pieceSizes);
+            obstacle.min = scratch.min;
+            obstacle.max = scratch.max;
+
+            // Moved past the grid edge: bounds have to grow, which shifts every cell
+            if (!fullBake)
+            {
+                if (fitsGrid(obstacle))
+                    stampObstacle(obstacle);
+                else
+                    fullBake = true;
+            }
+        }
+
+        // Destroyed obstacles go through removeEntity, these lost their collider or started moving
+        for (auto it = m_Obstacles.begin(); it != m_Obstacles.end();)
+        {
+            if (it->second.seenStep == m_SyncStep)
+            {
+                ++it;
+                continue;
+            }
+            if (!fullBake)
+                unstampObstacle(it->second);
+            it = m_Obstacles.erase(it);
+        }
+
+        m_Stats.obstacles = static_cast<int>(m_Obstacles.size());
+        if (fullBake)
+            bakeAll();
+    }
+
+    void NavigationSystem::bakeAll()
+    {
+        m_BakePending = false;
+        m_Stats.fullBakes++;
+        m_Version++;
+        m_FlowFields.clear();
+
+        bool any = false;
+        glm::vec2 lo(0.0f), hi(0.0f);
+        for (const auto &[entity, obstacle] : m_Obstacles)
+        {
+            lo = any ? glm::min(lo, obstacle.min) : obstacle.min;
+            hi = any ? glm::max(hi, obstacle.max) : obstacle.max;
+            any = true;
+        }
+
+        if (!any)
+        {
+            m_Width = 0;
+            m_Height = 0;
+            m_Blockers.clear();
+            return;
+        }
+
+        float margin = m_AgentRadius + gridMarginCells * m_CellSize;
+        lo -= glm::vec2(margin);
+        hi += glm::vec2(margin);
+
+        // Origin on a multiple of the cell size, so growing the bounds keeps cells where they were
+        m_Origin = glm::floor(lo / m_CellSize) * m_CellSize;
+        m_Width = static_cast<int>(std::ceil((hi.x - m_Origin.x) / m_CellSize));
+        m_Height = static_cast<int>(std::ceil((hi.y - m_Origin.y) / m_CellSize));
+        if (m_Width > maxGridSide || m_Height > maxGridSide)
+        {
+            Log::warn("Navigation grid of " + std::to_string(m_Width) + "x" + std::to_string(m_Height) +
+                      " cells is too large, obstacles past " + std::to_string(maxGridSide) +
+                      " cells are ignored. Increase the navigation cell size.");
+            m_Width = std::min(m_Width, maxGridSide);
+            m_Height = std::min(m_Height, maxGridSide);
+        }
+
+        size_t cellCount = static_cast<size_t>(m_Width) * m_Height;
+        m_Blockers.assign(cellCount, 0);
+        m_CellMark.assign(cellCount, 0);
+        m_MarkGeneration = 0;
+        m_GCost.assign(cellCount, 0.0f);
+        m_Parent.assign(cellCount, -1);
+        m_Visited.assign(cellCount, 0);
+        m_SearchGeneration = 0;
+
+        for (auto &[entity, obstacle] : m_Obstacles)
+            stampObstacle(obstacle);
+    }
+
+    bool NavigationSystem::fitsGrid(const Obstacle &obstacle) const
+    {
+        if (m_Width == 0)
+            return false;
+
+        glm::vec2 gridMax = m_Origin + glm::vec2(m_Width, m_Height) * m_CellSize;
+        return obstacle.min.x - m_AgentRadius >= m_Origin.x && obstacle.min.y - m_AgentRadius >= m_Origin.y &&
+               obstacle.max.x + m_AgentRadius <= gridMax.x && obstacle.max.y + m_AgentRadius <= gridMax.y;
+    }
+
+    void NavigationSystem::stampObstacle(Obstacle &obstacle)
+    {
+        obstacle.cells.clear();
+        if (m_Width == 0)
+            return;
+
+        if (++m_MarkGeneration == 0)
+        {
+            std::fill(m_CellMark.begin(), m_CellMark.end(), 0);
+            m_MarkGeneration = 1;
+        }
+
+        bool changed = false;
+        size_t first = 0;
+        for (uint32_t count : obstacle.pieceSizes)
+        {
+            const glm::vec2 *verts = &obstacle.vertices[first];
+            first += count;
+            if (count < 3)
+                continue;
+
+            glm::vec2 lo = verts[0], hi = verts[0];
+            for (uint32_t i = 1; i < count; i++)
+            {
+                lo = glm::min(lo, verts[i]);
+                hi = glm::max(hi, verts[i]);
+            }
+            lo = (lo - glm::vec2(m_AgentRadius) - m_Origin) / m_CellSize;
+            hi = (hi + glm::vec2(m_AgentRadius) - m_Origin) / m_CellSize;
+
+            int x0 = std::max(0, static_cast<int>(std::floor(lo.x)));
+            int y0 = std::max(0, static_cast<int>(std::floor(lo.y)));
+            int x1 = std::min(m_Width - 1, static_cast<int>(std::floor(hi.x)));
+            int y1 = std::min(m_Height - 1, static_cast<int>(std::floor(hi.y)));
+
+            for (int y = y0; y <= y1; y++)
+            {
+                for (int x = x0; x <= x1; x++)
+                {
+                    int cell = cellIndex(x, y);
+                    if (m_CellMark[cell] == m_MarkGeneration)
+                        continue;
+
+                    // Cell grown by the agent radius = every agent center in the cell stays clear of the piece
+                    glm::vec2 cellMin = m_Origin + glm::vec2(x, y) * m_CellSize - glm::vec2(m_AgentRadius);
+                    glm::vec2 cellMax = cellMin + glm::vec2(m_CellSize + 2.0f * m_AgentRadius);
+                    if (!PieceOverlapsRect(verts, count, cellMin, cellMax))
+                        continue;
+
+                    m_CellMark[cell] = m_MarkGeneration;
+                    obstacle.cells.push_back(cell);
+                    if (m_Blockers[cell]++ == 0)
+                        changed = true;
+                }
+            }
+        }
+
+        m_Stats.restampedCells += static_cast<int>(obstacle.cells.size());
+        if (changed)
+            m_Version++;
+    }
+
+    void NavigationSystem::unstampObstacle(Obstacle &obstacle)
+    {
+        bool changed = false;
+        for (int cell : obstacle.cells)
+        {
+            if (--m_Blockers[cell] == 0)
+                changed = true;
+        }
+
+        m_Stats.restampedCells += static_cast<int>(obstacle.cells.size());
+        obstacle.cells.clear();
+        if (changed)
+            m_Version++;
+    }
+
+    int NavigationSystem::cellAt(const glm::vec2 &position) const
+    {
+        glm::vec2 local = (position - m_Origin) / m_CellSize;
+        int x = std::clamp(static_cast<int>(std::floor(local.x)), 0, m_Width - 1);
+        int y = std::clamp(static_cast<int>(std::floor(local.y)), 0, m_Height - 1);
+        return cellIndex(x, y);
+    }
+
+    glm::vec2 NavigationSystem::cellCenter(int cell) const
+    {
+        return m_Origin + (glm::vec2(cell % m_Width, cell / m_Width) + 0.5f) * m_CellSize;
+    }
+
+    bool NavigationSystem::canStep(int from, int dx, int dy) const
+    {
+        int x = from % m_Width + dx;
+        int y = from / m_Width + dy;
+        if (x < 0 || y < 0 || x >= m_Width || y >= m_Height || isBlocked(cellIndex(x, y)))
+            return false;
+
+        // Diagonal only between two free sides, agents must not clip the corner
+        if (dx != 0 && dy != 0)
+            return !isBlocked(cellIndex(x, y - dy)) && !isBlocked(cellIndex(x - dx, y));
+        return true;
+    }
+
+    int NavigationSystem::nearestWalkable(int cell, int maxRing) const
+    {
+        if (!isBlocked(cell))
+            return cell;
+
+        int cx = cell % m_Width;
+        int cy = cell / m_Width;
+        for (int ring = 1; ring <= maxRing; ring++)
+        {
+            int best = -1;
+            int bestDist = std::numeric_limits<int>::max();
+            for (int y = cy - ring; y <= cy + ring; y++)
+            {
+                for (int x = cx - ring; x <= cx + ring; x++)
+                {
+                    bool onRing = std::abs(x - cx) == ring || std::abs(y - cy) == ring;
+                    if (!onRing || x < 0 || y < 0 || x >= m_Width || y >= m_Height)
+                        continue;
+
+                    int candidate = cellIndex(x, y);
+                    int dist = (x - cx) * (x - cx) + (y - cy) * (y - cy);
+                    if (!isBlocked(candidate) && dist < bestDist)
+                    {
+                        best = candidate;
+                        bestDist = dist;
+                    }
+                }
+            }
+            if (best >= 0)
+                return best;
+        }
+        return -1;
+    }
+
+    // Walks the cells under the segment (Amanatides-Woo). Outside the grid is open space.
+    bool NavigationSystem::lineOfSight(const glm::vec2 &a, const glm::vec2 &b) const
+    {
+        glm::vec2 p0 = (a - m_Origin) / m_CellSize;
+        glm::vec2 p1 = (b - m_Origin) / m_CellSize;
+        glm::vec2 d = p1 - p0;
+
+        int x = static_cast<int>(std::floor(p0.x));
+        int y = static_cast<int>(std::floor(p0.y));
+        int endX = static_cast<int>(std::floor(p1.x));
+        int endY = static_cast<int>(std::floor(p1.y));
+        int stepX = d.x > 0.0f ? 1 : -1;
+        int stepY = d.y > 0.0f ? 1 : -1;
+
+        float tDeltaX = d.x != 0.0f ? 1.0f / std::abs(d.x) : infiniteCost;
+        float tDeltaY = d.y != 0.0f ? 1.0f / std::abs(d.y) : infiniteCost;
+        float tMaxX = d.x != 0.0f ? (stepX > 0 ? x + 1 - p0.x : p0.x - x) * tDeltaX : infiniteCost;
+        float tMaxY = d.y != 0.0f ? (stepY > 0 ? y + 1 - p0.y : p0.y - y) * tDeltaY : infiniteCost;
+
+        auto blocked = [this](int cx, int cy)
+        {
+            return cx >= 0 && cy >= 0 && cx < m_Width && cy < m_Height && isBlocked(cellIndex(cx, cy));
+        };
+
+        if (blocked(x, y))
+            return false;
+
+        while (x != endX || y != endY)
+        {
+            // An axis that already reached its end cell never steps again, rounding cannot overshoot
+            bool moveX = y == endY || (x != endX && tMaxX <= tMaxY);
+            bool moveY = x == endX || (y != endY && tMaxY <= tMaxX);
+
+            if (moveX && moveY)
+            {
+                // Exactly through a corner: both side cells must be free, same rule as canStep
+                if (blocked(x + stepX, y) || blocked(x, y + stepY))
+                    return false;
+                x += stepX;
+                y += stepY;
+                tMaxX += tDeltaX;
+                tMaxY += tDeltaY;
+            }
+            else if (moveX)
+            {
+                x += stepX;
+                tMaxX += tDeltaX;
+            }
+            else
+            {
+                y += stepY;
+                tMaxY += tDeltaY;
+            }
+
+            if (blocked(x, y))
+                return false;
+        }
+        return true;
+    }
+
+    bool NavigationSystem::findPath(const glm::vec2 &from, const glm::vec2 &to, std::vector<glm::vec2> &outPath)
+    {
+        m_Stats.pathQueries++;
+        outPath.clear();
+        if (m_BakePending)
+            syncObstacles();
+
+        if (m_Width == 0)
+        {
+            outPath.push_back(to);
+            return true;
+        }
+
+        int start = cellAt(from);
+        int goal = nearestWalkable(cellAt(to), goalSnapRing);
+        if (goal < 0)
+            return false;
+
+        glm::vec2 target = goal == cellAt(to) ? to : cellCenter(goal);
+        if (start == goal || lineOfSight(from, target))
+        {
+            outPath.push_back(target);
+            return true;
+        }
+
+        if (++m_SearchGeneration == 0)
+        {
+            std::fill(m_Visited.begin(), m_Visited.end(), 0);
+            m_SearchGeneration = 1;
+        }
+
+        int goalX = goal % m_Width;
+        int goalY = goal / m_Width;
+        // Octile distance in cells, exact on an empty 8-connected grid
+        auto heuristic = [this, goalX, goalY](int cell)
+        {
+            float dx = static_cast<float>(std::abs(cell % m_Width - goalX));
+            float dy = static_cast<float>(std::abs(cell / m_Width - goalY));
+            return dx + dy + (diagonalCost - 2.0f) * std::min(dx, dy);
+        };
+
+        // (f, cell): equal f pops the lower cell index first, so results do not depend on heap internals
+        const std::greater<std::pair<float, int>> later;
+        m_Open.clear();
+
+        m_Visited[start] = m_SearchGeneration;
+        m_GCost[start] = 0.0f;
+        m_Parent[start] = -1;
+        m_Open.push_back({heuristic(start), start});
+
+        bool found = false;
+        while (!m_Open.empty())
+        {
+            std::pop_heap(m_Open.begin(), m_Open.end(), later);
+            auto [f, cell] = m_Open.back();
+            m_Open.pop_back();
+            if (f > m_GCost[cell] + heuristic(cell))
+                continue; // stale entry, reached cheaper since
+
+            m_Stats.expandedNodes++;
+            if (cell == goal)
+            {
+                found = true;
+                break;
+            }
+
+            for (const auto &offset : neighborOffsets)
+            {
+                if (!canStep(cell, offset[0], offset[1]))
+                    continue;
+
+                int next = cell + offset[1] * m_Width + offset[0];
+                float cost = m_GCost[cell] + (offset[0] != 0 && offset[1] != 0 ? diagonalCost : 1.0f);
+                if (m_Visited[next] == m_SearchGeneration && cost >= m_GCost[next])
+                    continue;
+
+                m_Visited[next] = m_SearchGeneration;
+                m_GCost[next] = cost;
+                m_Parent[next] = cell;
+                m_Open.push_back({cost + heuristic(next), next});
+                std::push_heap(m_Open.begin(), m_Open.end(), later);
+            }
+        }
+
+        if (!found)
+            return false;
+
+        std::vector<glm::vec2> &corridor = m_Corridor;
+        corridor.clear();
+        for (int cell = goal; cell != start; cell = m_Parent[cell])
+            corridor.push_back(cellCenter(cell));
+        std::reverse(corridor.begin(), corridor.end());
+        corridor.back() = target;
+
+        // String pulling: skip every waypoint the previous one can see past
+        glm::vec2 anchor = from;
+        size_t i = 0;
+        while (i < corridor.size())
+        {
+            size_t furthest = i;
+            while (furthest + 1 < corridor.size() && lineOfSight(anchor, corridor[furthest + 1]))
+                furthest++;
+
+            outPath.push_back(corridor[furthest]);
+            anchor = corridor[furthest];
+            i = furthest + 1;
+        }
+        return true;
+    }
+
+    const std::vector<glm::vec2> *NavigationSystem::findPath(const glm::vec2 &from, const glm::vec2 &to)
+    {
+        return findPath(from, to, m_PathResult) ? &m_PathResult : nullptr;
+    }
+
+    const NavigationSystem::FlowField *NavigationSystem::getFlowField(int goalCell)
+    {
+        m_FlowClock++;
+
+        FlowField *slot = nullptr;
+        for (auto &field : m_FlowFields)
+        {
+            if (field.goalCell != goalCell)
+                continue;
+            if (field.version == m_Version)
+            {
+                field.lastUsed = m_FlowClock;
+                return &field;
+            }
+            slot = &field;
+            break;
+        }
+
+        if (!slot)
+        {
+            if (m_FlowFields.size() < maxFlowFields)
+            {
+                m_FlowFields.emplace_back();
+                slot = &m_FlowFields.back();
+            }
+            else
+            {
+                slot = &*std::min_element(m_FlowFields.begin(), m_FlowFields.end(), [](const FlowField &l, const FlowField &r)
+                                          { return l.lastUsed < r.lastUsed; });
+            }
+        }
+
+        slot->goalCell = goalCell;
+        slot->version = m_Version;
+        slot->lastUsed = m_FlowClock;
+        slot->cost.assign(static_cast<size_t>(m_Width) * m_Height, infiniteCost);
+        m_Stats.flowFieldBuilds++;
+
+        // Dijkstra outwards from the goal; canStep is symmetric, so the cost to reach the goal is the same
+        using Node = std::pair<float, int>;
+        std::priority_queue<Node, std::vector<Node>, std::greater<Node>> open;
+        slot->cost[goalCell] = 0.0f;
+        open.push({0.0f, goalCell});
+
+        while (!open.empty())
+        {
+            auto [cost, cell] = open.top();
+            open.pop();
+            if (cost > slot->cost[cell])
+                continue;
+
+            for (const auto &offset : neighborOffsets)
+            {
+                if (!canStep(cell, offset[0], offset[1]))
+                    continue;
+
+                int next = cell + offset[1] * m_Width + offset[0];
+                float nextCost = cost + (offset[0] != 0 && offset[1] != 0 ? diagonalCost : 1.0f);
+                if (nextCost < slot->cost[next])
+                {
+                    slot->cost[next] = nextCost;
+                    open.push({nextCost, next});
+                }
+            }
+        }
+        return slot;
+    }
+
+    glm::vec2 NavigationSystem::getFlowDirection(const glm::vec2 &goal, const glm::vec2 &position)
+    {
+        m_Stats.flowQueries++;
+        if (m_BakePending)
+            syncObstacles();
+
+        if (m_Width == 0)
+            return NormalizeOrZero(goal - position);
+
+        int goalCell = nearestWalkable(cellAt(goal), goalSnapRing);
+        if (goalCell < 0)
+            return glm::vec2(0.0f);
+
+        int cell = cellAt(position);
+        if (cell == goalCell)
+            return NormalizeOrZero((goalCell == cellAt(goal) ? goal : cellCenter(goalCell)) - position);
+
+        const FlowField *field = getFlowField(goalCell);
+
+        // An agent pushed into a blocked cell has infinite cost there and still finds its way out
+        float bestCost = field->cost[cell];
+        int bestCell = -1;
+        for (const auto &offset : neighborOffsets)
+        {
+            if (!canStep(cell, offset[0], offset[1]))
+                continue;
+
+            int next = cell + offset[1] * m_Width + offset[0];
+            if (field->cost[next] < bestCost)
+            {
+                bestCost = field->cost[next];
+                bestCell = next;
+            }
+        }
+
+        if (bestCell < 0)
+            return glm::vec2(0.0f);
+        return NormalizeOrZero(cellCenter(bestCell) - position);
+    }
+
+    bool NavigationSystem::isWalkable(const glm::vec2 &position)
+    {
+        if (m_BakePending)
+            syncObstacles();
+        if (m_Width == 0)
+            return true;
+
+        glm::vec2 local = (position - m_Origin) / m_CellSize;
+        if (local.x < 0.0f || local.y < 0.0f || local.x >= m_Width || local.y >= m_Height)
+            return true;
+        return !isBlocked(cellAt(position));
+    }
+}
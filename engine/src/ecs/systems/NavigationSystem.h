@@ -0,0 +1,163 @@
+#pragma once
+
+#include "../System.h"
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace Engine {
+
+    class Entity;
+    class TilemapComponent;
+
+    /**
+     * @brief Grid navigation baked from static Box/Polygon colliders and solid tilemap tiles.
+     * Each cell counts the obstacles that cover it (inflated by the agent radius), so when one static
+     * collider moves or disappears only its own cells are re-stamped instead of baking the whole grid.
+     * Single agents ask for an A* path; crowds heading to the same goal share one cached flow field
+     * and read a direction per agent in O(1).
+     * Grid bounds follow the obstacles plus a free margin, positions outside are treated as open space.
+     */
+    class NavigationSystem : public System {
+    public:
+        /** @brief Counters since the last resetStats(), for the profiler and benchmarks. */
+        struct Stats {
+            int obstacles = 0;
+            int fullBakes = 0;
+            int changedObstacles = 0;
+            int restampedCells = 0;
+            int pathQueries = 0;
+            int expandedNodes = 0;
+            int flowFieldBuilds = 0;
+            int flowQueries = 0;
+        };
+
+        NavigationSystem();
+        virtual ~NavigationSystem() = default;
+
+        /**
+         * @brief Picks up added, moved and removed static colliders, once per fixed step.
+         * Only colliders whose transform or shape changed are gathered again.
+         */
+        void onFixedUpdate(float dt) override;
+
+        /** @brief Clears the cells stamped by a destroyed obstacle. */
+        void removeEntity(Entity* entity) override;
+
+        /** @brief Cell edge in world units and clearance kept from obstacles. Rebakes the whole grid. */
+        void configure(float cellSize, float agentRadius);
+
+        /** @brief Throws away the grid and stamps every obstacle again. */
+        void rebake();
+
+        /**
+         * @brief A* from `from` to `to`, smoothed by line of sight.
+         * @param outPath waypoints after the start, the last one is `to` itself
+         * @return false if the goal cannot be reached
+         */
+        bool findPath(const glm::vec2& from, const glm::vec2& to, std::vector<glm::vec2>& outPath);
+
+        /** @brief Same search into a buffer the system reuses, valid until the next call. Null if unreachable. */
+        const std::vector<glm::vec2>* findPath(const glm::vec2& from, const glm::vec2& to);
+
+        /** @brief Unit direction an agent at `position` should move to reach `goal`, zero if unreachable. */
+        glm::vec2 getFlowDirection(const glm::vec2& goal, const glm::vec2& position);
+
+        /** @brief False if an agent centered at `position` would touch a static obstacle. */
+        bool isWalkable(const glm::vec2& position);
+
+        float getCellSize() const { return m_CellSize; }
+        float getAgentRadius() const { return m_AgentRadius; }
+        int getGridWidth() const { return m_Width; }
+        int getGridHeight() const { return m_Height; }
+        glm::vec2 getGridOrigin() const { return m_Origin; }
+        /** @brief Increases every time the walkable area changes. */
+        uint32_t getVersion() const { return m_Version; }
+
+        const Stats& getStats() const { return m_Stats; }
+        void resetStats() { m_Stats = Stats(); }
+
+    private:
+        /** @brief Everything an obstacle's shape is built from; while it stays equal the obstacle is not gathered again. */
+        struct ObstacleSource {
+            glm::mat4 world = glm::mat4(1.0f);
+            glm::vec2 offset = {0.0f, 0.0f};
+            glm::vec2 size = {0.0f, 0.0f};
+            float rotation = 0.0f;
+            std::vector<glm::vec2> outline; // polygon collider vertices
+            uint32_t tilemapVersion = 0;
+            glm::ivec2 tileSize = {0, 0};
+
+            bool operator==(const ObstacleSource& other) const = default;
+        };
+
+        struct Obstacle {
+            ObstacleSource source;
+            std::vector<glm::vec2> vertices; // world space, pieces stored one after another
+            std::vector<uint32_t> pieceSizes;
+            std::vector<int> cells;          // cells this obstacle currently blocks
+            glm::vec2 min = {0.0f, 0.0f};
+            glm::vec2 max = {0.0f, 0.0f};
+            uint32_t seenStep = 0;
+        };
+
+        struct FlowField {
+            int goalCell = -1;
+            uint32_t version = 0;
+            uint64_t lastUsed = 0;
+            std::vector<float> cost; // path length to the goal cell, infinity if unreachable
+        };
+
+        /** @brief False if the entity is no static obstacle; cheap compared to gathering its geometry. */
+        bool describeObstacle(Entity* entity, ObstacleSource& out) const;
+        bool gatherObstacle(Entity* entity, Obstacle& out) const;
+        bool gatherTilemapObstacle(Entity* entity, TilemapComponent& tilemap, Obstacle& out) const;
+        void syncObstacles();
+        void bakeAll();
+        void stampObstacle(Obstacle& obstacle);
+        void unstampObstacle(Obstacle& obstacle);
+        bool fitsGrid(const Obstacle& obstacle) const;
+
+        int cellIndex(int x, int y) const { return y * m_Width + x; }
+        int cellAt(const glm::vec2& position) const;
+        glm::vec2 cellCenter(int cell) const;
+        bool isBlocked(int cell) const { return m_Blockers[cell] != 0; }
+        bool canStep(int from, int dx, int dy) const;
+        int nearestWalkable(int cell, int maxRing) const;
+        bool lineOfSight(const glm::vec2& a, const glm::vec2& b) const;
+        const FlowField* getFlowField(int goalCell);
+
+        float m_CellSize = 32.0f;
+        float m_AgentRadius = 0.0f;
+
+        glm::vec2 m_Origin = {0.0f, 0.0f};
+        int m_Width = 0;
+        int m_Height = 0;
+        std::vector<uint16_t> m_Blockers;
+
+        std::unordered_map<Entity*, Obstacle> m_Obstacles;
+        ObstacleSource m_SourceScratch;
+        uint32_t m_SyncStep = 0;
+        bool m_BakePending = true;
+        uint32_t m_Version = 1;
+
+        // Stamp dedupe across pieces of one obstacle
+        std::vector<uint32_t> m_CellMark;
+        uint32_t m_MarkGeneration = 0;
+
+        // A* scratch, valid only where m_SearchGeneration matches
+        std::vector<float> m_GCost;
+        std::vector<int> m_Parent;
+        std::vector<uint32_t> m_Visited;
+        uint32_t m_SearchGeneration = 0;
+        std::vector<std::pair<float, int>> m_Open; // binary heap of (f, cell)
+        std::vector<glm::vec2> m_Corridor;
+        std::vector<glm::vec2> m_PathResult;
+
+        std::vector<FlowField> m_FlowFields;
+        uint64_t m_FlowClock = 0;
+
+        Stats m_Stats;
+    };
+}
@@ -7,46 +7,89 @@
 namespace Engine {
     PhysicsSystem::PhysicsSystem() {
         requireComponent<TransformComponent>();
+        setUpdateStages(SystemStage::FixedStep);
     }
 
-    void PhysicsSystem::onUpdate(float dt) {
-        const float gravityY = 9.81f * 100.0f; 
-        glm::vec2 gravity(0.0f, gravityY);
+    // Scena vola addEntity pri kazdej zmene komponentov entity, takze aj pridanie/odobratie RigidBody ci Velocity
+    void PhysicsSystem::addEntity(Entity* entity) {
+        System::addEntity(entity);
+        m_BucketsDirty = true;
+    }
+
+    void PhysicsSystem::removeEntity(Entity* entity) {
+        System::removeEntity(entity);
+        m_BucketsDirty = true;
+    }
+
+    void PhysicsSystem::rebuildBuckets() {
+        m_DynamicBodies.clear();
+        m_KinematicBodies.clear();
+        m_VelocityBodies.clear();
+        m_StaticBodies.clear();
 
         for (auto entity : getSystemEntities()) {
             auto transform = entity->getComponent<TransformComponent>();
-            
-            if (entity->hasComponent<RigidBodyComponent>()) {
-                auto rb = entity->getComponent<RigidBodyComponent>();
 
-                if (rb->bodyType == BodyType::Static) {
+            if (auto rb = entity->getComponent<RigidBodyComponent>()) {
+                switch (rb->getBodyType()) {
+                case BodyType::Dynamic:
+                    m_DynamicBodies.push_back({transform, rb});
+                    break;
+                case BodyType::Kinematic:
+                    m_KinematicBodies.push_back({transform, rb});
+                    break;
+                case BodyType::Static:
+                    // vynulovane raz pri zaradeni, dalej sa static nehybe
                     rb->velocity = glm::vec2(0.0f);
                     rb->acceleration = glm::vec2(0.0f);
-                    continue;
+                    m_StaticBodies.push_back(rb);
+                    break;
                 }
+            }
+            else if (auto vel = entity->getComponent<VelocityComponent>()) {
+                m_VelocityBodies.push_back({transform, &vel->velocity});
+            }
+        }
 
-                if (rb->bodyType == BodyType::Dynamic) {
-                    if (rb->gravityScale != 0.0f) {
-                        rb->acceleration += gravity * rb->gravityScale;
-                    }
-            
-                    rb->velocity += rb->acceleration * dt;
-                    
-                    rb->velocity *= (1.0f - rb->linearDrag * dt); 
-                    
-                    transform->position += rb->velocity * dt;
-                    
-                    rb->acceleration = glm::vec2(0.0f);
+        m_BucketsDirty = false;
+    }
+
+    void PhysicsSystem::onFixedUpdate(float dt) {
+        // Zmena typu tela ide cez RigidBodyComponent::setBodyType a addEntity, buckety netreba kazdy krok overovat
+        if (m_BucketsDirty) {
+            rebuildBuckets();
+        }
+
+        const float gravityY = 9.81f * 100.0f; 
+        glm::vec2 gravity(0.0f, gravityY);
+
+        for (const auto& entry : m_DynamicBodies) {
+            RigidBodyComponent* rb = entry.body;
+
+            if (!rb->isAwake) {
+                // Skript mohol priamo nastavit rychlost alebo telo presunut - to ho prebudi, inak ho preskocime
+                // (susedov presunuteho tela prebudi CollisionSystem)
+                const TransformComponent* tr = entry.transform;
+                bool moved = tr->previousPosition != tr->simulatedPosition || tr->previousRotation != tr->simulatedRotation;
+                if (!moved && rb->velocity == glm::vec2(0.0f) && rb->acceleration == glm::vec2(0.0f)) {
+                    continue;
                 }
-            
-                if (rb->bodyType == BodyType::Kinematic) {
-                    transform->position += rb->velocity * dt;
-                } 
-            } 
-            else if (entity->hasComponent<VelocityComponent>()) {
-                auto vel = entity->getComponent<VelocityComponent>();
-                transform->position += vel->velocity * dt;
+                rb->wake();
             }
+
+            rb->acceleration += gravity * rb->gravityScale;
+            rb->velocity += rb->acceleration * dt;
+            rb->velocity *= (1.0f - rb->linearDrag * dt); 
+            entry.transform->position += rb->velocity * dt;
+            rb->acceleration = glm::vec2(0.0f);
+        }
+
+        for (const auto& entry : m_KinematicBodies) {
+            entry.transform->position += entry.body->velocity * dt;
+        }
+
+        for (const auto& entry : m_VelocityBodies) {
+            entry.transform->position += *entry.velocity * dt;
         }
     }
-}
\ No newline at end of file
+}
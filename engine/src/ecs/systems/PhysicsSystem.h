@@ -1,13 +1,48 @@
 #pragma once
 
 #include "../System.h"
+#include <glm/glm.hpp>
+#include <vector>
 
 namespace Engine {
+    class Entity;
+    class TransformComponent;
+    class RigidBodyComponent;
+
+    /**
+     * @brief Jediny integracny krok simulacie pre RigidBody aj Velocity entity.
+     * * Entity su roztriedene podla druhu tela do suvislych poli (dynamic, kinematic, velocity-only, static),
+     * kazde pole ma vlastny jednoduchy loop. Staticke telesa sa neintegruju vobec.
+     * Buckety sa prestavaju len ked sa zmenia komponenty entity alebo typ tela.
+     */
     class PhysicsSystem : public System {
     public:
         PhysicsSystem();
         virtual ~PhysicsSystem() = default;
         
-        void onUpdate(float dt) override;
+        void onFixedUpdate(float dt) override;
+
+        void addEntity(Entity* entity) override;
+        void removeEntity(Entity* entity) override;
+
+    private:
+        struct BodyEntry {
+            TransformComponent* transform;
+            RigidBodyComponent* body;
+        };
+
+        struct VelocityEntry {
+            TransformComponent* transform;
+            glm::vec2* velocity;
+        };
+
+        void rebuildBuckets();
+
+        std::vector<BodyEntry> m_DynamicBodies;
+        std::vector<BodyEntry> m_KinematicBodies;
+        std::vector<VelocityEntry> m_VelocityBodies;
+        std::vector<RigidBodyComponent*> m_StaticBodies;
+
+        bool m_BucketsDirty = true;
     };
-}
\ No newline at end of file
+}
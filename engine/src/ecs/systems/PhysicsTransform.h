@@ -0,0 +1,51 @@
+#pragma once
+
+#include "../Entity.h"
+#include "../components/TransformComponent.h"
+#include "core/StableMath.h"
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+namespace Engine {
+    /**
+     * @brief World matice entit pre fyziku a navigaciu. Rotacia ide cez StableMath, aby kolizie
+     * aj navigacna mriezka vysli na kazdej platforme rovnako (glm::rotate pouziva libm sin/cos).
+     */
+    namespace PhysicsTransform {
+        inline glm::mat4 RotateZ(const glm::mat4& m, float degrees) {
+            float s, c;
+            StableMath::SinCosDegrees(degrees, s, c);
+
+            glm::mat4 r(1.0f);
+            r[0][0] = c;
+            r[0][1] = s;
+            r[1][0] = -s;
+            r[1][1] = c;
+            return m * r;
+        }
+
+        /** @brief Parent * local cez celu hierarchiu; stepStart = poloha pred aktualnym fixnym krokom. */
+        inline glm::mat4 GetWorldMatrix(Entity* e, bool stepStart = false) {
+            if (!e)
+                return glm::mat4(1.0f);
+
+            auto tr = e->getComponent<TransformComponent>();
+            if (!tr)
+                return glm::mat4(1.0f);
+
+            glm::mat4 local(1.0f);
+            local = glm::translate(local, glm::vec3(stepStart ? tr->previousPosition : tr->position, 0.0f));
+            local = RotateZ(local, stepStart ? tr->previousRotation : tr->rotation);
+            local = glm::scale(local, glm::vec3(tr->scale, 1.0f));
+
+            if (e->getParent())
+                return GetWorldMatrix(e->getParent(), stepStart) * local;
+            return local;
+        }
+
+        inline glm::vec2 TransformPoint(const glm::mat4& m, const glm::vec2& p) {
+            glm::vec4 r = m * glm::vec4(p.x, p.y, 0.0f, 1.0f);
+            return {r.x, r.y};
+        }
+    }
+}
@@ -0,0 +1,100 @@
+#include "RenderTransform.h"
+#include "core/RenderSpatialIndex.h"
+
+namespace Engine
+{
+
+  // Poza zavisi od alpha, kym sa transform interpoluje medzi fixnymi krokmi (pozri getRenderPosition)
+  static bool IsInterpolating(const TransformComponent &tr)
+  {
+    return (tr.position == tr.simulatedPosition && tr.position != tr.previousPosition) ||
+           (tr.rotation == tr.simulatedRotation && tr.rotation != tr.previousRotation);
+  }
+
+  void RenderTransformCache::reset(size_t slots)
+  {
+    m_Entries.assign(slots, Entry());
+    m_Nodes.clear();
+    m_LiveNodes = 0;
+  }
+
+  void RenderTransformCache::compact()
+  {
+    std::vector<Node> nodes;
+    nodes.reserve(m_LiveNodes);
+    for (Entry &entry : m_Entries)
+    {
+      uint32_t first = (uint32_t)nodes.size();
+      nodes.insert(nodes.end(), m_Nodes.begin() + entry.firstNode, m_Nodes.begin() + entry.firstNode + entry.nodeCount);
+      entry.firstNode = first;
+    }
+    m_Nodes.swap(nodes);
+  }
+
+  bool RenderTransformCache::place(uint32_t slot, Entity *entity, const glm::vec2 &halfSize, float alpha)
+  {
+    Entry &entry = m_Entries[slot];
+    if (entry.valid && entry.halfSize == halfSize && chainUnchanged(entry, entity))
+      return false;
+
+    entry.world = RenderTransform::GetWorldTransform(entity, alpha);
+    entry.halfSize = halfSize;
+    RenderSpatialIndex::TransformBounds(entry.world, halfSize, entry.min, entry.max);
+    entry.valid = storeChain(entry, entity);
+    return true;
+  }
+
+  // Retazec konci tam, kde GetWorldTransform: bez rodica alebo na entite bez transformu
+  bool RenderTransformCache::chainUnchanged(const Entry &entry, Entity *entity) const
+  {
+    uint32_t k = 0;
+    for (Entity *e = entity; e; e = e->getParent())
+    {
+      auto tr = e->getComponent<TransformComponent>();
+      if (!tr)
+        break;
+      if (k == entry.nodeCount || IsInterpolating(*tr))
+        return false;
+      const Node &node = m_Nodes[entry.firstNode + k];
+      if (node.entity != e || node.position != tr->position || node.rotation != tr->rotation || node.scale != tr->scale)
+        return false;
+      ++k;
+    }
+    return k == entry.nodeCount;
+  }
+
+  bool RenderTransformCache::storeChain(Entry &entry, Entity *entity)
+  {
+    uint32_t count = 0;
+    for (Entity *e = entity; e; e = e->getParent())
+    {
+      auto tr = e->getComponent<TransformComponent>();
+      if (!tr)
+        break;
+      // Pohybujuca sa entita sa aj tak umiestni znova dalsi frame, retazec netreba ukladat
+      if (IsInterpolating(*tr))
+        return false;
+      ++count;
+    }
+
+    if (count != entry.nodeCount)
+    {
+      // Zmena hlbky (prevesenie) je zriedkava; stare uzly ostanu ako odpad, kym ich je viac nez zivych
+      m_LiveNodes = m_LiveNodes - entry.nodeCount + count;
+      entry.nodeCount = 0;
+      if (m_Nodes.size() > 2 * m_LiveNodes + 64)
+        compact();
+      entry.firstNode = (uint32_t)m_Nodes.size();
+      entry.nodeCount = count;
+      m_Nodes.resize(m_Nodes.size() + count);
+    }
+
+    uint32_t k = 0;
+    for (Entity *e = entity; k < count; e = e->getParent(), ++k)
+    {
+      auto tr = e->getComponent<TransformComponent>();
+      m_Nodes[entry.firstNode + k] = {e, tr->position, tr->scale, tr->rotation};
+    }
+    return true;
+  }
+} // namespace Engine
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "../Entity.h"
+#include "../components/TransformComponent.h"
+#include "core/Transform2D.h"
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace Engine {
+
+    namespace RenderTransform {
+        /** @brief Parent * local cez celu hierarchiu, interpolovane medzi poslednymi dvoma fixnymi krokmi. */
+        inline Affine2D GetWorldTransform(Entity* e, float alpha) {
+            if (!e)
+                return Affine2D();
+            auto tr = e->getComponent<TransformComponent>();
+            if (!tr)
+                return Affine2D();
+
+            Affine2D local = Affine2D::FromTRS(tr->getRenderPosition(alpha), tr->getRenderRotation(alpha), tr->scale);
+            if (e->getParent())
+                return GetWorldTransform(e->getParent(), alpha) * local;
+            return local;
+        }
+    }
+
+    /**
+     * @brief World transform and AABB of each slot of a render system, kept across frames.
+     * TransformComponent has no dirty flag (scripts, physics and the editor write its fields), so a slot
+     * remembers the pose of every transform in its parent chain and is placed again only when one of them
+     * changed or still interpolates between fixed steps. Resting entities then cost a few compares per frame
+     * instead of the transform chain, the bounds and a spatial index update.
+     */
+    class RenderTransformCache {
+    public:
+        /** @brief Sets the slot count, every slot is placed again on its next place(). */
+        void reset(size_t slots);
+        void invalidate(uint32_t slot) { m_Entries[slot].valid = false; }
+
+        /**
+         * @brief Brings the slot up to date with entity, a quad of halfSize centered on its transform.
+         * @return true if the world transform and bounds were recomputed (the caller updates its index)
+         */
+        bool place(uint32_t slot, Entity* entity, const glm::vec2& halfSize, float alpha);
+
+        const Affine2D& getWorld(uint32_t slot) const { return m_Entries[slot].world; }
+        const glm::vec2& getMin(uint32_t slot) const { return m_Entries[slot].min; }
+        const glm::vec2& getMax(uint32_t slot) const { return m_Entries[slot].max; }
+
+    private:
+        // Poza jedneho transformu v retazci, ked bola entita v pokoji
+        struct Node {
+            Entity* entity;
+            glm::vec2 position;
+            glm::vec2 scale;
+            float rotation;
+        };
+
+        struct Entry {
+            bool valid = false;
+            Affine2D world;
+            glm::vec2 halfSize = {0.0f, 0.0f};
+            glm::vec2 min = {0.0f, 0.0f};
+            glm::vec2 max = {0.0f, 0.0f};
+            uint32_t firstNode = 0;
+            uint32_t nodeCount = 0;
+        };
+
+        bool chainUnchanged(const Entry& entry, Entity* entity) const;
+        bool storeChain(Entry& entry, Entity* entity);
+        void compact();
+
+        std::vector<Entry> m_Entries;
+        std::vector<Node> m_Nodes;
+        size_t m_LiveNodes = 0; // sum of nodeCount, the rest of m_Nodes is left over from changed chains
+    };
+}
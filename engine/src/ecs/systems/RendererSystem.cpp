@@ -1,51 +1,175 @@
 #include "RendererSystem.h"
+#include "RenderTransform.h"
 #include "../Entity.h"
 #include "../components/SpriteComponent.h"
 #include "../components/TransformComponent.h"
+#include "core/AssetManager.h"
 #include "core/Camera.h"
+#include "core/Project.h"
 #include <algorithm>
 #include <cmath>
-#include <glm/gtc/matrix_transform.hpp>
-#include "glm/gtc/type_ptr.hpp"
-#include "imgui.h"
+#include <cstring>
 #include "../components/AnimationComponent.h"
-#include "ImGuizmo.h"
 
 namespace Engine
 {
 
-  static glm::mat4 GetWorldMatrix(Entity *e)
+  RendererSystem::RendererSystem()
+  {
+    requireComponent<TransformComponent>();
+    requireComponent<SpriteComponent>();
+    Log::info("renderer system initialized");
+  }
+
+  void RendererSystem::addEntity(Entity *entity)
   {
-    if (!e)
-      return glm::mat4(1.0f);
-    auto tr = e->getComponent<TransformComponent>();
-    if (!tr)
-      return glm::mat4(1.0f);
+    System::addEntity(entity);
+    m_MembershipChanged = true;
+  }
+
+  void RendererSystem::removeEntity(Entity *entity)
+  {
+    m_SpatialIndex.remove(entity);
+    System::removeEntity(entity);
+    m_MembershipChanged = true;
+  }
 
-    glm::mat4 local = glm::translate(glm::mat4(1.0f), glm::vec3(tr->position.x, tr->position.y, 0.0f));
-    local = glm::rotate(local, glm::radians(tr->rotation), glm::vec3(0, 0, 1));
-    local = glm::scale(local, glm::vec3(tr->scale.x, tr->scale.y, 1.0f));
+  void RendererSystem::rebuildSlots()
+  {
+    // Staticke sprity si nesu co uz je v chunkoch; odobrate zmiznu z chunkov, ostatne sa neprekresluju
+    std::unordered_map<Entity *, StaticSnapshot> drawn;
+    for (const SpriteSlot &slot : m_Sprites)
+    {
+      if (slot.drawn.cached)
+        drawn[slot.entity] = slot.drawn;
+    }
 
-    if (e->getParent())
+    // Entity systemu su zoradene podla vytvorenia, slot v kluci teda pri zhode textury drzi poradie vytvorenia
+    m_Sprites.clear();
+    for (auto entity : getSystemEntities())
     {
-      return GetWorldMatrix(e->getParent()) * local;
+      auto sprite = entity->getComponent<SpriteComponent>();
+      if (!sprite)
+      {
+        Log::warn("Entity " + entity->getName() + " has no SpriteComponent");
+        continue;
+      }
+      SpriteSlot slot = {entity, sprite, sprite->texture, sprite->layer, sprite->zIndex, StaticSnapshot()};
+      auto it = drawn.find(entity);
+      if (it != drawn.end())
+      {
+        slot.drawn = it->second;
+        drawn.erase(it);
+      }
+      m_Sprites.push_back(slot);
     }
-    return local;
+
+    for (const auto &[entity, snapshot] : drawn)
+      m_StaticCache.invalidate(snapshot.layer, snapshot.min, snapshot.max);
+    // Sloty sa posunuli, kazdy sprite sa znova umiestni aj do indexu
+    m_Placement.reset(m_Sprites.size());
+    m_MembershipChanged = false;
   }
 
-  RendererSystem::RendererSystem()
+  void RendererSystem::updateStatic(SpriteSlot &slot, const Affine2D &world, const glm::vec2 &min, const glm::vec2 &max)
   {
-    requireComponent<TransformComponent>();
-    requireComponent<SpriteComponent>();
-    Log::info("renderer system initialized");
+    const SpriteComponent *sprite = slot.sprite;
+    StaticSnapshot &drawn = slot.drawn;
+    bool same = drawn.cached && drawn.layer == sprite->layer && drawn.zIndex == sprite->zIndex &&
+                drawn.texture == sprite->texture && drawn.world.x == world.x && drawn.world.y == world.y &&
+                drawn.world.origin == world.origin && drawn.flipH == sprite->flipH && drawn.flipV == sprite->flipV &&
+                std::memcmp(&drawn.region, &sprite->atlasRegion, sizeof(SDL_Rect)) == 0 &&
+                std::memcmp(&drawn.src, &sprite->sourceRect, sizeof(SDL_Rect)) == 0 &&
+                std::memcmp(&drawn.color, &sprite->color, sizeof(SDL_Color)) == 0;
+    if (same)
+      return;
+
+    forgetStatic(slot);
+    drawn.cached = true;
+    drawn.layer = sprite->layer;
+    drawn.zIndex = sprite->zIndex;
+    drawn.world = world;
+    drawn.texture = sprite->texture;
+    drawn.region = sprite->atlasRegion;
+    drawn.src = sprite->sourceRect;
+    drawn.color = sprite->color;
+    drawn.flipH = sprite->flipH;
+    drawn.flipV = sprite->flipV;
+    drawn.min = min;
+    drawn.max = max;
+    m_StaticCache.invalidate(drawn.layer, min, max);
+  }
+
+  void RendererSystem::forgetStatic(SpriteSlot &slot)
+  {
+    if (!slot.drawn.cached)
+      return;
+    m_StaticCache.invalidate(slot.drawn.layer, slot.drawn.min, slot.drawn.max);
+    slot.drawn.cached = false;
+  }
+
+  void RendererSystem::gatherStatic(int layer, const glm::vec2 &min, const glm::vec2 &max,
+                                    std::vector<StaticLayerCache::Sprite> &out)
+  {
+    m_StaticHits.clear();
+    m_SpatialIndex.query(min, max, m_StaticHits);
+    for (const auto &hit : m_StaticHits)
+    {
+      if (hit.userData >= m_Sprites.size() || m_Sprites[hit.userData].entity != hit.entity)
+        continue;
+      const StaticSnapshot &drawn = m_Sprites[hit.userData].drawn;
+      if (!drawn.cached || drawn.layer != layer)
+        continue;
+
+      SDL_RendererFlip flip = SDL_FLIP_NONE;
+      if (drawn.flipV)
+        flip = (SDL_RendererFlip)(flip | SDL_FLIP_VERTICAL);
+      if (drawn.flipH)
+        flip = (SDL_RendererFlip)(flip | SDL_FLIP_HORIZONTAL);
+      out.push_back({m_SlotKeys[hit.userData], drawn.texture, drawn.region, drawn.src, drawn.world,
+                     {drawn.src.w * 0.5f, drawn.src.h * 0.5f}, flip, drawn.color});
+    }
+  }
+
+  uint32_t RendererSystem::getTextureId(SDL_Texture *texture)
+  {
+    if (!texture)
+      return 0;
+    // ID podla poradia nacitania, nie adresy; cudzie textury zdielaju jedno ID a rozhodne poradie vytvorenia
+    constexpr uint32_t foreignId = RenderSortKey::MaxTextureId - 1;
+    uint32_t id = AssetManager::getTextureId(texture);
+    if (id == 0)
+      return foreignId;
+    return 1 + (id - 1) % (foreignId - 1);
+  }
+
+  void RendererSystem::rebuildOrder()
+  {
+    m_Order.clear();
+    m_Order.reserve(m_Sprites.size());
+    for (uint32_t i = 0; i < (uint32_t)m_Sprites.size(); ++i)
+    {
+      const SpriteSlot &slot = m_Sprites[i];
+      uint32_t layer = (uint32_t)std::clamp(slot.sortLayer, 0, MaxRenderLayers - 1);
+      m_Order.push_back({RenderSortKey::Pack(layer, slot.sortZIndex, getTextureId(slot.sortTexture), 0, i), i});
+    }
+    RadixSortRenderItems(m_Order, m_OrderScratch);
+    m_Stats.sorted = (int)m_Sprites.size();
+
+    m_SlotKeys.resize(m_Sprites.size());
+    for (const auto &item : m_Order)
+      m_SlotKeys[item.index] = item.key;
   }
 
-  void RendererSystem::update(SDL_Renderer *renderer, const Camera &camera, float targetWidth, float targetHeight, float dt)
+  void RendererSystem::update(RenderQueue &queue, SDL_Renderer *renderer, const Camera &camera, float targetWidth,
+                              float targetHeight, float dt, float alpha)
   {
-    if (!renderer || targetWidth <= 0 || targetHeight <= 0)
+    m_Stats = RenderStats();
+    m_StaticCache.resetStats();
+    if (targetWidth <= 0 || targetHeight <= 0)
       return;
 
-    auto entities = getSystemEntities();
+    const auto &entities = getSystemEntities();
     if (entities.empty())
     {
       static bool loggedOnce = false;
@@ -57,27 +181,162 @@ namespace Engine
       return;
     }
 
-    std::sort(entities.begin(), entities.end(), [](Entity *a, Entity *b)
-              {
-    auto sA = a->getComponent<SpriteComponent>();
-    auto sB = b->getComponent<SpriteComponent>();
-    return sA->zIndex < sB->zIndex; });
-
-    glm::mat4 viewProjection = camera.getViewProjectionMatrix();
+    bool orderChanged = m_MembershipChanged;
+    if (m_MembershipChanged)
+      rebuildSlots();
 
-    glm::mat4 viewportMatrix = glm::mat4(1.0f);
-    viewportMatrix = glm::translate(viewportMatrix, glm::vec3(targetWidth * 0.5f, targetHeight * 0.5f, 0.0f));
-    viewportMatrix = glm::scale(viewportMatrix, glm::vec3(targetWidth * 0.5f, -targetHeight * 0.5f, 1.0f));
+    m_QuadIndex.resize(m_Sprites.size());
+    m_FrameVisible.assign(m_Sprites.size(), 0);
+    m_FrameStatic.assign(m_Sprites.size(), 0);
+    m_VisibleHits.clear();
+    int worldSprites = 0;
+    // Bez render targetov sa staticke vrstvy kreslia ako ostatne
+    bool cacheStatic = renderer && SDL_RenderTargetSupported(renderer);
+    uint32_t staticLayers = 0;
 
-    for (auto entity : entities)
+    for (uint32_t i = 0; i < (uint32_t)m_Sprites.size(); ++i)
     {
+      SpriteSlot &slot = m_Sprites[i];
+      Entity *entity = slot.entity;
+      SpriteComponent *sprite = slot.sprite;
 
-      auto sprite = entity->getComponent<SpriteComponent>();
-      if (!sprite)
+      // Atlas sa mohol od minuleho frame-u zmenit (nacitanie, premenovanie assetu)
+      if (sprite->atlasVersion != AssetManager::getAtlasVersion())
       {
-        Log::warn("Entity " + entity->getName() + " has no SpriteComponent");
+        TextureRegion region;
+        if (!sprite->assetId.empty() && AssetManager::getTextureRegion(sprite->assetId, region))
+        {
+          sprite->texture = region.texture;
+          sprite->atlasRegion = region.rect;
+        }
+        else
+        {
+          sprite->atlasRegion = {0, 0, 0, 0};
+        }
+        sprite->atlasVersion = AssetManager::getAtlasVersion();
+      }
+
+      // Kluc sa meni len s vrstvou, zIndex a texturou, inak ostava poradie z minuleho frame-u
+      if (sprite->layer != slot.sortLayer || sprite->zIndex != slot.sortZIndex || sprite->texture != slot.sortTexture)
+      {
+        slot.sortLayer = sprite->layer;
+        slot.sortZIndex = sprite->zIndex;
+        slot.sortTexture = sprite->texture;
+        orderChanged = true;
+      }
+
+      // Skryte sprity sa nekreslia ani neanimuju, z indexu vypadnu kym ich niekto nezobrazi
+      bool isStatic = cacheStatic && sprite->visible && sprite->texture && !queue.isScreenSpace(sprite->layer) &&
+                      queue.isStaticLayer(sprite->layer);
+      if (!isStatic)
+        forgetStatic(slot);
+
+      if (!sprite->visible || !sprite->texture)
+      {
+        m_SpatialIndex.remove(entity);
+        m_Placement.invalidate(i);
+        continue;
+      }
+
+      if (queue.isScreenSpace(sprite->layer))
+      {
+        // Screen-space sprite je v pixeloch ciela, staci porovnat jeho otoceny obdlznik s cielom
+        m_SpatialIndex.remove(entity);
+        m_Placement.invalidate(i);
+        auto transform = entity->getComponent<TransformComponent>();
+        float hw = std::abs(sprite->sourceRect.w * transform->scale.x) * 0.5f;
+        float hh = std::abs(sprite->sourceRect.h * transform->scale.y) * 0.5f;
+        float radians = glm::radians(transform->rotation);
+        float extentX = std::abs(std::cos(radians)) * hw + std::abs(std::sin(radians)) * hh;
+        float extentY = std::abs(std::sin(radians)) * hw + std::abs(std::cos(radians)) * hh;
+        float cx = transform->position.x + sprite->sourceRect.w * transform->scale.x * 0.5f;
+        float cy = transform->position.y + sprite->sourceRect.h * transform->scale.y * 0.5f;
+        if (cx + extentX < 0.0f || cx - extentX > targetWidth || cy + extentY < 0.0f || cy - extentY > targetHeight)
+        {
+          m_Stats.culled++;
+          continue;
+        }
+        m_FrameVisible[i] = 1;
+        continue;
+      }
+
+      // Sprite v pokoji si necha transform, hranice aj miesto v indexe z minuleho frame-u
+      if (m_Placement.place(i, entity, {sprite->sourceRect.w * 0.5f, sprite->sourceRect.h * 0.5f}, alpha))
+        m_SpatialIndex.update(entity, m_Placement.getMin(i), m_Placement.getMax(i), i);
+      if (isStatic)
+      {
+        updateStatic(slot, m_Placement.getWorld(i), m_Placement.getMin(i), m_Placement.getMax(i));
+        m_FrameStatic[i] = 1;
+        staticLayers |= 1u << sprite->layer;
+        m_Stats.staticSprites++;
         continue;
       }
+      worldSprites++;
+    }
+
+    glm::vec2 viewMin, viewMax;
+    camera.getWorldBounds(viewMin, viewMax);
+    Affine2D worldToScreen = camera.getWorldToScreen(targetWidth, targetHeight);
+
+    if (orderChanged)
+      rebuildOrder();
+
+    // Staticke vrstvy: chunk quady pod ostatnym obsahom vrstvy, prekreslia sa len zmenene chunky
+    if (staticLayers)
+    {
+      auto gather = [this](int layer, const glm::vec2 &min, const glm::vec2 &max, std::vector<StaticLayerCache::Sprite> &out)
+      { gatherStatic(layer, min, max, out); };
+      uint32_t uncached = 0;
+      for (int layer = 0; layer < MaxRenderLayers; ++layer)
+      {
+        if (((staticLayers >> layer) & 1u) &&
+            !m_StaticCache.submitLayer(queue, renderer, worldToScreen, layer, viewMin, viewMax, gather))
+          uncached |= 1u << layer;
+      }
+
+      // Vrstva, ktoru cache nevykreslila, ide ako ostatne sprity, inak by zmizla
+      for (uint32_t i = 0; uncached && i < (uint32_t)m_Sprites.size(); ++i)
+      {
+        if (m_FrameStatic[i] && ((uncached >> m_Sprites[i].sprite->layer) & 1u))
+        {
+          m_FrameStatic[i] = 0;
+          m_Stats.staticSprites--;
+          worldSprites++;
+        }
+      }
+    }
+    m_StaticCache.endFrame();
+    m_Stats.staticChunks = m_StaticCache.getStats().chunks;
+    m_Stats.redrawnChunks = m_StaticCache.getStats().redrawn;
+
+    m_SpatialIndex.query(viewMin, viewMax, m_VisibleHits);
+    // Polozka, ktora tento frame nebola aktualizovana, moze mat slot z minulej zostavy
+    m_BatchWorld.clear();
+    m_BatchHalfSizes.clear();
+    for (const auto &hit : m_VisibleHits)
+    {
+      if (hit.userData >= m_Sprites.size() || m_Sprites[hit.userData].entity != hit.entity ||
+          m_FrameStatic[hit.userData])
+        continue;
+      const SDL_Rect &size = m_Sprites[hit.userData].sprite->sourceRect;
+      m_FrameVisible[hit.userData] = 1;
+      m_QuadIndex[hit.userData] = (uint32_t)m_BatchWorld.size();
+      m_BatchWorld.push_back(m_Placement.getWorld(hit.userData));
+      m_BatchHalfSizes.push_back({size.w * 0.5f, size.h * 0.5f});
+    }
+    m_Stats.culled += worldSprites - (int)m_BatchWorld.size();
+
+    // Kamera sa zlozi raz a vsetky viditelne sprity sa premietnu naraz
+    m_ScreenQuads.resize(m_BatchWorld.size());
+    ProjectQuads(worldToScreen, m_BatchWorld.data(), m_BatchHalfSizes.data(), m_BatchWorld.size(), m_ScreenQuads.data());
+
+    for (const auto &item : m_Order)
+    {
+      if (!m_FrameVisible[item.index])
+        continue;
+
+      Entity *entity = m_Sprites[item.index].entity;
+      SpriteComponent *sprite = m_Sprites[item.index].sprite;
 
       auto anim = entity->getComponent<AnimationComponent>();
 
@@ -113,7 +372,7 @@ namespace Engine
         }
       }
 
-      if (sprite->isFixed)
+      if (queue.isScreenSpace(sprite->layer))
       {
         auto transform = entity->getComponent<TransformComponent>();
         SDL_FRect destRect;
@@ -122,43 +381,20 @@ namespace Engine
         destRect.w = sprite->sourceRect.w * transform->scale.x;
         destRect.h = sprite->sourceRect.h * transform->scale.y;
         float rotation = -transform->rotation;
-        SDL_RenderCopyExF(renderer, sprite->texture, &sprite->sourceRect, &destRect, rotation, nullptr, SDL_FLIP_NONE);
+        queue.submitQuad(item.key, sprite->texture, sprite->atlasRegion, sprite->sourceRect, destRect, rotation, SDL_FLIP_NONE, sprite->color);
+        m_Stats.sprites++;
         continue;
       }
 
-      glm::mat4 modelMatrix = GetWorldMatrix(entity);
-
-      float pos[3], rot[3], scale[3];
-      ImGuizmo::DecomposeMatrixToComponents(glm::value_ptr(modelMatrix), pos, rot, scale);
-
-      glm::vec4 clipPos = viewProjection * glm::vec4(pos[0], pos[1], pos[2], 1.0f);
-      if (std::abs(clipPos.w) < 0.0001f)
-        continue;
-
-      glm::vec3 ndcPos = glm::vec3(clipPos) / clipPos.w;
-      glm::vec4 screenPos = viewportMatrix * glm::vec4(ndcPos, 1.0f);
-
-      float pixelsPerUnitX = std::abs(camera.getProjectionMatrix()[0][0]) * (targetWidth * 0.5f);
-      float pixelsPerUnitY = std::abs(camera.getProjectionMatrix()[1][1]) * (targetHeight * 0.5f);
-
-      SDL_FRect destRect;
-      destRect.w = std::abs(sprite->sourceRect.w * scale[0] * pixelsPerUnitX);
-      destRect.h = std::abs(sprite->sourceRect.h * scale[1] * pixelsPerUnitY);
-
-      destRect.x = screenPos.x - (destRect.w * 0.5f);
-      destRect.y = screenPos.y - (destRect.h * 0.5f);
-
-      SDL_SetTextureColorMod(sprite->texture, sprite->color.r, sprite->color.g, sprite->color.b);
-      SDL_SetTextureAlphaMod(sprite->texture, sprite->color.a);
-
       SDL_RendererFlip flip = SDL_FLIP_NONE;
       if (sprite->flipV)
         flip = (SDL_RendererFlip)(flip | SDL_FLIP_VERTICAL);
       if (sprite->flipH)
         flip = (SDL_RendererFlip)(flip | SDL_FLIP_HORIZONTAL);
 
-      SDL_FPoint center = {destRect.w * 0.5f, destRect.h * 0.5f};
-      SDL_RenderCopyExF(renderer, sprite->texture, &sprite->sourceRect, &destRect, -rot[2], &center, flip);
+      // Tint ide do farby vrcholov, zdielana textura sa uz neprepina pre kazdy sprite
+      queue.submitQuad(item.key, sprite->texture, sprite->atlasRegion, sprite->sourceRect, m_ScreenQuads[m_QuadIndex[item.index]], flip, sprite->color);
+      m_Stats.sprites++;
     }
   }
 } // namespace Engine
\ No newline at end of file
@@ -1,9 +1,15 @@
 #pragma once
 
 #include "../System.h" // Includes the base System class
+#include "RenderTransform.h"
 #include "SDL_render.h"
 #include "core/Camera.h"
+#include "core/RenderQueue.h"
+#include "core/RenderSpatialIndex.h"
+#include "core/StaticLayerCache.h"
 #include <SDL2/SDL.h>
+#include <unordered_map>
+#include <vector>
 
 
 namespace Engine {
@@ -13,8 +19,30 @@ namespace Engine {
     class TransformComponent;
     class SpriteComponent;
 
+    /** @brief Sprite submission counters of the last RendererSystem::update. */
+    struct RenderStats {
+        int sprites = 0;
+        int culled = 0; // outside the camera, neither drawn nor animated
+        int sorted = 0; // sprites re-sorted this frame, 0 when last frame's order was reused
+        int staticSprites = 0;  // sprites of static layers, drawn from cached chunks
+        int staticChunks = 0;   // chunk quads submitted for static layers
+        int redrawnChunks = 0;  // static chunks composited again this frame
+    };
+
     /**
      * @brief System responsible for rendering entities with a TransformComponent and SpriteComponent.
+     * Sprites are ordered by render layer, zIndex and then texture and submitted to the scene's RenderQueue,
+     * which batches runs of sprites sharing a texture.
+     * Hidden sprites are skipped and world sprites go through a spatial index first, only those
+     * overlapping the camera rect are animated and drawn.
+     * Draw order is a list of packed keys kept across frames; it is rebuilt only when
+     * a sprite is added or removed or changes its layer, zIndex or texture.
+     * World sprites are placed with 2D affine transforms; the camera is composed in once per frame.
+     * A sprite's world transform and bounds are kept across frames and its spatial index entry is only
+     * touched when its transform chain or size changes.
+     * Sprites of static layers are not submitted one by one: a StaticLayerCache composites them into
+     * chunk textures, and only chunks under a sprite whose drawn state changed are redrawn. A layer the cache
+     * cannot draw this frame is submitted sprite by sprite like any other.
      */
     class RendererSystem : public System {
     public:
@@ -25,13 +53,76 @@ namespace Engine {
         RendererSystem();
         ~RendererSystem() override = default;
 
-        void update(SDL_Renderer* renderer, const Camera& camera, float targetWidth, float targetHeight, float dt);
+        /** @brief Animates the visible sprites and submits them to queue, in target pixels. */
+        void update(RenderQueue& queue, SDL_Renderer* renderer, const Camera& camera, float targetWidth, float targetHeight,
+                    float dt, float alpha = 1.0f);
+
+        void addEntity(Entity* entity) override;
+        void removeEntity(Entity* entity) override;
 
+        const RenderStats& getStats() const { return m_Stats; }
 
     private:
-        SDL_Renderer* m_Renderer = nullptr;
+        // Co sprite na statickej vrstve naposledy nakreslil do chunkov; zmena prekresli stare aj nove miesto
+        struct StaticSnapshot {
+            bool cached = false;
+            int layer = 0;
+            int zIndex = 0;
+            Affine2D world;
+            SDL_Texture* texture = nullptr;
+            SDL_Rect region = {0, 0, 0, 0};
+            SDL_Rect src = {0, 0, 0, 0};
+            SDL_Color color = {255, 255, 255, 255};
+            bool flipH = false;
+            bool flipV = false;
+            glm::vec2 min = {0.0f, 0.0f};
+            glm::vec2 max = {0.0f, 0.0f};
+        };
+
+        // Sprite entity in creation order, with the values its sort key was built from
+        struct SpriteSlot {
+            Entity* entity;
+            SpriteComponent* sprite;
+            SDL_Texture* sortTexture;
+            int sortLayer;
+            int sortZIndex;
+            StaticSnapshot drawn;
+        };
+
+        void rebuildSlots();
+        void rebuildOrder();
+        void updateStatic(SpriteSlot& slot, const Affine2D& world, const glm::vec2& min, const glm::vec2& max);
+        void forgetStatic(SpriteSlot& slot);
+        void gatherStatic(int layer, const glm::vec2& min, const glm::vec2& max, std::vector<StaticLayerCache::Sprite>& out);
+        uint32_t getTextureId(SDL_Texture* texture);
+
         // The list of entities this system manages (those with required components)
-        std::vector<Entity*> m_RenderableEntities; 
+        std::vector<SpriteSlot> m_Sprites;
+        bool m_MembershipChanged = true;
+
+        std::vector<RenderItem> m_Order;
+        std::vector<RenderItem> m_OrderScratch;
+        std::vector<uint64_t> m_SlotKeys; // slot -> its key in m_Order
+
+        // Per slot, valid for the current frame only
+        std::vector<uint8_t> m_FrameVisible;
+        std::vector<uint8_t> m_FrameStatic; // drawn through m_StaticCache, not as a quad of its own
+        std::vector<uint32_t> m_QuadIndex; // visible world sprite -> its entry in m_ScreenQuads
+
+        // Visible world sprites, projected through the camera together in one pass
+        std::vector<Affine2D> m_BatchWorld;
+        std::vector<glm::vec2> m_BatchHalfSizes;
+        std::vector<ScreenQuad> m_ScreenQuads;
+
+        // Per slot across frames: world transform and bounds, recomputed only when the sprite moved
+        RenderTransformCache m_Placement;
+        RenderSpatialIndex m_SpatialIndex;
+        std::vector<RenderSpatialIndex::Hit> m_VisibleHits;
+
+        StaticLayerCache m_StaticCache;
+        std::vector<RenderSpatialIndex::Hit> m_StaticHits;
+
+        RenderStats m_Stats;
     };
 
 } // namespace Engine
\ No newline at end of file
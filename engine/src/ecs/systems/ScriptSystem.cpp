@@ -3,6 +3,9 @@
 #include "../components/TransformComponent.h"
 #include "../../core/Log.h"
 #include "../../ecs/Entity.h"
+#include "scene/Scene.h"
+#include "ecs/systems/CollisionSystem.h"
+#include "ecs/systems/NavigationSystem.h"
 #include "core/FileWatcher.h"
 #include "ecs/Lua/LuaBridge.h"
 #include <glm/glm.hpp>
@@ -13,6 +16,7 @@ namespace Engine {
 
     ScriptSystem::ScriptSystem(Project* project) {
         requireComponent<ScriptComponent>();
+        setUpdateStages(SystemStage::VariableStep | SystemStage::FixedStep);
 
         m_Lua.open_libraries(
             sol::lib::base,
@@ -23,6 +27,11 @@ namespace Engine {
 
         LuaBridge::Register(m_Lua, project);
 
+        // Deterministicky rezim: math.random dava pri kazdom behu rovnaku postupnost
+        if (project->getConfig().deterministicPhysics) {
+            m_Lua["math"]["randomseed"](0);
+            setDeterministic(true);
+        }
 
         if (std::filesystem::exists(project->getAssetPath())) {
             m_ScriptWatcher = std::make_unique<FileWatcher>((project->getAssetPath()).string());
@@ -46,6 +55,14 @@ namespace Engine {
         auto sc = entity->getComponent<ScriptComponent>();
         if (!sc) return;
 
+        // Lua state patri jednej scene, queries idu na jej CollisionSystem
+        if (!m_Lua["Physics"].valid() && entity->getScene()) {
+            m_Lua["Physics"] = entity->getScene()->getSystem<CollisionSystem>();
+        }
+        if (!m_Lua["Navigation"].valid() && entity->getScene()) {
+            m_Lua["Navigation"] = entity->getScene()->getSystem<NavigationSystem>();
+        }
+
         // Ensure the path in the component is also relative or corrected
         sol::load_result loadResult = m_Lua.load_file(sc->scriptPath);
         if (!loadResult.valid()) {
@@ -83,15 +100,38 @@ namespace Engine {
         }
     }
 
-    void ScriptSystem::onUpdate(float dt) {
-        if (m_ScriptWatcher) {
-            m_ScriptWatcher->update([this](std::string path, FileWatcher::FileStatus status) {
-                if (status == FileWatcher::FileStatus::MODIFIED) {
-                    Log::warn("File modified: " + path);
-                    reloadScript(path);
-                }
-            });
+    void ScriptSystem::setDeterministic(bool enabled) {
+        m_Deterministic = enabled;
+        // Scena po zmene prestavia zoznamy faz (Scene::setDeterministic)
+        setUpdateStages(enabled ? SystemStage::FixedStep : (SystemStage::VariableStep | SystemStage::FixedStep));
+    }
+
+    void ScriptSystem::pollScriptWatcher() {
+        if (!m_ScriptWatcher) return;
+        m_ScriptWatcher->update([this](std::string path, FileWatcher::FileStatus status) {
+            if (status == FileWatcher::FileStatus::MODIFIED) {
+                Log::warn("File modified: " + path);
+                reloadScript(path);
+            }
+        });
+    }
+
+    void ScriptSystem::callHook(Entity* entity, sol::table& scriptTable, const char* hook, float dt) {
+        sol::protected_function func = scriptTable[hook];
+        if (!func.valid()) return;
+
+        auto result = func(scriptTable, dt);
+        if (!result.valid()) {
+            sol::error err = result;
+            Log::error(std::string("Lua ") + hook + " Error (" + entity->getName() + "): " + err.what());
         }
+    }
+
+    void ScriptSystem::onUpdate(float dt) {
+        // Deterministicka scena tento system vo variabilnej faze nevola (pozri setDeterministic)
+        if (m_Deterministic) return;
+
+        pollScriptWatcher();
 
         for (auto entity : getSystemEntities()) {
             auto it = entityScripts.find(entity);
@@ -102,17 +142,29 @@ namespace Engine {
                 if (it == entityScripts.end()) continue;
             }
 
-            sol::table& scriptTable = it->second;
-            sol::protected_function updateFunc = scriptTable["OnUpdate"];
+            callHook(entity, it->second, "OnUpdate", dt);
+        }
+    }
 
-            if (updateFunc.valid()) {
-                auto result = updateFunc(scriptTable, dt);
-                if (!result.valid()) {
-                    sol::error err = result;
-                    Log::error("Lua Update Error (" + entity->getName() + "): " + err.what());
-                }
+    // volitelny hook pre logiku viazanu na fyziku, vola sa raz za fixny krok
+    void ScriptSystem::onFixedUpdate(float fixedDt) {
+        if (m_Deterministic) {
+            // Reload aj neskora inicializacia na hranici kroku, OnUpdate s fixnym dt namiesto dt frame-u
+            pollScriptWatcher();
+            for (auto entity : getSystemEntities()) {
+                if (entityScripts.find(entity) == entityScripts.end())
+                    initializeEntityScript(entity);
             }
         }
+
+        for (auto entity : getSystemEntities()) {
+            auto it = entityScripts.find(entity);
+            if (it == entityScripts.end()) continue;
+
+            if (m_Deterministic)
+                callHook(entity, it->second, "OnUpdate", fixedDt);
+            callHook(entity, it->second, "OnFixedUpdate", fixedDt);
+        }
     }
 
     void ScriptSystem::reloadScript(const std::string& path) {
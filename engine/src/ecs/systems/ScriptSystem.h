@@ -18,8 +18,15 @@ namespace Engine{
 
         void onInit() override;
         void onUpdate(float dt) override;
+        void onFixedUpdate(float fixedDt) override;
         void reloadScript(const std::string& path);
 
+        /**
+         * @brief In deterministic mode scripts leave the variable stage: OnUpdate runs once per fixed step
+         * with the fixed dt and late scripts are initialized at the start of a step, never between frames.
+         */
+        void setDeterministic(bool enabled);
+        bool isDeterministic() const { return m_Deterministic; }
 
     private:
         sol::state m_Lua;
@@ -27,8 +34,11 @@ namespace Engine{
         std::unordered_map<class Entity*, sol::table> entityScripts;
 
         std::unique_ptr<FileWatcher> m_ScriptWatcher;
+        bool m_Deterministic = false;
 
         void initializeEntityScript(class Entity* entity);
+        void pollScriptWatcher();
+        void callHook(class Entity* entity, sol::table& scriptTable, const char* hook, float dt);
 
 
         void verifyScriptFunctionalitly(sol::state& lua, const std::string& scriptPath) {
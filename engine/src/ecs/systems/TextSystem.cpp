@@ -1,10 +1,9 @@
 #include <SDL.h>
 #include <SDL_ttf.h>
 
-#include "imgui.h"
-#include "ImGuizmo.h"
 
 #include "TextSystem.h"
+#include "RenderTransform.h"
 #include "../components/TextComponent.h"
 #include "../components/TransformComponent.h"
 #include "../Entity.h"
@@ -13,41 +12,33 @@
 #include "core/FontManager.h"
 #include "core/Font.h"
 #include "core/Log.h"
+#include "core/Project.h"
 
 #include <algorithm>
-#include <glm/gtc/matrix_transform.hpp>
-#include <glm/gtc/type_ptr.hpp>
+#include <cmath>
 
 namespace Engine
 {
 
-static glm::mat4 GetWorldMatrix(Entity *e)
+// Glyph s dest v pixeloch textu, premietnuty cez quad celeho textu
+static ScreenQuad GlyphQuad(const ScreenQuad &box, int width, int height, const SDL_Rect &dest)
 {
-    if (!e)
-        return glm::mat4(1.0f);
-
-    auto tr = e->getComponent<TransformComponent>();
-    if (!tr)
-        return glm::mat4(1.0f);
-
-    glm::mat4 local = glm::translate(glm::mat4(1.0f),
-                                     glm::vec3(tr->position.x, tr->position.y, 0.0f));
-    local = glm::rotate(local,
-                        glm::radians(tr->rotation),
-                        glm::vec3(0, 0, 1));
-    local = glm::scale(local,
-                       glm::vec3(tr->scale.x, tr->scale.y, 1.0f));
-
-    if (e->getParent())
-        return GetWorldMatrix(e->getParent()) * local;
-
-    return local;
+    glm::vec2 pixelU = box.axisU * (2.0f / width);
+    glm::vec2 pixelV = box.axisV * (2.0f / height);
+    glm::vec2 topLeft = box.center - box.axisU - box.axisV;
+
+    ScreenQuad quad;
+    quad.center = topLeft + pixelU * (dest.x + dest.w * 0.5f) + pixelV * (dest.y + dest.h * 0.5f);
+    quad.axisU = pixelU * (dest.w * 0.5f);
+    quad.axisV = pixelV * (dest.h * 0.5f);
+    return quad;
 }
 
 TextSystem::TextSystem()
 {
     requireComponent<TransformComponent>();
     requireComponent<TextComponent>();
+    m_CacheStats.budget = DefaultTextCacheBudgetMB * 1024 * 1024;
     Log::info("Text system initialized");
 }
 
@@ -58,44 +49,172 @@ TextSystem::~TextSystem()
         if (data.texture)
             SDL_DestroyTexture(data.texture);
     }
+    for (SDL_Texture *texture : m_PendingDestroy)
+        SDL_DestroyTexture(texture);
+}
+
+void TextSystem::addEntity(Entity *entity)
+{
+    System::addEntity(entity);
+    m_MembershipChanged = true;
+}
+
+void TextSystem::removeEntity(Entity *entity)
+{
+    m_SpatialIndex.remove(entity);
+    System::removeEntity(entity);
+    m_MembershipChanged = true;
+
+    // Nova entita na rovnakej adrese nesmie dostat staru texturu
+    auto it = m_TextData.find(entity);
+    if (it == m_TextData.end())
+        return;
+    if (it->second.texture)
+    {
+        m_PendingDestroy.push_back(it->second.texture);
+        it->second.texture = nullptr;
+        m_CacheStats.bytes -= (size_t)it->second.width * it->second.height * 4;
+        m_CacheStats.textures--;
+        m_Lru.erase(it->second.lruEntry);
+    }
+    m_TextData.erase(it);
+}
+
+bool TextSystem::createTexture(SDL_Renderer *renderer, Entity *entity, TextComponent *text, TextRenderData &data)
+{
+    SDL_Surface *surface = TTF_RenderUTF8_Blended(text->font->get(), text->text.c_str(), text->color);
+    if (!surface)
+    {
+        Log::error(("TextSystem: Failed to create surface for entity '" +
+                    entity->getName() + "': " + TTF_GetError()));
+        data.width = data.height = 0;
+        return false;
+    }
+
+    data.texture = SDL_CreateTextureFromSurface(renderer, surface);
+    if (!data.texture)
+    {
+        Log::error(("TextSystem: Failed to create texture for entity '" +
+                    entity->getName() + "': " + SDL_GetError()));
+        SDL_FreeSurface(surface);
+        data.width = data.height = 0;
+        return false;
+    }
+
+    data.width = surface->w;
+    data.height = surface->h;
+    SDL_FreeSurface(surface);
+
+    m_Lru.push_front(entity);
+    data.lruEntry = m_Lru.begin();
+    m_CacheStats.bytes += (size_t)data.width * data.height * 4;
+    m_CacheStats.textures++;
+    m_Stats.textureUploads++;
+    return true;
+}
+
+void TextSystem::destroyTexture(TextRenderData &data)
+{
+    if (!data.texture)
+        return;
+    SDL_DestroyTexture(data.texture);
+    data.texture = nullptr;
+    m_CacheStats.bytes -= (size_t)data.width * data.height * 4;
+    m_CacheStats.textures--;
+    m_Lru.erase(data.lruEntry);
 }
 
-void TextSystem::update(SDL_Renderer *renderer,
+void TextSystem::trimTextures()
+{
+    // Koniec zoznamu je najdavnejsie kresleny; co je nakreslene v tomto frame-i, ostava
+    while (m_CacheStats.bytes > m_CacheStats.budget && !m_Lru.empty())
+    {
+        TextRenderData &data = m_TextData[m_Lru.back()];
+        if (data.lastUsed == m_Frame)
+            break;
+        destroyTexture(data);
+        m_CacheStats.evictions++;
+    }
+}
+
+void TextSystem::rebuildSlots()
+{
+    m_Texts.clear();
+    for (auto entity : getSystemEntities())
+    {
+        auto text = entity->getComponent<TextComponent>();
+        if (!text)
+            continue;
+        m_Texts.push_back({entity, text, &m_TextData[entity], text->layer, text->zIndex});
+    }
+    m_Placement.reset(m_Texts.size());
+    m_MembershipChanged = false;
+}
+
+void TextSystem::rebuildOrder()
+{
+    m_Order.clear();
+    m_Order.reserve(m_Texts.size());
+    for (uint32_t i = 0; i < (uint32_t)m_Texts.size(); ++i)
+    {
+        uint32_t layer = (uint32_t)std::clamp(m_Texts[i].sortLayer, 0, MaxRenderLayers - 1);
+        m_Order.push_back({RenderSortKey::Pack(layer, m_Texts[i].sortZIndex, RenderSortKey::TextTextureId, 0, i), i});
+    }
+    RadixSortRenderItems(m_Order, m_OrderScratch);
+    m_Stats.sorted = (int)m_Texts.size();
+}
+
+void TextSystem::update(RenderQueue &queue,
+                        SDL_Renderer *renderer,
                         const Camera &camera,
                         float targetWidth,
                         float targetHeight,
-                        Project *project)
+                        Project *project,
+                        float alpha)
 {
+    m_Stats = TextStats();
     if (!renderer || targetWidth <= 0 || targetHeight <= 0)
         return;
 
-    auto entities = getSystemEntities();
+    // Predchadzajuci frame je uz vykresleny, textury odobratych entit mozno zrusit
+    for (SDL_Texture *texture : m_PendingDestroy)
+        SDL_DestroyTexture(texture);
+    m_PendingDestroy.clear();
+    m_Frame++;
+
+    // Plny atlas sa zahodi tu, kym ziadny text z tohto frame-u este nema quady
+    m_GlyphAtlas.beginFrame();
+    m_GlyphAtlas.resetStats();
+
+    const auto &entities = getSystemEntities();
     if (entities.empty())
         return;
 
-    // Sort by Z index
-    std::sort(entities.begin(), entities.end(),
-              [](Entity *a, Entity *b)
-              {
-                  return a->getComponent<TextComponent>()->zIndex <
-                         b->getComponent<TextComponent>()->zIndex;
-              });
-
-    glm::mat4 viewProjection = camera.getViewProjectionMatrix();
+    bool orderChanged = m_MembershipChanged;
+    if (m_MembershipChanged)
+        rebuildSlots();
 
-    glm::mat4 viewportMatrix(1.0f);
-    viewportMatrix = glm::translate(viewportMatrix,
-                                    glm::vec3(targetWidth * 0.5f, targetHeight * 0.5f, 0.0f));
-    viewportMatrix = glm::scale(viewportMatrix,
-                                glm::vec3(targetWidth * 0.5f, -targetHeight * 0.5f, 1.0f));
+    m_QuadIndex.resize(m_Texts.size());
+    m_FrameVisible.assign(m_Texts.size(), 0);
+    m_VisibleHits.clear();
+    int worldTexts = 0;
 
-    for (auto entity : entities)
+    for (uint32_t i = 0; i < (uint32_t)m_Texts.size(); ++i)
     {
-        auto text = entity->getComponent<TextComponent>();
+        TextSlot &slot = m_Texts[i];
+        Entity *entity = slot.entity;
+        TextComponent *text = slot.text;
         auto transform = entity->getComponent<TransformComponent>();
-        if (!text || !transform)
+        if (!transform)
             continue;
 
+        if (text->layer != slot.sortLayer || text->zIndex != slot.sortZIndex)
+        {
+            slot.sortLayer = text->layer;
+            slot.sortZIndex = text->zIndex;
+            orderChanged = true;
+        }
+
         // Load font if missing
         if (!text->font && !text->fontPath.empty())
         {
@@ -109,16 +228,16 @@ void TextSystem::update(SDL_Renderer *renderer,
             text->dirty = true;
         }
 
-        auto &renderData = m_TextData[entity];
+        auto &renderData = *slot.data;
 
-        // Rebuild texture if dirty
-        if (text->dirty)
+        // Rebuild texture if dirty (velkost textury treba aj na culling)
+        bool staleGlyphs = renderData.usesGlyphs &&
+                           (!text->dynamic || renderData.glyphGeneration != m_GlyphAtlas.getGeneration());
+        bool rebuildTexture = false;
+        if (text->dirty || staleGlyphs || (text->dynamic && !renderData.usesGlyphs))
         {
-            if (renderData.texture)
-            {
-                SDL_DestroyTexture(renderData.texture);
-                renderData.texture = nullptr;
-            }
+            destroyTexture(renderData);
+            renderData.width = renderData.height = 0;
 
             if (!text->font)
             {
@@ -128,92 +247,166 @@ void TextSystem::update(SDL_Renderer *renderer,
                 continue;
             }
 
-            SDL_Surface *surface = TTF_RenderUTF8_Blended(text->font->get(),
-                                                          text->text.c_str(),
-                                                          text->color);
-            if (!surface)
+            renderData.usesGlyphs = text->dynamic;
+            renderData.glyphs.clear();
+            if (text->dynamic)
             {
-                Log::error(("TextSystem: Failed to create surface for entity '" +
-                            entity->getName() + "': " + TTF_GetError()));
+                // Farba ide do vrcholov, glyphy v atlase su biele
+                m_GlyphAtlas.layout(renderer, *text->font, text->text, renderData.glyphs, renderData.width, renderData.height);
+                renderData.glyphGeneration = m_GlyphAtlas.getGeneration();
+                m_Stats.layouts++;
                 text->dirty = false;
-                continue;
             }
-
-            renderData.texture = SDL_CreateTextureFromSurface(renderer, surface);
-            if (!renderData.texture)
+            else
             {
-                Log::error(("TextSystem: Failed to create texture for entity '" +
-                            entity->getName() + "': " + SDL_GetError()));
-                SDL_FreeSurface(surface);
-                text->dirty = false;
-                continue;
+                rebuildTexture = true;
             }
+        }
 
-            renderData.width = surface->w;
-            renderData.height = surface->h;
-            SDL_FreeSurface(surface);
-
+        if (rebuildTexture)
+        {
+            // Textura vznikne az ked sa text kresli, na culling staci velkost
+            int width = 0, height = 0;
+            if (TTF_SizeUTF8(text->font->get(), text->text.c_str(), &width, &height) != 0)
+            {
+                Log::error(("TextSystem: Failed to measure text of entity '" +
+                            entity->getName() + "': " + TTF_GetError()));
+                width = height = 0;
+            }
+            renderData.width = width;
+            renderData.height = height;
             text->dirty = false;
         }
 
-        if (!renderData.texture)
+        if (!renderData.usesGlyphs && (renderData.width <= 0 || renderData.height <= 0))
+        {
+            m_SpatialIndex.remove(entity);
+            m_Placement.invalidate(i);
             continue;
+        }
 
-        // --------------------------
-        // FIXED (UI text)
-        // --------------------------
-        if (text->isFixed)
+        if (queue.isScreenSpace(text->layer))
         {
-            SDL_FRect dst;
-            dst.x = transform->position.x;
-            dst.y = transform->position.y;
-            dst.w = renderData.width * transform->scale.x;
-            dst.h = renderData.height * transform->scale.y;
-
-            SDL_RenderCopyExF(renderer,
-                              renderData.texture,
-                              nullptr,
-                              &dst,
-                              -transform->rotation,
-                              nullptr,
-                              SDL_FLIP_NONE);
+            // Screen-space text je v pixeloch ciela, otoceny obdlznik sa porovna priamo s cielom
+            m_SpatialIndex.remove(entity);
+            m_Placement.invalidate(i);
+            float hw = std::abs(renderData.width * transform->scale.x) * 0.5f;
+            float hh = std::abs(renderData.height * transform->scale.y) * 0.5f;
+            float radians = glm::radians(transform->rotation);
+            float extentX = std::abs(std::cos(radians)) * hw + std::abs(std::sin(radians)) * hh;
+            float extentY = std::abs(std::sin(radians)) * hw + std::abs(std::cos(radians)) * hh;
+            float cx = transform->position.x + renderData.width * transform->scale.x * 0.5f;
+            float cy = transform->position.y + renderData.height * transform->scale.y * 0.5f;
+            if (cx + extentX < 0.0f || cx - extentX > targetWidth || cy + extentY < 0.0f || cy - extentY > targetHeight)
+            {
+                m_Stats.culled++;
+                continue;
+            }
+            m_FrameVisible[i] = 1;
             continue;
         }
 
-        // --------------------------
-        // WORLD SPACE
-        // --------------------------
-        glm::mat4 modelMatrix = GetWorldMatrix(entity);
-
-        float pos[3], rot[3], scale[3];
-        ImGuizmo::DecomposeMatrixToComponents(glm::value_ptr(modelMatrix), pos, rot, scale);
+        // Text v pokoji s rovnakou velkostou si necha transform, hranice aj miesto v indexe
+        if (m_Placement.place(i, entity, {renderData.width * 0.5f, renderData.height * 0.5f}, alpha))
+            m_SpatialIndex.update(entity, m_Placement.getMin(i), m_Placement.getMax(i), i);
+        worldTexts++;
+    }
 
-        glm::vec4 clipPos = viewProjection * glm::vec4(pos[0], pos[1], pos[2], 1.0f);
-        if (std::abs(clipPos.w) < 0.0001f)
+    glm::vec2 viewMin, viewMax;
+    camera.getWorldBounds(viewMin, viewMax);
+    m_SpatialIndex.query(viewMin, viewMax, m_VisibleHits);
+    // Polozka, ktora tento frame nebola aktualizovana, moze mat slot z minulej zostavy
+    m_BatchWorld.clear();
+    m_BatchHalfSizes.clear();
+    for (const auto &hit : m_VisibleHits)
+    {
+        if (hit.userData >= m_Texts.size() || m_Texts[hit.userData].entity != hit.entity)
             continue;
+        const TextRenderData &renderData = *m_Texts[hit.userData].data;
+        m_FrameVisible[hit.userData] = 1;
+        m_QuadIndex[hit.userData] = (uint32_t)m_BatchWorld.size();
+        m_BatchWorld.push_back(m_Placement.getWorld(hit.userData));
+        m_BatchHalfSizes.push_back({renderData.width * 0.5f, renderData.height * 0.5f});
+    }
+    m_Stats.culled += worldTexts - (int)m_BatchWorld.size();
+
+    m_ScreenQuads.resize(m_BatchWorld.size());
+    ProjectQuads(camera.getWorldToScreen(targetWidth, targetHeight), m_BatchWorld.data(), m_BatchHalfSizes.data(),
+                 m_BatchWorld.size(), m_ScreenQuads.data());
 
-        glm::vec3 ndcPos = glm::vec3(clipPos) / clipPos.w;
-        glm::vec4 screenPos = viewportMatrix * glm::vec4(ndcPos, 1.0f);
+    // Sort by Z index, len ak sa od minuleho frame-u nieco zmenilo
+    if (orderChanged)
+        rebuildOrder();
 
-        float pixelsPerUnitX = std::abs(camera.getProjectionMatrix()[0][0]) * (targetWidth * 0.5f);
-        float pixelsPerUnitY = std::abs(camera.getProjectionMatrix()[1][1]) * (targetHeight * 0.5f);
+    // Text nema zdielanu texturu, rect cez celu texturu a farba je uz v nej
+    const SDL_Rect wholeTexture = {0, 0, 0, 0};
+    const SDL_Color white = {255, 255, 255, 255};
 
-        SDL_FRect dst;
-        dst.w = std::abs(renderData.width * scale[0] * pixelsPerUnitX);
-        dst.h = std::abs(renderData.height * scale[1] * pixelsPerUnitY);
-        dst.x = screenPos.x - (dst.w * 0.5f);
-        dst.y = screenPos.y - (dst.h * 0.5f);
+    for (const auto &item : m_Order)
+    {
+        if (!m_FrameVisible[item.index])
+            continue;
 
-        SDL_FPoint center = {dst.w * 0.5f, dst.h * 0.5f};
+        Entity *entity = m_Texts[item.index].entity;
+        TextComponent *text = m_Texts[item.index].text;
+        TextRenderData &renderData = *m_Texts[item.index].data;
+        if (!renderData.usesGlyphs)
+        {
+            if (renderData.texture)
+            {
+                m_CacheStats.hits++;
+            }
+            else
+            {
+                m_CacheStats.misses++;
+                if (!createTexture(renderer, entity, text, renderData))
+                    continue;
+            }
+            renderData.lastUsed = m_Frame;
+            m_Lru.splice(m_Lru.begin(), m_Lru, renderData.lruEntry);
+        }
+        m_Stats.texts++;
 
-        SDL_RenderCopyExF(renderer,
-                          renderData.texture,
-                          nullptr,
-                          &dst,
-                          -rot[2],
-                          &center,
-                          SDL_FLIP_NONE);
+        ScreenQuad box;
+        if (queue.isScreenSpace(text->layer))
+        {
+            // SCREEN SPACE (UI text)
+            auto transform = entity->getComponent<TransformComponent>();
+            SDL_FRect dst;
+            dst.x = transform->position.x;
+            dst.y = transform->position.y;
+            dst.w = renderData.width * transform->scale.x;
+            dst.h = renderData.height * transform->scale.y;
+            box = ScreenQuad::FromRect(dst, -transform->rotation);
+        }
+        else
+        {
+            // WORLD SPACE
+            box = m_ScreenQuads[m_QuadIndex[item.index]];
+        }
+
+        if (renderData.usesGlyphs)
+        {
+            // Glyphy z jednej stranky atlasu idu do jedneho draw callu
+            if (renderData.width <= 0 || renderData.height <= 0)
+                continue;
+            for (const auto &glyph : renderData.glyphs)
+            {
+                queue.submitQuad(item.key, glyph.texture, wholeTexture, glyph.src,
+                                 GlyphQuad(box, renderData.width, renderData.height, glyph.dest), SDL_FLIP_NONE, text->color);
+            }
+            m_Stats.glyphTexts++;
+            continue;
+        }
+
+        SDL_Rect src = {0, 0, renderData.width, renderData.height};
+        queue.submitQuad(item.key, renderData.texture, wholeTexture, src, box, SDL_FLIP_NONE, white);
     }
+    m_Stats.glyphUploads = m_GlyphAtlas.getStats().uploads;
+
+    trimTextures();
+    m_CacheStats.glyphBytes = (size_t)m_GlyphAtlas.getStats().pages * GlyphAtlas::PageSize * GlyphAtlas::PageSize * 4;
+    FontManager::Trim();
 }
 
 } // namespace Engine
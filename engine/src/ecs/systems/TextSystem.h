@@ -1,34 +1,137 @@
 #pragma once
 
 #include "../System.h"
+#include "RenderTransform.h"
 #include <SDL2/SDL.h>
+#include <cstddef>
+#include <cstdint>
+#include <list>
 #include <unordered_map>
+#include <vector>
+#include "core/GlyphAtlas.h"
 #include "core/Project.h"
+#include "core/RenderQueue.h"
+#include "core/RenderSpatialIndex.h"
 
 namespace Engine {
 
 class Camera;
 class Entity;
+class TextComponent;
 
+/** @brief Text submission counters of the last TextSystem::update. */
+struct TextStats {
+    int texts = 0;
+    int culled = 0;
+    int sorted = 0; // texts re-sorted this frame, 0 when last frame's order was reused
+    int glyphTexts = 0;     // drawn texts laid out from the glyph atlas
+    int layouts = 0;        // glyph texts laid out again this frame
+    int textureUploads = 0; // per-entity text textures created this frame
+    int glyphUploads = 0;   // glyphs rasterized into the atlas this frame
+};
+
+/** @brief Text texture cache state; hits, misses and evictions count since the system was created. */
+struct TextCacheStats {
+    size_t bytes = 0;      // estimated GPU memory of the cached text textures (4 bytes per pixel)
+    size_t budget = 0;
+    size_t glyphBytes = 0; // glyph atlas pages
+    int textures = 0;
+    uint64_t hits = 0;      // drawn text whose texture was cached
+    uint64_t misses = 0;    // drawn text that had to be rasterized
+    uint64_t evictions = 0; // textures freed to stay within the budget
+};
+
+/**
+ * @brief Submits TextComponents to the scene's RenderQueue.
+ * Static text is drawn from its own cached texture; dynamic text is laid out as quads from a shared GlyphAtlas,
+ * so changing it costs a layout pass instead of a texture upload, and glyph texts sharing a page batch together.
+ * World-space texts are culled through a spatial index against the camera rect, fixed (UI) texts against the target.
+ * Index entries and world transforms of texts that did not move or resize are reused from the previous frame.
+ * Draw order is kept across frames and re-sorted only when a text is added, removed or changes its layer or zIndex.
+ * At equal layer and zIndex text is drawn over sprites.
+ * Text textures are created only when the text is drawn and kept in an LRU list under a memory budget;
+ * textures of texts not drawn this frame are freed first and rasterized again once the text is visible.
+ */
 class TextSystem : public System {
 public:
     TextSystem();
     ~TextSystem() override;
 
-    void update(SDL_Renderer* renderer,
+    /** @brief Rebuilds dirty text textures and submits the visible texts to queue. */
+    void update(RenderQueue& queue,
+                SDL_Renderer* renderer,
                 const Camera& camera,
                 float targetWidth,
                 float targetHeight,
-                Project* project);
+                Project* project,
+                float alpha = 1.0f);
+
+    void addEntity(Entity* entity) override;
+    void removeEntity(Entity* entity) override;
+
+    const TextStats& getStats() const { return m_Stats; }
+    const TextCacheStats& getCacheStats() const { return m_CacheStats; }
+
+    /** @brief GPU memory the text textures may keep; textures drawn this frame are never evicted. */
+    void setTextureBudget(size_t bytes) { m_CacheStats.budget = bytes; }
 
 private:
     struct TextRenderData {
-        SDL_Texture* texture = nullptr;
-        int width = 0;
+        SDL_Texture* texture = nullptr; // null until drawn, or after eviction
+        int width = 0;                  // text size, known without the texture (culling)
         int height = 0;
+        std::list<Entity*>::iterator lruEntry;
+        uint64_t lastUsed = 0;
+
+        // Dynamic text: glyph quads in text pixels, valid while the atlas keeps its generation
+        bool usesGlyphs = false;
+        std::vector<GlyphAtlas::Quad> glyphs;
+        uint32_t glyphGeneration = 0;
     };
 
+    // Text entity in creation order, with the zIndex its sort key was built from
+    struct TextSlot {
+        Entity* entity;
+        TextComponent* text;
+        TextRenderData* data;
+        int sortLayer;
+        int sortZIndex;
+    };
+
+    void rebuildSlots();
+    void rebuildOrder();
+    bool createTexture(SDL_Renderer* renderer, Entity* entity, TextComponent* text, TextRenderData& data);
+    void destroyTexture(TextRenderData& data);
+    void trimTextures();
+
     std::unordered_map<Entity*, TextRenderData> m_TextData;
+    // Najdavnejsie kreslene texty su na konci
+    std::list<Entity*> m_Lru;
+    uint64_t m_Frame = 0;
+    // removeEntity bezi v simulacii, kym sa moze este kreslit predchadzajuci frame; textury sa zrusia az v update
+    std::vector<SDL_Texture*> m_PendingDestroy;
+    TextCacheStats m_CacheStats;
+    GlyphAtlas m_GlyphAtlas;
+
+    std::vector<TextSlot> m_Texts;
+    bool m_MembershipChanged = true;
+    std::vector<RenderItem> m_Order;
+    std::vector<RenderItem> m_OrderScratch;
+
+    // Per slot, valid for the current frame only
+    std::vector<uint8_t> m_FrameVisible;
+    std::vector<uint32_t> m_QuadIndex;
+
+    // Visible world texts, projected through the camera together in one pass
+    std::vector<Affine2D> m_BatchWorld;
+    std::vector<glm::vec2> m_BatchHalfSizes;
+    std::vector<ScreenQuad> m_ScreenQuads;
+
+    // Per slot across frames: world transform and bounds, recomputed only when the text moved or resized
+    RenderTransformCache m_Placement;
+    RenderSpatialIndex m_SpatialIndex;
+    std::vector<RenderSpatialIndex::Hit> m_VisibleHits;
+    TextStats m_Stats;
 };
 
 }
\ No newline at end of file
@@ -0,0 +1,121 @@
+#include "TilemapSystem.h"
+#include "RenderTransform.h"
+#include "../Entity.h"
+#include "../components/TilemapComponent.h"
+#include "../components/TransformComponent.h"
+#include "core/AssetManager.h"
+#include "core/Log.h"
+#include "core/Project.h"
+#include <algorithm>
+
+namespace Engine {
+
+    using RenderTransform::GetWorldTransform;
+
+    // Chunk ako obdlznik premietnuty do cielovych pixelov, test proti celemu cielu
+    static bool ChunkVisible(const Affine2D& toScreen, const glm::vec2& min, const glm::vec2& max, float width, float height)
+    {
+        const glm::vec2 corners[4] = {min, {max.x, min.y}, max, {min.x, max.y}};
+        glm::vec2 lo = toScreen.apply(corners[0]);
+        glm::vec2 hi = lo;
+        for (int i = 1; i < 4; ++i)
+        {
+            glm::vec2 p = toScreen.apply(corners[i]);
+            lo = glm::min(lo, p);
+            hi = glm::max(hi, p);
+        }
+        return hi.x >= 0.0f && lo.x <= width && hi.y >= 0.0f && lo.y <= height;
+    }
+
+    TilemapSystem::TilemapSystem()
+    {
+        requireComponent<TransformComponent>();
+        requireComponent<TilemapComponent>();
+        Log::info("tilemap system initialized");
+    }
+
+    void TilemapSystem::update(RenderQueue& queue, const Camera& camera, float targetWidth, float targetHeight, float alpha)
+    {
+        m_Stats = TilemapStats();
+        if (targetWidth <= 0 || targetHeight <= 0)
+            return;
+
+        const auto& entities = getSystemEntities();
+        if (entities.empty())
+            return;
+
+        // Tilemap je v scene malo, poradie sa zoradi kazdy frame
+        m_Order.clear();
+        for (uint32_t i = 0; i < (uint32_t)entities.size(); ++i)
+        {
+            auto tilemap = entities[i]->getComponent<TilemapComponent>();
+            if (!tilemap || !tilemap->visible)
+                continue;
+            uint32_t layer = (uint32_t)std::clamp(tilemap->layer, 0, MaxRenderLayers - 1);
+            m_Order.push_back({RenderSortKey::Pack(layer, tilemap->zIndex, RenderSortKey::TilemapTextureId, 0, i), i});
+        }
+        RadixSortRenderItems(m_Order, m_OrderScratch);
+
+        Affine2D worldToScreen = camera.getWorldToScreen(targetWidth, targetHeight);
+        for (const auto& item : m_Order)
+        {
+            Entity* entity = entities[item.index];
+            auto tilemap = entity->getComponent<TilemapComponent>();
+
+            if (tilemap->atlasVersion != AssetManager::getAtlasVersion())
+            {
+                TextureRegion region;
+                if (!tilemap->tilesetAssetId.empty() && AssetManager::getTextureRegion(tilemap->tilesetAssetId, region))
+                {
+                    tilemap->texture = region.texture;
+                    tilemap->atlasRegion = region.rect;
+                }
+                else
+                {
+                    tilemap->texture = nullptr;
+                    tilemap->atlasRegion = {0, 0, 0, 0};
+                }
+                tilemap->atlasVersion = AssetManager::getAtlasVersion();
+                // Rovnaky region v novej texture ma ine UV
+                tilemap->invalidateGeometry();
+            }
+            if (!tilemap->texture)
+                continue;
+
+            Affine2D toScreen;
+            if (queue.isScreenSpace(tilemap->layer))
+            {
+                // Pozicia v pixeloch ciela, riadky rastu nahor ako vo svete
+                auto transform = entity->getComponent<TransformComponent>();
+                Affine2D flipY;
+                flipY.y = {0.0f, -1.0f};
+                toScreen = Affine2D::FromTRS(transform->position, -transform->rotation, transform->scale) * flipY;
+            }
+            else
+            {
+                toScreen = worldToScreen * GetWorldTransform(entity, alpha);
+            }
+
+            int textureW = 0, textureH = 0;
+            SDL_QueryTexture(tilemap->texture, nullptr, nullptr, &textureW, &textureH);
+
+            glm::vec2 chunkExtent = glm::vec2(tilemap->tileSize) * (float)TilemapComponent::ChunkSize;
+            for (const auto& [key, chunk] : tilemap->getChunks())
+            {
+                glm::vec2 min = glm::vec2(TilemapComponent::ChunkCoords(key)) * chunkExtent;
+                if (!ChunkVisible(toScreen, min, min + chunkExtent, targetWidth, targetHeight))
+                {
+                    m_Stats.culled++;
+                    continue;
+                }
+
+                if (chunk.geometryDirty)
+                    m_Stats.rebuiltChunks++;
+                const auto& vertices = tilemap->getChunkGeometry(key, textureW, textureH);
+                queue.submitGeometry(item.key, tilemap->texture, toScreen, vertices.data(), (int)vertices.size(), tilemap->color);
+                m_Stats.chunks++;
+            }
+            m_Stats.tilemaps++;
+        }
+    }
+}
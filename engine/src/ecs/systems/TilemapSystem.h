@@ -0,0 +1,43 @@
+#pragma once
+
+#include "../System.h"
+#include "core/Camera.h"
+#include "core/RenderQueue.h"
+#include <vector>
+
+namespace Engine {
+
+    class Entity;
+
+    /** @brief Tilemap submission counters of the last TilemapSystem::update. */
+    struct TilemapStats {
+        int tilemaps = 0;
+        int chunks = 0;        // chunks submitted to the queue
+        int culled = 0;        // chunks outside the target
+        int rebuiltChunks = 0; // chunks whose quads were rebuilt this frame
+    };
+
+    /**
+     * @brief Submits TilemapComponents to the scene's RenderQueue, one geometry command per visible chunk.
+     * Chunk quads are cached in the component in local space, so a frame only transforms the vertices of
+     * chunks overlapping the target; chunks are rebuilt only after their tiles or the tileset changed.
+     * All chunks of a tilemap share the tileset texture and end up in one draw call.
+     * At equal layer and zIndex tilemaps are drawn under sprites.
+     */
+    class TilemapSystem : public System {
+    public:
+        TilemapSystem();
+        ~TilemapSystem() override = default;
+
+        /** @brief Submits the visible chunks to queue, in target pixels. */
+        void update(RenderQueue& queue, const Camera& camera, float targetWidth, float targetHeight, float alpha = 1.0f);
+
+        const TilemapStats& getStats() const { return m_Stats; }
+
+    private:
+        std::vector<RenderItem> m_Order;
+        std::vector<RenderItem> m_OrderScratch;
+
+        TilemapStats m_Stats;
+    };
+}
@@ -2,17 +2,23 @@
 #include "../core/Log.h"
 #include "../ecs/Entity.h"
 #include "../ecs/System.h"
+#include "../ecs/components/TransformComponent.h"
+#include "../ecs/components/RigidBodyComponent.h"
+#include "../ecs/components/VelocityComponent.h"
+#include <algorithm>
+#include <cstring>
 
 // System Includes
 #include "ecs/systems/RendererSystem.h"
 #include "ecs/systems/CameraSystem.h"
 #include "ecs/systems/CollisionSystem.h"
 #include "ecs/systems/InputSystem.h"
-#include "ecs/systems/MovementSystem.h"
+#include "ecs/systems/NavigationSystem.h"
 #include "ecs/systems/PhysicsSystem.h"
 #include "ecs/systems/ScriptSystem.h"
 #include "ecs/systems/SoundSystem.h"
 #include "ecs/systems/TextSystem.h"
+#include "ecs/systems/TilemapSystem.h"
 
 namespace Engine {
 
@@ -23,23 +29,30 @@ Scene::Scene(const std::string& name)
     
     addSystem<RendererSystem>();
     addSystem<InputSystem>();
-    addSystem<MovementSystem>();
-    addSystem<CollisionSystem>();
+    // fixny krok: integracia -> kolizie
     addSystem<PhysicsSystem>();
+    addSystem<CollisionSystem>();
+    addSystem<NavigationSystem>();
     addSystem<CameraSystem>();
     addSystem<SoundSystem>();
     addSystem<TextSystem>();
+    addSystem<TilemapSystem>();
+
+    m_ScreenSpaceLayers = GetScreenSpaceLayerMask(MakeDefaultRenderLayers());
 }
 
 Scene::~Scene() {
     Log::info("Scene erased: " + name);
+    m_SystemOrder.clear();
+    m_VariableSystems.clear();
+    m_FixedSystems.clear();
     m_Systems.clear();
     m_EntityWrappers.clear();
 }
 
 Entity* Scene::createEntity(const std::string& eName) {
     entt::entity handle = m_Registry->create();
-    auto entity = std::make_unique<Entity>(handle, this, eName);
+    auto entity = std::make_unique<Entity>(handle, this, eName, m_NextCreationIndex++);
     
     Entity* raw_ptr = entity.get();
     m_EntityWrappers[handle] = std::move(entity);
@@ -56,7 +69,7 @@ void Scene::destroyEntity(Entity* entity) {
     entity->isRemoved = true;
     entt::entity handle = entity->getHandle();
 
-    for (auto& [_, system] : m_Systems) {
+    for (System* system : m_SystemOrder) {
         system->removeEntity(entity);
     }
 
@@ -70,7 +83,7 @@ void Scene::destroyEntity(Entity* entity) {
 }
 
 void Scene::checkEntitySubscriptions(Entity* entity) {
-    for (auto const& [type, system] : m_Systems) {
+    for (System* system : m_SystemOrder) {
         bool matchesSignature = true;
         
         for (auto const& requiredTypeInfo : system->getComponentSignature()) {
@@ -89,31 +102,53 @@ void Scene::checkEntitySubscriptions(Entity* entity) {
 }
 
 void Scene::checkAllEntitySubscriptions(System* system) {
-    for (auto const& [handle, entityPtr] : m_EntityWrappers) {
+    for (Entity* entity : getEntityRawPointers()) {
         bool matchesSignature = true;
         for (auto const& requiredTypeInfo : system->getComponentSignature()) {
-            if (entityPtr->components.find(std::type_index(*requiredTypeInfo)) == entityPtr->components.end()) {
+            if (entity->components.find(std::type_index(*requiredTypeInfo)) == entity->components.end()) {
                 matchesSignature = false;
                 break;
             }
         }
         if (matchesSignature) {
-            system->addEntity(entityPtr.get());
+            system->addEntity(entity);
         }
     }
 }
 
+std::vector<Entity*> Scene::getEntityRawPointers() const {
+    std::vector<Entity*> ptrs;
+    ptrs.reserve(m_EntityWrappers.size());
+    for (auto const& [handle, entityPtr] : m_EntityWrappers) {
+        ptrs.push_back(entityPtr.get());
+    }
+    std::sort(ptrs.begin(), ptrs.end(), [](const Entity* a, const Entity* b) {
+        return a->getCreationIndex() < b->getCreationIndex();
+    });
+    return ptrs;
+}
+
+void Scene::registerSystemStages(System* system) {
+    if (system->getUpdateStages() & SystemStage::VariableStep) {
+        m_VariableSystems.push_back(system);
+    }
+    if (system->getUpdateStages() & SystemStage::FixedStep) {
+        m_FixedSystems.push_back(system);
+    }
+}
+
 void Scene::setRenderer(SDL_Renderer* renderer) {
     m_Renderer = renderer;
 }
 
 void Scene::init() {
     Log::info(name + " init starting");
-    for (auto const& [type, system] : m_Systems) {
+    for (System* system : m_SystemOrder) {
         system->onInit();
     }
     
-    for (auto const& [handle, entity] : m_EntityWrappers) {
+    // OnStart skriptov v poradi vytvorenia, aby bol start sceny pri kazdom behu rovnaky
+    for (Entity* entity : getEntityRawPointers()) {
         entity->init();
     }
     Log::info(name + " init finished");
@@ -121,10 +156,10 @@ void Scene::init() {
 
 void Scene::update(float dt) {
     if (auto* camSystem = getSystem<CameraSystem>()) {
-        camSystem->updateCamera(&m_SceneCamera);
+        camSystem->updateCamera(&m_SceneCamera, m_InterpolationAlpha);
     }
 
-    for (auto const& [type, system] : m_Systems) {
+    for (System* system : m_VariableSystems) {
         system->onUpdate(dt);
     }
     
@@ -133,17 +168,137 @@ void Scene::update(float dt) {
     }
 }
 
+void Scene::fixedUpdate(float fixedDt) {
+    // snapshot pred krokom, aby renderer mal z coho interpolovat
+    for (auto const& [handle, entity] : m_EntityWrappers) {
+        if (auto* tr = entity->getComponent<TransformComponent>()) {
+            tr->previousPosition = tr->position;
+            tr->previousRotation = tr->rotation;
+        }
+    }
+
+    for (System* system : m_FixedSystems) {
+        system->onFixedUpdate(fixedDt);
+    }
+    ++m_StepIndex;
+
+    for (auto const& [handle, entity] : m_EntityWrappers) {
+        if (auto* tr = entity->getComponent<TransformComponent>()) {
+            tr->simulatedPosition = tr->position;
+            tr->simulatedRotation = tr->rotation;
+        }
+    }
+}
+
+void Scene::applyProjectSettings(const ProjectConfig& config) {
+    if (auto* collisionSys = getSystem<CollisionSystem>()) {
+        collisionSys->setSolverIterations(config.velocityIterations, config.positionIterations);
+        collisionSys->setLayerMatrix(config.layerMatrix);
+        collisionSys->setTriggerInterval(config.triggerUpdateInterval);
+    }
+    if (auto* navSys = getSystem<NavigationSystem>()) {
+        navSys->configure(config.navCellSize, config.navAgentRadius);
+    }
+    if (auto* textSys = getSystem<TextSystem>()) {
+        textSys->setTextureBudget((size_t)std::max(config.textCacheBudgetMB, 0) * 1024 * 1024);
+    }
+    setDeterministic(config.deterministicPhysics);
+    m_ScreenSpaceLayers = GetScreenSpaceLayerMask(config.renderLayers);
+    m_StaticLayers = GetStaticLayerMask(config.renderLayers);
+}
+
+void Scene::setDeterministic(bool enabled) {
+    m_Deterministic = enabled;
+    // Vstup pocas frame-u by inak pridaval silu tolkokrat, kolko frame-ov pripadne na krok
+    if (auto* inputSys = getSystem<InputSystem>()) {
+        inputSys->setFixedStepInput(enabled);
+    }
+    // Skripty bezia len vo fixnom kroku, inak by OnUpdate dostaval dt frame-u
+    if (auto* scriptSys = getSystem<ScriptSystem>()) {
+        scriptSys->setDeterministic(enabled);
+        m_VariableSystems.clear();
+        m_FixedSystems.clear();
+        for (System* system : m_SystemOrder) {
+            registerSystemStages(system);
+        }
+    }
+}
+
+static constexpr uint64_t fnvOffset = 14695981039346656037ull;
+static constexpr uint64_t fnvPrime = 1099511628211ull;
+
+static void HashBytes(uint64_t& hash, const void* data, size_t size) {
+    const auto* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= fnvPrime;
+    }
+}
+
+// Presne bity floatu, -0 a NaN payloady sa tiez rozlisia
+static void HashFloat(uint64_t& hash, float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    HashBytes(hash, &bits, sizeof(bits));
+}
+
+static void HashVec2(uint64_t& hash, const glm::vec2& v) {
+    HashFloat(hash, v.x);
+    HashFloat(hash, v.y);
+}
+
+uint64_t Scene::computeStateChecksum() const {
+    uint64_t hash = fnvOffset;
+    HashBytes(hash, &m_StepIndex, sizeof(m_StepIndex));
+
+    for (Entity* entity : getEntityRawPointers()) {
+        auto* tr = entity->getComponent<TransformComponent>();
+        if (!tr) continue;
+
+        uint64_t index = entity->getCreationIndex();
+        HashBytes(hash, &index, sizeof(index));
+        HashVec2(hash, tr->position);
+        HashFloat(hash, tr->rotation);
+        HashVec2(hash, tr->scale);
+
+        if (auto* rb = entity->getComponent<RigidBodyComponent>()) {
+            HashVec2(hash, rb->velocity);
+            unsigned char awake = rb->isAwake ? 1 : 0;
+            HashBytes(hash, &awake, sizeof(awake));
+        } else if (auto* vel = entity->getComponent<VelocityComponent>()) {
+            HashVec2(hash, vel->velocity);
+        }
+    }
+    return hash;
+}
+
 void Scene::render(SDL_Renderer* renderer, Camera& camera, float renderW, float renderH, Project* project, float dt) {
+    submitRender(renderer, camera, renderW, renderH, project, dt);
+    m_RenderQueue.flush(renderer);
+}
+
+void Scene::submitRender(SDL_Renderer* renderer, Camera& camera, float renderW, float renderH, Project* project, float dt) {
+    submitRender(m_RenderQueue, renderer, camera, renderW, renderH, project, dt);
+}
+
+void Scene::submitRender(RenderQueue& queue, SDL_Renderer* renderer, Camera& camera, float renderW, float renderH, Project* project, float dt) {
+    // Tilemapy, sprity aj texty idu do jednej fronty, poradie urci az vrstva a zIndex
+    queue.begin();
+    queue.setScreenSpaceLayers(m_ScreenSpaceLayers);
+    queue.setStaticLayers(m_StaticLayers);
+    if (auto* tilemapSys = getSystem<TilemapSystem>()) {
+        tilemapSys->update(queue, camera, renderW, renderH, m_InterpolationAlpha);
+    }
     if (auto* renderSys = getSystem<RendererSystem>()) {
-        renderSys->update(renderer, camera, renderW, renderH, dt);
+        renderSys->update(queue, renderer, camera, renderW, renderH, dt, m_InterpolationAlpha);
     }
     if (auto* textSys = getSystem<TextSystem>()) {
-        textSys->update(renderer, camera, renderW, renderH, project);
+        textSys->update(queue, renderer, camera, renderW, renderH, project, m_InterpolationAlpha);
     }
 }
 
 void Scene::shutdown() {
-    for (auto const& [type, system] : m_Systems) {
+    for (System* system : m_SystemOrder) {
         system->onShutdown();
     }
 
@@ -9,6 +9,8 @@
 #include "entt/entt.hpp"
 #include "core/Camera.h"
 #include "core/Project.h"
+#include "core/RenderQueue.h"
+#include "core/SceneBackground.h"
 
 namespace Engine {
 
@@ -16,20 +18,6 @@ class Entity;
 class System;
 
 
-enum class BackgroundType {
-    Solid, Gradient, Image
-};
-
-struct BackgroundSettings{
-    BackgroundType type = BackgroundType::Solid;
-    
-    glm::vec4 color1 = {30/255.0f, 30/255.0f, 30/255.0f, 1.0f};
-    glm::vec4 color2 = {10/255.0f, 10/255.0f, 10/255.0f, 1.0f};
-
-    std::string assetId = "";
-    bool stretch = true;
-};
-
 class Scene {
 
 private:
@@ -38,19 +26,48 @@ private:
     
     std::unique_ptr<entt::registry> m_Registry;
     std::unordered_map<std::type_index, std::unique_ptr<System>> m_Systems;
+    // Poradie updatu podla poradia pridania systemov
+    std::vector<System*> m_SystemOrder;
+    std::vector<System*> m_VariableSystems;
+    std::vector<System*> m_FixedSystems;
     
     Camera m_SceneCamera;
+    float m_InterpolationAlpha = 1.0f;
+
+    uint64_t m_NextCreationIndex = 1;
+    // Deterministicky rezim: vstup sa vzorkuje vo fixnom kroku, kroky sa cisluju pre checksumy
+    bool m_Deterministic = false;
+    uint64_t m_StepIndex = 0;
     
     static SDL_Renderer* m_Renderer;
 
     BackgroundSettings m_Background;
+    RenderQueue m_RenderQueue;
+    uint32_t m_ScreenSpaceLayers = 0;
+    uint32_t m_StaticLayers = 0;
+    void registerSystemStages(System* system);
 public:
     Scene(const std::string& name = "Untitled scene");
     ~Scene();
 
     void init();
     void update(float dt);
+    void fixedUpdate(float fixedDt);
+    // Prenesie nastavenia simulacie z projektu do systemov sceny
+    void applyProjectSettings(const ProjectConfig& config);
     void render(SDL_Renderer* renderer, Camera& camera, float renderW, float renderH, Project* project, float dt);
+    /**
+     * @brief Prva polovica render(): vsetky systemy poslu prikazy do render queue, nic sa este nekresli.
+     * Editor medzi tym prida svoje debug tvary a potom zavola getRenderQueue().flush().
+     */
+    void submitRender(SDL_Renderer* renderer, Camera& camera, float renderW, float renderH, Project* project, float dt);
+    /** @brief To iste do cudzej fronty, napr. do frame-u, ktory sa vykresli az po dalsej simulacii. */
+    void submitRender(RenderQueue& queue, SDL_Renderer* renderer, Camera& camera, float renderW, float renderH, Project* project, float dt);
+    RenderQueue& getRenderQueue() { return m_RenderQueue; }
+    /** @brief Bit i = render vrstva i sa kresli v pixeloch ciela; prenasa sa do kazdej fronty pri submitRender. */
+    void setScreenSpaceLayers(uint32_t mask) { m_ScreenSpaceLayers = mask; }
+    /** @brief Bit i = sprity vrstvy i sa kreslia z cache chunkov (RendererSystem). */
+    void setStaticLayers(uint32_t mask) { m_StaticLayers = mask; }
     void shutdown();
 
     Entity* createEntity(const std::string& name = "New entity");
@@ -59,6 +76,22 @@ public:
     void checkEntitySubscriptions(Entity* entity);
     void checkAllEntitySubscriptions(System* system);
 
+    /**
+     * @brief Opt-in deterministicky rezim pre replaye a lockstep.
+     * Vsetko co ovplyvnuje simulaciu (vstup, fyzika, kolizie) bezi len vo fixnom kroku v stabilnom poradi.
+     */
+    void setDeterministic(bool enabled);
+    bool isDeterministic() const { return m_Deterministic; }
+
+    // Pocet odsimulovanych fixnych krokov od nacitania sceny
+    uint64_t getStepIndex() const { return m_StepIndex; }
+
+    /**
+     * @brief 64-bit FNV-1a hash stavu simulacie (transformy, rychlosti, spanok) v poradi vytvorenia entit.
+     * Dva behy s rovnakym vstupom maju po kazdom kroku rovnaky checksum, prva nezhoda ukaze kde sa rozisli.
+     */
+    uint64_t computeStateChecksum() const;
+
     // Getters
     const std::string& getName() const { return name; }
     void setName(std::string newName) {name = newName;}
@@ -66,6 +99,10 @@ public:
     static SDL_Renderer* getRenderer() { return m_Renderer; }
     
     Camera* getSceneCamera() { return &m_SceneCamera; }
+
+    // Kolko z dalsieho fixneho kroku uz ubehlo (0..1), renderer podla toho interpoluje transformy
+    void setInterpolationAlpha(float alpha) { m_InterpolationAlpha = alpha; }
+    float getInterpolationAlpha() const { return m_InterpolationAlpha; }
     
     entt::registry& getRegistry() { return *m_Registry; }
 
@@ -73,14 +110,8 @@ public:
     void setBackground(const BackgroundSettings& settings) { m_Background = settings; }
 
 
-    std::vector<Entity*> getEntityRawPointers() {
-        std::vector<Entity*> ptrs;
-        ptrs.reserve(m_EntityWrappers.size());
-        for (auto const& [handle, entityPtr] : m_EntityWrappers) {
-            ptrs.push_back(entityPtr.get());
-        }
-        return ptrs;
-    }
+    // Zoradene podla poradia vytvorenia, nezavisle od poradia v hash mape
+    std::vector<Entity*> getEntityRawPointers() const;
 
     template <typename TSystem, typename... TArgs>
     TSystem* addSystem(TArgs&&... args) {
@@ -92,6 +123,8 @@ public:
         
         TSystem* rawPtr = newSystem.get();
         m_Systems[std::type_index(typeid(TSystem))] = std::move(newSystem);
+        m_SystemOrder.push_back(rawPtr);
+        registerSystemStages(rawPtr);
         
         checkAllEntitySubscriptions(rawPtr);
         
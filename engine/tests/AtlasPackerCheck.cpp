@@ -0,0 +1,85 @@
+#include "Check.h"
+#include "core/TextureAtlas.h"
+#include <vector>
+
+using namespace Engine;
+
+static bool Overlaps(const AtlasRect& a, const AtlasRect& b, int padding) {
+    return a.x < b.x + b.w + padding && b.x < a.x + a.w + padding && a.y < b.y + b.h + padding &&
+           b.y < a.y + a.h + padding;
+}
+
+static bool Inside(const AtlasRect& r, int width, int height) {
+    return r.x >= 0 && r.y >= 0 && r.x + r.w <= width && r.y + r.h <= height;
+}
+
+int main() {
+    const int size = 256;
+    const int padding = 2;
+
+    // Vlozene recty su na stranke a neprekryvaju sa ani s okrajom
+    {
+        AtlasPacker packer(size, size, padding);
+        std::vector<AtlasRect> rects;
+        AtlasRect rect;
+        for (int i = 0; packer.insert(10 + i % 23, 8 + i % 17, rect); ++i)
+            rects.push_back(rect);
+        CHECK(rects.size() > 50);
+        CHECK(packer.getRectCount() == (int)rects.size());
+        for (size_t i = 0; i < rects.size(); ++i) {
+            CHECK(Inside(rects[i], size, size));
+            for (size_t j = i + 1; j < rects.size(); ++j)
+                CHECK(!Overlaps(rects[i], rects[j], padding));
+        }
+        CHECK(packer.getOccupancy() > 0.5f && packer.getOccupancy() <= 1.0f);
+    }
+
+    // Cela stranka sa zmesti presne, okraj za poslednym stlpcom netreba
+    {
+        AtlasPacker packer(size, size, padding);
+        AtlasRect rect;
+        CHECK(packer.insert(size, size, rect));
+        CHECK(rect.x == 0 && rect.y == 0 && rect.w == size && rect.h == size);
+        CHECK(!packer.insert(1, 1, rect));
+        CHECK(!AtlasPacker(size, size, padding).insert(size + 1, 1, rect));
+        CHECK(!AtlasPacker(size, size, padding).insert(0, 4, rect));
+    }
+
+    // Uvolnene miesto sa pouzije znova, bez prekryvu so zivymi rectami
+    {
+        AtlasPacker packer(size, size, padding);
+        std::vector<AtlasRect> rects;
+        AtlasRect rect;
+        while (packer.insert(30, 30, rect))
+            rects.push_back(rect);
+        size_t full = rects.size();
+        CHECK(!packer.insert(30, 30, rect));
+
+        AtlasRect freed = rects[full / 2];
+        packer.release(freed);
+        rects.erase(rects.begin() + full / 2);
+        CHECK(packer.getRectCount() == (int)full - 1);
+
+        CHECK(packer.insert(20, 20, rect));
+        CHECK(rect.x == freed.x && rect.y == freed.y);
+        for (const auto& other : rects)
+            CHECK(!Overlaps(rect, other, padding));
+        CHECK(!packer.insert(30, 30, rect));
+    }
+
+    // Po uvolneni vsetkeho je stranka znova prazdna
+    {
+        AtlasPacker packer(size, size, padding);
+        std::vector<AtlasRect> rects;
+        AtlasRect rect;
+        while (packer.insert(40, 24, rect))
+            rects.push_back(rect);
+        for (const auto& r : rects)
+            packer.release(r);
+        CHECK(packer.getRectCount() == 0);
+        CHECK(packer.getOccupancy() == 0.0f);
+        CHECK(packer.insert(size, size, rect));
+    }
+
+    return Check::Finish("AtlasPackerCheck");
+}
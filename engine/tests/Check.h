@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cmath>
+#include <cstdio>
+
+// Kontroly bez frameworku: chyba sa vypise a pocita, main vrati nenulovy kod pre ctest
+namespace Check {
+    inline int failures = 0;
+
+    inline void Fail(const char* expression, const char* file, int line) {
+        std::printf("%s:%d: CHECK failed: %s\n", file, line, expression);
+        ++failures;
+    }
+
+    inline int Finish(const char* name) {
+        if (failures == 0)
+            std::printf("%s: all checks passed\n", name);
+        else
+            std::printf("%s: %d checks failed\n", name, failures);
+        return failures == 0 ? 0 : 1;
+    }
+}
+
+#define CHECK(expression) \
+    do { \
+        if (!(expression)) Check::Fail(#expression, __FILE__, __LINE__); \
+    } while (0)
+
+#define CHECK_NEAR(a, b, tolerance) CHECK(std::abs((double)(a) - (double)(b)) <= (double)(tolerance))
@@ -0,0 +1,116 @@
+#include "Check.h"
+#include "core/Project.h"
+#include "ecs/Entity.h"
+#include "ecs/components/CircleColliderComponent.h"
+#include "ecs/components/RigidBodyComponent.h"
+#include "ecs/components/ScriptComponent.h"
+#include "ecs/components/TransformComponent.h"
+#include "ecs/systems/ScriptSystem.h"
+#include "scene/Scene.h"
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Dve rovnake sceny bez renderera, kazda s inym rytmom frame-ov medzi fixnymi krokmi.
+// V deterministickom rezime musia mat po kazdom kroku rovnaky checksum, skripty nesmu vidiet dt frame-u.
+
+using namespace Engine;
+
+static constexpr float FixedDt = 1.0f / 60.0f;
+static constexpr int StepCount = 240;
+static constexpr int LateSpawnStep = 30;
+
+// OnUpdate zavisi od dt nelinearne, ine rozdelenie frame-u by dalo inu rychlost
+static const char* MoverScript = R"(
+local Mover = {}
+function Mover:OnCreate()
+  self.push = math.random() * 40.0
+end
+function Mover:OnUpdate(dt)
+  local rb = self.entity:getRigidbody()
+  local v = rb.velocity
+  v.x = v.x * (1.0 - 2.0 * dt) + self.push * dt
+  rb.velocity = v
+end
+return Mover
+)";
+
+static void SpawnBall(Scene& scene, const std::string& script, glm::vec2 position) {
+    Entity* ball = scene.createEntity("Ball");
+    ball->addComponent<TransformComponent>(position);
+    ball->addComponent<RigidBodyComponent>();
+    ball->addComponent<CircleColliderComponent>(8.0f);
+    ball->addComponent<ScriptComponent>(script);
+}
+
+static void BuildScene(Scene& scene, Project& project, const std::string& script) {
+    Entity* ground = scene.createEntity("Ground");
+    ground->addComponent<TransformComponent>(glm::vec2(0.0f, 200.0f));
+    ground->addComponent<CircleColliderComponent>(120.0f, glm::vec2(0.0f, 0.0f), false, true);
+
+    for (int i = 0; i < 8; ++i)
+        SpawnBall(scene, script, {-70.0f + 20.0f * i, -40.0f * (i % 3)});
+
+    scene.addSystem<ScriptSystem>(&project);
+    scene.setDeterministic(true);
+    scene.init();
+}
+
+// Pred kazdym krokom framePattern urci pocet variabilnych frame-ov a ich dt
+template <typename FramePattern>
+static std::vector<uint64_t> Run(Project& project, const std::string& script, FramePattern framePattern) {
+    Scene scene("DeterminismCheck");
+    BuildScene(scene, project, script);
+
+    std::vector<uint64_t> checksums;
+    checksums.reserve(StepCount);
+    for (int step = 0; step < StepCount; ++step) {
+        int frames = 0;
+        float frameDt = 0.0f;
+        framePattern(step, frames, frameDt);
+        for (int f = 0; f < frames; ++f)
+            scene.update(frameDt);
+
+        // Neskoro pridany skript sa inicializuje az na zaciatku kroku
+        if (step == LateSpawnStep)
+            SpawnBall(scene, script, {0.0f, -120.0f});
+
+        scene.fixedUpdate(FixedDt);
+        checksums.push_back(scene.computeStateChecksum());
+    }
+    scene.shutdown();
+    return checksums;
+}
+
+int main() {
+    std::filesystem::path directory = std::filesystem::temp_directory_path() / "engine_determinism_check";
+    std::filesystem::create_directories(directory);
+    std::filesystem::path scriptPath = directory / "Mover.lua";
+    {
+        std::ofstream file(scriptPath);
+        file << MoverScript;
+    }
+
+    // Bez adresara assetov sa watcher nezapne
+    Project project;
+    project.setPath(directory.string());
+    project.getConfig().assetDirectory = "missing_assets";
+    project.getConfig().deterministicPhysics = true;
+
+    std::vector<uint64_t> steady = Run(project, scriptPath.string(), [](int, int& frames, float& frameDt) {
+        frames = 1;
+        frameDt = FixedDt;
+    });
+    std::vector<uint64_t> uneven = Run(project, scriptPath.string(), [](int step, int& frames, float& frameDt) {
+        frames = step % 4;
+        frameDt = 0.0037f + 0.0011f * (step % 5);
+    });
+
+    CHECK(steady.size() == (size_t)StepCount);
+    CHECK(steady == uneven);
+
+    std::filesystem::remove_all(directory);
+    return Check::Finish("DeterminismCheck");
+}
@@ -0,0 +1,63 @@
+#include "Check.h"
+#include "core/GlyphAtlas.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace Engine;
+
+static std::vector<uint32_t> Decode(const std::string& text) {
+    std::vector<uint32_t> codepoints;
+    size_t i = 0;
+    while (i < text.size()) {
+        size_t before = i;
+        codepoints.push_back(GlyphAtlas::DecodeUtf8(text, i));
+        // Kazde volanie posunie aspon o bajt, inak by layout zamrzol
+        if (i <= before || i > text.size()) {
+            CHECK(i > before && i <= text.size());
+            break;
+        }
+    }
+    return codepoints;
+}
+
+static bool Same(const std::vector<uint32_t>& a, const std::vector<uint32_t>& b) {
+    return a == b;
+}
+
+int main() {
+    const uint32_t bad = 0xFFFD;
+
+    // Platne sekvencie 1 az 4 bajty, aj hranice rozsahov
+    CHECK(Same(Decode("Skore: 42"), {'S', 'k', 'o', 'r', 'e', ':', ' ', '4', '2'}));
+    CHECK(Same(Decode("\xC5\xA1\xC4\x8D"), {0x161, 0x10D}));  // sc s makcenom
+    CHECK(Same(Decode("\xE2\x82\xAC"), {0x20AC}));
+    CHECK(Same(Decode("\xF0\x9F\x98\x80"), {0x1F600}));
+    CHECK(Same(Decode("\xC2\x80\xDF\xBF"), {0x80, 0x7FF}));
+    CHECK(Same(Decode("\xE0\xA0\x80\xEF\xBF\xBF"), {0x800, 0xFFFF}));
+    CHECK(Same(Decode("\xF0\x90\x80\x80\xF4\x8F\xBF\xBF"), {0x10000, 0x10FFFF}));
+    CHECK(Same(Decode(std::string("a\0b", 3)), {'a', 0, 'b'}));
+
+    // Samostatne pokracovacie bajty a neplatne uvodne bajty
+    CHECK(Same(Decode("\x80"), {bad}));
+    CHECK(Same(Decode("a\xBF" "b"), {'a', bad, 'b'}));
+    CHECK(Same(Decode("\xFF\xFE"), {bad, bad}));
+    CHECK(Same(Decode("\xF8\x88\x80\x80\x80"), {bad, bad, bad, bad, bad}));
+
+    // Useknuta sekvencia: na konci textu aj pred dalsim znakom
+    CHECK(Same(Decode("\xE2\x82"), {bad, bad}));
+    CHECK(Same(Decode("\xE2\x82" "a"), {bad, bad, 'a'}));
+    CHECK(Same(Decode("\xF0\x9F\x98"), {bad, bad, bad}));
+
+    // Pridlhy zapis, surrogaty a nad U+10FFFF
+    CHECK(Same(Decode("\xC0\xAF"), {bad, bad}));
+    CHECK(Same(Decode("\xE0\x80\xAF"), {bad, bad, bad}));
+    CHECK(Same(Decode("\xF0\x80\x80\xAF"), {bad, bad, bad, bad}));
+    CHECK(Same(Decode("\xED\xA0\x80"), {bad, bad, bad}));
+    CHECK(Same(Decode("\xF4\x90\x80\x80"), {bad, bad, bad, bad}));
+
+    // Po chybe sa dekoduje dalej spravne
+    CHECK(Same(Decode("\xC3" "\xE2\x82\xAC" "x"), {bad, 0x20AC, 'x'}));
+
+    return Check::Finish("GlyphAtlasUtf8Check");
+}
@@ -0,0 +1,88 @@
+#include "Check.h"
+#include "core/RenderQueue.h"
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using namespace Engine;
+
+static bool SortedStable(const std::vector<RenderItem>& items) {
+    for (size_t i = 1; i < items.size(); ++i) {
+        if (items[i - 1].key > items[i].key)
+            return false;
+        // Pri rovnakom kluci ostava poradie vlozenia (index = poradie v povodnom zozname)
+        if (items[i - 1].key == items[i].key && items[i - 1].index > items[i].index)
+            return false;
+    }
+    return true;
+}
+
+static void CheckRadixSort(size_t count, uint64_t keyMask, std::mt19937_64& random) {
+    std::vector<RenderItem> items(count);
+    for (size_t i = 0; i < count; ++i)
+        items[i] = {random() & keyMask, (uint32_t)i};
+
+    std::vector<RenderItem> expected = items;
+    std::stable_sort(expected.begin(), expected.end(),
+                     [](const RenderItem& a, const RenderItem& b) { return a.key < b.key; });
+
+    std::vector<RenderItem> scratch;
+    RadixSortRenderItems(items, scratch);
+    CHECK(SortedStable(items));
+    bool same = items.size() == expected.size();
+    for (size_t i = 0; same && i < items.size(); ++i)
+        same = items[i].key == expected[i].key && items[i].index == expected[i].index;
+    CHECK(same);
+}
+
+int main() {
+    using namespace RenderSortKey;
+
+    // Polia idu od najvyssieho bitu: vrstva, zIndex, textura, material, entita
+    CHECK(Pack(1, 0, 0, 0, 0) > Pack(0, 32767, MaxTextureId, 15, MaxEntity));
+    CHECK(Pack(0, 1, 0, 0, 0) > Pack(0, 0, MaxTextureId, 15, MaxEntity));
+    CHECK(Pack(0, 0, 1, 0, 0) > Pack(0, 0, 0, 15, MaxEntity));
+    CHECK(Pack(0, 0, 0, 1, 0) > Pack(0, 0, 0, 0, MaxEntity));
+    CHECK(Pack(0, 0, 0, 0, 1) > Pack(0, 0, 0, 0, 0));
+
+    // Zaporny zIndex je pred kladnym, mimo int16 sa orezava
+    CHECK(Pack(0, -1, 0, 0, 0) < Pack(0, 0, 0, 0, 0));
+    CHECK(Pack(0, -32768, 0, 0, 0) < Pack(0, -32767, 0, 0, 0));
+    CHECK(Pack(0, 100000, 0, 0, 0) == Pack(0, 32767, 0, 0, 0));
+    CHECK(Pack(0, -100000, 0, 0, 0) == Pack(0, -32768, 0, 0, 0));
+
+    // Vrstva sa cita spat, editorova vrstva je nad vsetkymi
+    for (uint32_t layer = 0; layer <= DebugLayer; ++layer)
+        CHECK(GetLayer(Pack(layer, -5, 7, 3, 11)) == layer);
+    CHECK(Pack(DebugLayer, INT16_MIN, 0, 0, 0) > Pack(DebugLayer - 1, INT16_MAX, MaxTextureId, 15, MaxEntity));
+
+    // Text nad spritmi, tilemapy pod nimi pri rovnakom zIndex
+    CHECK(Pack(0, 3, TextTextureId, 0, 0) > Pack(0, 3, MaxTextureId - 1, 0, MaxEntity));
+    CHECK(Pack(0, 3, TilemapTextureId, 0, MaxEntity) < Pack(0, 3, 1, 0, 0));
+
+    // Prilis velke polia nepretecu do susednych
+    CHECK(Pack(0, 0, MaxTextureId + 1, 0, 0) == Pack(0, 0, 0, 0, 0));
+    CHECK(Pack(0, 0, 0, 0, MaxEntity + 1) == Pack(0, 0, 0, 0, 0));
+
+    // Radix sort: insertion sort pre male zoznamy, inak bajtove prechody, oboje stabilne
+    std::mt19937_64 random(12345);
+    for (size_t count : {0, 1, 2, 31, 32, 33, 1000, 20000}) {
+        CheckRadixSort(count, ~0ull, random);
+        CheckRadixSort(count, 0xFFull, random);                 // vela zhod
+        CheckRadixSort(count, 0xF0000000000000FFull, random);   // preskakovane prechody
+    }
+
+    // Uz zoradeny vstup ostane nezmeneny
+    std::vector<RenderItem> sorted, scratch;
+    for (uint32_t i = 0; i < 500; ++i)
+        sorted.push_back({Pack(i / 100, (int)(i % 100), 1, 0, i), i});
+    std::vector<RenderItem> copy = sorted;
+    RadixSortRenderItems(sorted, scratch);
+    bool unchanged = true;
+    for (size_t i = 0; i < sorted.size(); ++i)
+        unchanged = unchanged && sorted[i].index == copy[i].index;
+    CHECK(unchanged);
+
+    return Check::Finish("RenderQueueCheck");
+}
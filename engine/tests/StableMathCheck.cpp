@@ -0,0 +1,39 @@
+#include "Check.h"
+#include "core/StableMath.h"
+#include <cmath>
+
+using namespace Engine;
+
+int main() {
+    // Nasobky 90 stupnov su presne, aj cez otocenie a zaporne uhly
+    const float exact[][3] = {
+        {0.0f, 0.0f, 1.0f},     {90.0f, 1.0f, 0.0f},    {180.0f, 0.0f, -1.0f},
+        {-90.0f, -1.0f, 0.0f},  {270.0f, -1.0f, 0.0f},  {360.0f, 0.0f, 1.0f},
+        {-180.0f, 0.0f, -1.0f}, {450.0f, 1.0f, 0.0f},   {-720.0f, 0.0f, 1.0f},
+    };
+    for (const auto& [degrees, expectedSin, expectedCos] : exact) {
+        float s, c;
+        StableMath::SinCosDegrees(degrees, s, c);
+        CHECK(s == expectedSin);
+        CHECK(c == expectedCos);
+    }
+
+    // Inde do 1e-6 od libm v double
+    for (int i = -7200; i <= 7200; ++i) {
+        float degrees = i * 0.125f;
+        float s, c;
+        StableMath::SinCosDegrees(degrees, s, c);
+        double radians = degrees * 3.14159265358979323846 / 180.0;
+        CHECK_NEAR(s, std::sin(radians), 1e-6);
+        CHECK_NEAR(c, std::cos(radians), 1e-6);
+    }
+
+    // Vysledok zavisi len od uhla, nie od predchadzajuceho volania
+    float s1, c1, s2, c2;
+    StableMath::SinCosDegrees(33.3f, s1, c1);
+    StableMath::SinCosDegrees(-271.0f, s2, c2);
+    StableMath::SinCosDegrees(33.3f, s2, c2);
+    CHECK(s1 == s2 && c1 == c2);
+
+    return Check::Finish("StableMathCheck");
+}